@@ -38,10 +38,12 @@ target_link_libraries(protegon PUBLIC rc::shader)
 
 if(NOT EMSCRIPTEN)
   find_package(OpenGL REQUIRED)
+  find_package(Threads REQUIRED)
 
   target_link_libraries(
     protegon PRIVATE ${OPENGL_LIBRARIES} SDL2::SDL2 SDL2_image::SDL2_image
                      SDL2_ttf::SDL2_ttf SDL2_mixer::SDL2_mixer)
+  target_link_libraries(protegon PUBLIC Threads::Threads)
 else()
   if("${CMAKE_BUILD_TYPE}" STREQUAL "Debug")
     set(ECXXFLAGS "-O0")
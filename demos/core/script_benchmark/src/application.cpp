@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/app/game.h"
+#include "core/ecs/entity.h"
+#include "core/scripting/script.h"
+#include "core/scripting/script_interfaces.h"
+#include "debug/core/log.h"
+#include "world/scene/scene.h"
+#include "world/scene/scene_manager.h"
+
+// Measures OnUpdate dispatch throughput for many scripted entities. Each measured frame queues and
+// invokes OnUpdate on every script in the same way as the scene update does. Run with the
+// PTGN_HEADLESS environment variable set to skip the OpenGL driver.
+
+using namespace ptgn;
+
+constexpr std::size_t entity_count{ 100000 };
+
+constexpr std::size_t warmup_frames{ 10 };
+constexpr std::size_t measured_frames{ 100 };
+
+static std::uint64_t update_count{ 0 };
+
+class CounterScript : public Script<CounterScript> {
+public:
+	void OnUpdate() override {
+		++update_count;
+	}
+};
+
+struct ScriptBenchmarkScene : public Scene {
+	std::size_t frame{ 0 };
+
+	double total_ms{ 0.0 };
+	double min_ms{ 0.0 };
+	double max_ms{ 0.0 };
+
+	void Enter() override {
+		Reserve(entity_count);
+		for (std::size_t i{ 0 }; i < entity_count; ++i) {
+			Entity entity{ CreateEntity() };
+			AddScript<CounterScript>(entity);
+		}
+		Refresh();
+	}
+
+	void Update() override {
+		auto start{ std::chrono::steady_clock::now() };
+		impl::AddScriptActions(*this, &impl::IScript::OnUpdate);
+		impl::InvokeScriptActions(*this);
+		auto end{ std::chrono::steady_clock::now() };
+		double ms{ std::chrono::duration<double, std::milli>(end - start).count() };
+
+		if (frame >= warmup_frames) {
+			total_ms += ms;
+			min_ms	  = frame == warmup_frames ? ms : std::min(min_ms, ms);
+			max_ms	  = std::max(max_ms, ms);
+		}
+
+		if (++frame < warmup_frames + measured_frames) {
+			return;
+		}
+
+		auto frames{ static_cast<double>(measured_frames) };
+		auto avg_ms{ total_ms / frames };
+		PTGN_LOG(
+			"[OnUpdate] scripts: ", entity_count, ", dispatch ms avg: ", avg_ms, ", min: ", min_ms,
+			", max: ", max_ms,
+			", million updates per second: ", static_cast<double>(entity_count) / avg_ms / 1000.0
+		);
+		// The scene update dispatches OnUpdate once per frame in addition to the measured
+		// dispatch.
+		PTGN_LOG("[OnUpdate] total updates: ", update_count);
+
+		game.Stop();
+	}
+};
+
+int main([[maybe_unused]] int c, [[maybe_unused]] char** v) {
+	game.Init("ScriptBenchmarkScene");
+	game.scene.Enter<ScriptBenchmarkScene>("");
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "core/app/game.h"
+#include "core/ecs/components/draw.h"
+#include "core/ecs/components/sprite.h"
+#include "core/ecs/entity.h"
+#include "debug/core/log.h"
+#include "math/rng.h"
+#include "math/vector2.h"
+#include "renderer/api/blend_mode.h"
+#include "renderer/api/color.h"
+#include "renderer/gl/gl_context.h"
+#include "renderer/text/text.h"
+#include "world/scene/scene.h"
+#include "world/scene/scene_manager.h"
+
+// Deterministic CPU benchmark of the renderer. Run with the PTGN_HEADLESS environment variable
+// set to replace OpenGL with the null backend, which also reports the GL calls issued per frame.
+// Without it the benchmark runs against the real driver and only reports frame times.
+
+using namespace ptgn;
+
+constexpr V2_int resolution{ 800, 800 };
+
+constexpr std::uint32_t seed{ 12345 };
+
+// Frames which are run before measuring so that caches and batches are warmed up.
+constexpr std::size_t warmup_frames{ 10 };
+constexpr std::size_t measured_frames{ 100 };
+
+enum class Benchmark {
+	Sprites,
+	Shapes,
+	Texts,
+	BlendModes,
+	Count
+};
+
+struct BenchmarkInfo {
+	std::string_view name;
+	std::size_t count{ 0 };
+};
+
+constexpr std::array<BenchmarkInfo, static_cast<std::size_t>(Benchmark::Count)> benchmarks{
+	BenchmarkInfo{ "sprites", 10000 },
+	BenchmarkInfo{ "shapes", 10000 },
+	BenchmarkInfo{ "texts", 1000 },
+	BenchmarkInfo{ "blend modes", 10000 },
+};
+
+constexpr std::array<BlendMode, 4> blend_modes{ BlendMode::Blend, BlendMode::AddRGB,
+												BlendMode::MultiplyRGB,
+												BlendMode::PremultipliedBlend };
+
+struct RenderBenchmarkScene : public Scene {
+	std::size_t benchmark{ 0 };
+	std::size_t frame{ 0 };
+
+	std::vector<Entity> entities;
+
+	RNG<float> rngx{ seed, -resolution.x * 0.5f, resolution.x * 0.5f };
+	RNG<float> rngy{ seed + 1, -resolution.y * 0.5f, resolution.y * 0.5f };
+	RNG<float> rngsize{ seed + 2, 5.0f, 30.0f };
+
+	std::chrono::steady_clock::time_point frame_start;
+
+	double total_ms{ 0.0 };
+	double min_ms{ 0.0 };
+	double max_ms{ 0.0 };
+
+	impl::NullGLStats totals;
+
+	void Enter() override {
+		LoadResource("test", "resources/test.png");
+		Populate();
+	}
+
+	[[nodiscard]] V2_float RandomPosition() {
+		return { rngx(), rngy() };
+	}
+
+	void Populate() {
+		const auto& info{ benchmarks[benchmark] };
+		entities.reserve(info.count);
+		for (std::size_t i{ 0 }; i < info.count; ++i) {
+			Entity entity;
+			switch (static_cast<Benchmark>(benchmark)) {
+				case Benchmark::Sprites:
+					entity = CreateSprite(*this, "test", RandomPosition());
+					break;
+				case Benchmark::Shapes:
+					if (i % 2 == 0) {
+						entity = CreateRect(
+							*this, RandomPosition(), { rngsize(), rngsize() }, color::Green
+						);
+					} else {
+						entity = CreateCircle(*this, RandomPosition(), rngsize(), color::Blue);
+					}
+					break;
+				case Benchmark::Texts:
+					entity = CreateText(*this, "Benchmark", color::Black);
+					SetPosition(entity, RandomPosition());
+					break;
+				case Benchmark::BlendModes:
+					entity = CreateRect(
+						*this, RandomPosition(), { rngsize(), rngsize() }, color::Red
+					);
+					SetBlendMode(entity, blend_modes[i % blend_modes.size()]);
+					break;
+				default: PTGN_ERROR("Unrecognized benchmark");
+			}
+			entities.emplace_back(entity);
+		}
+		Refresh();
+
+		frame		= 0;
+		total_ms	= 0.0;
+		min_ms		= 0.0;
+		max_ms		= 0.0;
+		totals		= {};
+		frame_start = std::chrono::steady_clock::now();
+	}
+
+	void Depopulate() {
+		for (auto& entity : entities) {
+			entity.Destroy();
+		}
+		entities.clear();
+		Refresh();
+	}
+
+	void Report() const {
+		const auto& info{ benchmarks[benchmark] };
+		auto frames{ static_cast<double>(measured_frames) };
+		PTGN_LOG(
+			"[", info.name, "] count: ", info.count, ", frame ms avg: ", total_ms / frames,
+			", min: ", min_ms, ", max: ", max_ms
+		);
+		if (!impl::GLContext::IsNull()) {
+			return;
+		}
+		auto per_frame = [&](std::uint64_t value) {
+			return static_cast<double>(value) / frames;
+		};
+		PTGN_LOG(
+			"[", info.name, "] per frame: draw calls: ", per_frame(totals.draw_calls),
+			", instances: ", per_frame(totals.instances),
+			", shader binds: ", per_frame(totals.shader_binds),
+			", texture binds: ", per_frame(totals.texture_binds),
+			", buffer binds: ", per_frame(totals.buffer_binds),
+			", vertex array binds: ", per_frame(totals.vertex_array_binds),
+			", frame buffer binds: ", per_frame(totals.frame_buffer_binds),
+			", buffer uploads: ", per_frame(totals.buffer_uploads), " (",
+			per_frame(totals.buffer_upload_bytes), " bytes)",
+			", texture uploads: ", per_frame(totals.texture_uploads),
+			", uniform updates: ", per_frame(totals.uniform_updates),
+			", state changes: ", per_frame(totals.state_changes)
+		);
+	}
+
+	// Accumulates the null backend stats of the previous frame.
+	void Accumulate() {
+		const auto& stats{ impl::GLContext::GetNullStats() };
+		totals.draw_calls		   += stats.draw_calls;
+		totals.instances		   += stats.instances;
+		totals.shader_binds		   += stats.shader_binds;
+		totals.texture_binds	   += stats.texture_binds;
+		totals.buffer_binds		   += stats.buffer_binds;
+		totals.vertex_array_binds  += stats.vertex_array_binds;
+		totals.frame_buffer_binds  += stats.frame_buffer_binds;
+		totals.buffer_uploads	   += stats.buffer_uploads;
+		totals.buffer_upload_bytes += stats.buffer_upload_bytes;
+		totals.texture_uploads	   += stats.texture_uploads;
+		totals.uniform_updates	   += stats.uniform_updates;
+		totals.state_changes	   += stats.state_changes;
+	}
+
+	void Update() override {
+		// Time between consecutive updates covers the update, draw and present of a full frame.
+		auto now{ std::chrono::steady_clock::now() };
+		double ms{ std::chrono::duration<double, std::milli>(now - frame_start).count() };
+		frame_start = now;
+
+		if (frame > warmup_frames) {
+			total_ms += ms;
+			min_ms	  = frame == warmup_frames + 1 ? ms : std::min(min_ms, ms);
+			max_ms	  = std::max(max_ms, ms);
+			Accumulate();
+		}
+		impl::GLContext::ResetNullStats();
+
+		if (frame < warmup_frames + measured_frames) {
+			++frame;
+			return;
+		}
+
+		Report();
+		Depopulate();
+
+		++benchmark;
+		if (benchmark == benchmarks.size()) {
+			game.Stop();
+			return;
+		}
+		Populate();
+	}
+};
+
+int main([[maybe_unused]] int c, [[maybe_unused]] char** v) {
+	game.Init("RenderBenchmarkScene", resolution);
+	game.scene.Enter<RenderBenchmarkScene>("");
+	return 0;
+}
\ No newline at end of file
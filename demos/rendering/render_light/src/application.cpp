@@ -2,6 +2,7 @@
 #include "core/app/game.h"
 #include "core/app/window.h"
 #include "core/input/input_handler.h"
+#include "core/input/key.h"
 #include "renderer/api/color.h"
 #include "renderer/api/origin.h"
 #include "renderer/renderer.h"
@@ -67,6 +68,15 @@ public:
 		// PTGN_LOG(input.GetMousePosition());
 		SetPosition(mouse_light, input.GetMousePosition());
 
+		// Compare batched lights against one full screen pass per light.
+		if (input.KeyDown(Key::B)) {
+			if (game.renderer.IsLightBatchingEnabled()) {
+				game.renderer.DisableLightBatching();
+			} else {
+				game.renderer.EnableLightBatching();
+			}
+		}
+
 		// DrawDebugRect({ 300, 400 }, { 100, 100 }, color::Blue, Origin::TopLeft, -1.0f);
 	}
 
@@ -0,0 +1,36 @@
+#option auto_layout
+
+#type fragment
+
+out vec4 o_Color;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+in vec4 v_Data;
+
+float sqr(float x) {
+    return x * x;
+}
+
+float attenuate_cusp(float distance, float radius,
+    float max_intensity, float falloff) {
+    float s = distance / radius;
+
+    if (s >= 1.0f)
+        return 0.0f;
+
+    float s2 = sqr(s);
+
+    return max_intensity * sqr(1.0f - s2) / (1.0f + falloff * s); // uses s instead of s2
+}
+
+// Each light is drawn as a quad which spans its radius in every direction, so the distance from
+// the light center in radii follows from the texture coordinates.
+// v_Data: x = intensity, y = falloff.
+void main() {
+	float distance = length(v_TexCoord * 2.0f - 1.0f);
+
+    float attenuation = attenuate_cusp(distance, 1.0f, v_Data.x, v_Data.y);
+
+    o_Color = vec4(v_Color.rgb * attenuation, attenuation * v_Color.a);
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#option auto_layout
+
+#type vertex
+
+in vec2 a_Corner;
+
+in vec3 a_Position;
+in vec4 a_Axes;
+in vec4 a_TexCoords;
+in vec4 a_Data;
+in vec4 a_Color;
+
+uniform mat4 u_ViewProjection;
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+out vec4 v_Data;
+
+void main() {
+	v_Color = a_Color;
+	v_TexCoord = mix(a_TexCoords.xy, a_TexCoords.zw, a_Corner);
+	v_Data = a_Data;
+
+	vec2 position = a_Position.xy + a_Corner.x * a_Axes.xy + a_Corner.y * a_Axes.zw;
+
+	gl_Position = u_ViewProjection * vec4(position, a_Position.z, 1.0f);
+}
\ No newline at end of file
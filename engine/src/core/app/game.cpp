@@ -1,6 +1,9 @@
 #include "core/app/game.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <cstdlib>
 #include <filesystem>
 #include <memory>
 #include <string>
@@ -13,6 +16,7 @@
 #include "core/app/window.h"
 #include "core/input/input_handler.h"
 #include "core/utils/file.h"
+#include "core/utils/frame_profiler.h"
 #include "core/utils/string.h"
 #include "core/utils/time.h"
 #include "debug/core/log.h"
@@ -28,6 +32,7 @@
 #include "renderer/materials/texture.h"
 #include "renderer/renderer.h"
 #include "renderer/text/font.h"
+#include "SDL_stdinc.h"
 #include "SDL_timer.h"
 #include "serialization/json/json.h"
 #include "serialization/json/json_manager.h"
@@ -150,17 +155,30 @@ Game::Game() :
 	shader_{ std::make_unique<ShaderManager>() },
 	shader{ *shader_ },
 	debug_{ std::make_unique<DebugSystem>() },
-	debug{ *debug_ } {
+	debug{ *debug_ },
+	profiler_{ std::make_unique<FrameProfiler>() },
+	profiler{ *profiler_ } {
 	// TODO: Move all of this init code into respective constructors.
 #if defined(PTGN_PLATFORM_MACOS) && !defined(__EMSCRIPTEN__)
 	impl::InitApplePath();
 #endif
+	// The game instance is constructed before main(), so headless mode is selected through the
+	// environment. It must be known before SDL is initialized.
+	if (std::getenv("PTGN_HEADLESS") != nullptr) {
+		headless_ = true;
+		SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+		SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+	}
 	if (!sdl_instance_->IsInitialized()) {
 		sdl_instance_->Init();
 	}
 	font.Init();
 	window.Init();
-	gl_context_->Init();
+	if (headless_) {
+		gl_context_->InitNull();
+	} else {
+		gl_context_->Init();
+	}
 	input.Init();
 
 	shader.Init();
@@ -176,6 +194,43 @@ float Game::dt() const {
 	return dt_;
 }
 
+void Game::SetFixedTickRate(float tick_rate) {
+	PTGN_ASSERT(tick_rate >= 0.0f, "Fixed tick rate cannot be negative");
+	fixed_dt_			 = tick_rate == 0.0f ? 0.0f : 1.0f / tick_rate;
+	accumulator_		 = 0.0f;
+	fixed_steps_		 = 1;
+	interpolation_alpha_ = 1.0f;
+}
+
+float Game::GetFixedTickRate() const {
+	return fixed_dt_ == 0.0f ? 0.0f : 1.0f / fixed_dt_;
+}
+
+float Game::GetFixedTimestep() const {
+	return fixed_dt_;
+}
+
+bool Game::IsFixedTimestep() const {
+	return fixed_dt_ > 0.0f;
+}
+
+void Game::SetMaxFrameTime(float max_frame_time) {
+	PTGN_ASSERT(max_frame_time > 0.0f, "Max frame time must be greater than zero");
+	max_frame_time_ = max_frame_time;
+}
+
+float Game::GetMaxFrameTime() const {
+	return max_frame_time_;
+}
+
+std::size_t Game::GetFixedSteps() const {
+	return fixed_steps_;
+}
+
+float Game::GetInterpolationAlpha() const {
+	return interpolation_alpha_;
+}
+
 float Game::time() const {
 	// TODO: Consider casting to chrono duration instead.
 	return static_cast<float>(SDL_GetTicks64());
@@ -193,6 +248,10 @@ bool Game::IsRunning() const {
 	return running_;
 }
 
+bool Game::IsHeadless() const {
+	return headless_;
+}
+
 void Game::Init(const std::string& title, const V2_int& game_size) {
 	window.SetTitle(title);
 	// Order matters here.
@@ -252,10 +311,12 @@ void Game::MainLoop() {
 }
 
 void Game::Update() {
+	profiler.BeginFrame();
+
 	debug.PreUpdate();
 
-	static auto start{ std::chrono::system_clock::now() };
-	static auto end{ std::chrono::system_clock::now() };
+	static auto start{ std::chrono::steady_clock::now() };
+	static auto end{ std::chrono::steady_clock::now() };
 	// Calculate time elapsed during previous frame. Unit: seconds.
 	secondsf elapsed_time{ end - start };
 
@@ -263,23 +324,29 @@ void Game::Update() {
 
 	dt_ = elapsed;
 
-	// TODO: Consider fixed FPS vs dynamic: https://gafferongames.com/post/fix_your_timestep/.
-	/*constexpr const float fps{ 60.0f };
-	dt_ = 1.0f / fps;*/
-
-	/*if (elapsed < dt_) {
-		impl::SDLInstance::Delay(to_duration<milliseconds>(secondsf{
-			dt_ - elapsed }));
-	}*/ // TODO: Add accumulator for when elapsed > dt (such as in Debug mode).
-	// PTGN_LOG("Dt: ", dt_);
-
 	start = end;
 
+	if (IsFixedTimestep()) {
+		// See: https://gafferongames.com/post/fix_your_timestep/.
+		accumulator_ += std::min(elapsed, max_frame_time_);
+		fixed_steps_  = 0;
+		while (accumulator_ >= fixed_dt_) {
+			accumulator_ -= fixed_dt_;
+			++fixed_steps_;
+		}
+		interpolation_alpha_ = accumulator_ / fixed_dt_;
+	} else {
+		fixed_steps_		 = 1;
+		interpolation_alpha_ = 1.0f;
+	}
+
 	scene.Update(*this);
 
 	debug.PostUpdate();
 
-	end = std::chrono::system_clock::now();
+	end = std::chrono::steady_clock::now();
+
+	profiler.EndFrame();
 }
 
 } // namespace impl
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -56,6 +57,7 @@ class FontManager;
 class TextureManager;
 class ShaderManager;
 class DebugSystem;
+class FrameProfiler;
 
 struct WindowDeleter;
 struct Mix_MusicDeleter;
@@ -82,13 +84,50 @@ private:
 	Game& operator=(Game&&)		 = delete;
 
 	bool running_{ false };
+	bool headless_{ false };
 	// Frame time in seconds.
 	float dt_{ 0.0f };
 
+	// Length of a fixed physics step in seconds. 0 if the timestep is variable.
+	float fixed_dt_{ 0.0f };
+	float max_frame_time_{ 0.25f };
+	// Frame time which has not been simulated by a fixed step yet. Unit: seconds.
+	float accumulator_{ 0.0f };
+	std::size_t fixed_steps_{ 1 };
+	float interpolation_alpha_{ 1.0f };
+
 public:
 	// @return Previous frame time in seconds.
 	[[nodiscard]] float dt() const;
 
+	// Simulates physics and collisions in fixed steps of 1 / tick_rate seconds, as many times per
+	// frame as the elapsed time requires. Rigid body transforms are drawn interpolated between
+	// their last two steps. Other systems, such as tweens and particles, keep using dt().
+	// @param tick_rate Steps per second. 0 returns to a single variable length step per frame.
+	void SetFixedTickRate(float tick_rate);
+
+	// @return Steps per second, or 0 if the timestep is variable.
+	[[nodiscard]] float GetFixedTickRate() const;
+
+	// @return Length of a fixed step in seconds, or 0 if the timestep is variable.
+	[[nodiscard]] float GetFixedTimestep() const;
+
+	[[nodiscard]] bool IsFixedTimestep() const;
+
+	// Frame times above this are clamped before being added to the fixed step accumulator, so
+	// that a slow frame does not queue more steps, which would make the next frame slower still.
+	// @param max_frame_time Unit: seconds. Default: 0.25.
+	void SetMaxFrameTime(float max_frame_time);
+	[[nodiscard]] float GetMaxFrameTime() const;
+
+	// @return Number of physics steps simulated during the current frame. Always 1 if the timestep
+	// is variable, and may be 0 if the frame was shorter than a fixed step.
+	[[nodiscard]] std::size_t GetFixedSteps() const;
+
+	// @return Fraction of a fixed step which has elapsed since the latest step, in [0, 1). Always
+	// 1 if the timestep is variable.
+	[[nodiscard]] float GetInterpolationAlpha() const;
+
 	// @return Milliseconds since Init() was called.
 	[[nodiscard]] float time() const;
 
@@ -111,6 +150,12 @@ public:
 	// @return True if the game subsystems have been initialized, false otherwise.
 	[[nodiscard]] bool IsInitialized() const;
 
+	// Headless mode is enabled by setting the PTGN_HEADLESS environment variable before the
+	// program starts. The window is created without an OpenGL context and every OpenGL call is
+	// recorded by a null backend instead, see GLContext::GetNullStats().
+	// @return True if the game is running without an OpenGL context.
+	[[nodiscard]] bool IsHeadless() const;
+
 private:
 	friend struct WindowDeleter;
 	friend struct Mix_MusicDeleter;
@@ -196,6 +241,13 @@ private:
 
 public:
 	DebugSystem& debug;
+
+private:
+	std::unique_ptr<FrameProfiler> profiler_;
+
+public:
+	// Records the PTGN_FRAME_SCOPE markers of each frame.
+	FrameProfiler& profiler;
 };
 
 } // namespace impl
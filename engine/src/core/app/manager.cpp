@@ -8,6 +8,7 @@
 #include "core/ecs/component_registry.h"
 #include "core/ecs/components/uuid.h"
 #include "core/ecs/entity.h"
+#include "core/scripting/script_listeners.h"
 #include "debug/runtime/assert.h"
 #include "ecs/ecs.h"
 #include "nlohmann/json.hpp"
@@ -16,6 +17,10 @@
 
 namespace ptgn {
 
+Manager::Manager() {
+	impl::ScriptListeners::Connect(*this);
+}
+
 void Manager::Refresh() {
 	ManagerBase::Refresh();
 }
@@ -72,14 +77,24 @@ void Manager::ClearEntities() {
 }
 
 void Manager::Clear() {
-	return ManagerBase::Clear();
+	ManagerBase::Clear();
+	script_listeners_.Reset();
 }
 
 void Manager::Reset() {
-	return ManagerBase::Reset();
+	ManagerBase::Reset();
+	script_listeners_.Reset();
+	// Resetting clears the component hooks.
+	impl::ScriptListeners::Connect(*this);
+}
+
+const std::vector<Entity>& Manager::GetScriptListeners(ScriptType type) {
+	return script_listeners_.Get(*this, type);
 }
 
-Manager::Manager(ManagerBase&& manager) : ManagerBase{ std::move(manager) } {}
+Manager::Manager(ManagerBase&& manager) : ManagerBase{ std::move(manager) } {
+	impl::ScriptListeners::Connect(*this);
+}
 
 void to_json(json& j, const Manager& manager) {
 	j["next_entity"]	  = manager.next_entity_;
@@ -124,6 +139,8 @@ void from_json(const json& j, Manager& manager) {
 		}
 		pool->Deserialize(archiver);
 	}
+
+	manager.script_listeners_.Reset();
 }
 
 } // namespace ptgn
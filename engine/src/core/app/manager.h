@@ -1,8 +1,12 @@
 #pragma once
 
+#include <vector>
+
 #include "core/ecs/components/component_utils.h"
+#include "core/ecs/components/transform.h"
 #include "core/ecs/components/uuid.h"
 #include "core/ecs/entity.h"
+#include "core/scripting/script_listeners.h"
 #include "ecs/ecs.h"
 #include "serialization/json/fwd.h"
 #include "serialization/json/json_archiver.h"
@@ -13,6 +17,8 @@ class Scene;
 class SceneInput;
 class Physics;
 
+enum class ScriptType;
+
 namespace impl {
 
 class RenderData;
@@ -36,7 +42,7 @@ private:
 	using ManagerBase = ecs::impl::Manager<JSONArchiver>;
 
 public:
-	Manager()							   = default;
+	Manager();
 	Manager(const Manager&)				   = default;
 	Manager& operator=(const Manager&)	   = default;
 	Manager(Manager&&) noexcept			   = default;
@@ -130,6 +136,11 @@ public:
 
 	void Reset();
 
+	// @return Entities with a script of the given type, in the order in which they started
+	// listening, with null entries for entities which stopped listening. Used to dispatch script
+	// events without visiting every scripted entity.
+	[[nodiscard]] const std::vector<Entity>& GetScriptListeners(ScriptType type);
+
 	/**
 	 * @brief Adds a construct hook for the specified component type.
 	 *
@@ -265,6 +276,8 @@ private:
 	friend class SceneInput;
 	friend class impl::RenderData;
 	friend class Physics;
+	friend class impl::ScriptListeners;
+	friend struct impl::WorldTransformCacheState;
 
 	// Same as EntitiesWith except allows non-retrievable components to be retrieved. Used for
 	// internal engine systems.
@@ -278,6 +291,10 @@ private:
 	void ClearEntities() final;
 
 	explicit Manager(ManagerBase&& manager);
+
+	impl::ScriptListeners script_listeners_;
+
+	impl::WorldTransformCacheState world_transform_cache_;
 };
 
 } // namespace ptgn
@@ -1,5 +1,6 @@
 #include "core/app/window.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -57,11 +58,14 @@ void WindowDeleter::operator()(SDL_Window* window) const {
 }
 
 WindowInstance::WindowInstance() {
+	std::uint32_t flags{ SDL_WINDOW_HIDDEN | SDL_WINDOW_RESIZABLE };
+	if (!game.IsHeadless()) {
+		flags |= SDL_WINDOW_OPENGL;
+	}
 	// Windows start zero-sized.
-	window_.reset(SDL_CreateWindow(
-		"", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 0, 0,
-		SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN | SDL_WINDOW_RESIZABLE
-	));
+	window_.reset(
+		SDL_CreateWindow("", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 0, 0, flags)
+	);
 }
 
 WindowInstance::operator SDL_Window*() const {
@@ -21,12 +21,14 @@ class IDrawable;
 class IDrawFilter;
 struct ChildKey;
 struct IgnoreParentTransform;
+struct WorldTransform;
 
 // Components which	cannot be modified or retrieved by the user through the entity class.
 template <typename T>
 concept RetrievableComponent = !IsAnyOf<
 	T, Transform, Depth, Visible, Interactive, impl::IDrawable, impl::IDrawFilter, Tint, Children,
-	Parent, impl::ChildKey, impl::IgnoreParentTransform, PreFX, PostFX, UUID>;
+	Parent, impl::ChildKey, impl::IgnoreParentTransform, impl::WorldTransform, PreFX, PostFX,
+	UUID>;
 
 template <typename... Ts>
 concept AllRetrievableComponents = (RetrievableComponent<Ts> && ...);
@@ -39,6 +39,7 @@
 #include "renderer/materials/texture.h"
 #include "renderer/render_data.h"
 #include "renderer/renderer.h"
+#include "renderer/text/glyph_atlas.h"
 #include "renderer/text/text.h"
 #include "world/scene/camera.h"
 #include "world/scene/scene.h"
@@ -171,7 +172,10 @@ V2_int GetTextureSize(const Entity& entity) {
 			return size;
 		}
 	}
-	if (entity.Has<TextureHandle>()) {
+	// Texts drawn from the glyph atlas do not have their own texture.
+	if (const auto* layout{ entity.TryGet<impl::TextLayout>() }; layout != nullptr) {
+		size = layout->size;
+	} else if (entity.Has<TextureHandle>()) {
 		size = entity.Get<TextureHandle>().GetSize(entity);
 	}
 
@@ -325,6 +329,20 @@ void DrawText(
 		}
 	}
 
+	if (text.IsOutdated()) {
+		text.RecreateTexture(cam);
+	}
+
+	Color text_tint{ additional_tint.Normalized() * tint.Normalized() };
+
+	if (const auto* layout{ text.TryGet<impl::TextLayout>() }; layout != nullptr) {
+		game.renderer.DrawTextLayout(
+			*layout, transform, V2_float{ text_size }, GetDrawOrigin(text), text_tint,
+			GetDepth(text), GetBlendMode(text), cam, text.GetOrDefault<PostFX>()
+		);
+		return;
+	}
+
 	const auto& text_texture{ text.GetTexture() };
 
 	if (!text_texture.IsValid()) {
@@ -346,8 +364,6 @@ void DrawText(
 
 	auto texture_coordinates{ Sprite{ text }.GetTextureCoordinates(false) };
 
-	Color text_tint{ additional_tint.Normalized() * tint.Normalized() };
-
 	game.renderer.DrawTexture(
 		text_texture, transform, size, GetDrawOrigin(text), text_tint, GetDepth(text),
 		GetBlendMode(text), cam, text.GetOrDefault<PreFX>(), text.GetOrDefault<PostFX>(),
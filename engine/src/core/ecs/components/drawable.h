@@ -6,6 +6,7 @@
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "core/utils/type_info.h"
@@ -48,12 +49,19 @@ public:
 		return s;
 	}
 
+	// Hashes of drawables whose draw function may be invoked for different entities at the same
+	// time, because it only reads components and submits draw commands.
+	static auto& concurrent() {
+		static std::unordered_set<std::size_t> s;
+		return s;
+	}
+
 	PTGN_SERIALIZER_REGISTER_NAMELESS_IGNORE_DEFAULTS(IDrawable, hash)
 
 	std::size_t hash{ 0 };
 };
 
-template <DrawableType T>
+template <DrawableType T, bool Concurrent = false>
 class DrawableRegistrar {
 	friend Entity;
 
@@ -62,6 +70,9 @@ class DrawableRegistrar {
 	static bool RegisterDrawFunction() {
 		constexpr auto name{ type_name<T>() };
 		IDrawable::data()[Hash(name)] = &T::Draw;
+		if constexpr (Concurrent) {
+			IDrawable::concurrent().emplace(Hash(name));
+		}
 		return true;
 	}
 
@@ -72,11 +83,18 @@ class DrawableRegistrar {
 	}
 };
 
-template <DrawableType T>
-bool DrawableRegistrar<T>::registered_draw = DrawableRegistrar<T>::RegisterDrawFunction();
+template <DrawableType T, bool Concurrent>
+bool DrawableRegistrar<T, Concurrent>::registered_draw =
+	DrawableRegistrar<T, Concurrent>::RegisterDrawFunction();
 
 } // namespace impl
 
 #define PTGN_DRAWABLE_REGISTER(Type) template class impl::DrawableRegistrar<Type>
 
+// Same as PTGN_DRAWABLE_REGISTER but allows the draw commands of the drawable to be recorded on
+// multiple threads. Type::Draw must not modify entities or renderer state other than submitting
+// draw commands.
+#define PTGN_DRAWABLE_REGISTER_CONCURRENT(Type) \
+	template class impl::DrawableRegistrar<Type, true>
+
 } // namespace ptgn
\ No newline at end of file
@@ -44,7 +44,7 @@ struct Sprite : public Entity {
 	[[nodiscard]] std::array<V2_float, 4> GetTextureCoordinates(bool flip_vertically) const;
 };
 
-PTGN_DRAWABLE_REGISTER(Sprite);
+PTGN_DRAWABLE_REGISTER_CONCURRENT(Sprite);
 
 Sprite CreateSprite(
 	Manager& manager, const TextureHandle& texture_key, const V2_float& position = {},
@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <span>
 #include <utility>
 #include <vector>
 
+#include "core/app/manager.h"
 #include "core/ecs/components/offsets.h"
 #include "core/ecs/entity.h"
 #include "core/ecs/entity_hierarchy.h"
@@ -36,7 +38,7 @@ Transform::Transform(Transform&& other) noexcept :
 	rotation_{ std::exchange(other.rotation_, 0.0f) },
 	scale_{ std::exchange(other.scale_, {}) },
 	dirty_flags_{ impl::TransformDirty::Position | impl::TransformDirty::Rotation |
-				  impl::TransformDirty::Scale } {}
+				  impl::TransformDirty::Scale | impl::TransformDirty::Physics } {}
 
 Transform& Transform::operator=(Transform&& other) noexcept {
 	if (&other != this) {
@@ -116,7 +118,7 @@ Transform& Transform::SetPosition(const V2_float& position) {
 		return *this;
 	}
 	position_ = position;
-	dirty_flags_.Set(impl::TransformDirty::Position);
+	dirty_flags_.Set(impl::TransformDirty::Position | impl::TransformDirty::Physics);
 	return *this;
 }
 
@@ -133,7 +135,7 @@ Transform& Transform::SetRotation(float rotation) {
 		return *this;
 	}
 	rotation_ = rotation;
-	dirty_flags_.Set(impl::TransformDirty::Rotation);
+	dirty_flags_.Set(impl::TransformDirty::Rotation | impl::TransformDirty::Physics);
 	return *this;
 }
 
@@ -151,7 +153,7 @@ Transform& Transform::SetScale(const V2_float& scale) {
 		return *this;
 	}
 	scale_ = scale;
-	dirty_flags_.Set(impl::TransformDirty::Scale);
+	dirty_flags_.Set(impl::TransformDirty::Scale | impl::TransformDirty::Physics);
 	return *this;
 }
 
@@ -192,11 +194,25 @@ Transform& Transform::ScaleY(float scale_y_multiplier) {
 }
 
 bool Transform::IsDirty() const {
-	return dirty_flags_.AnySet();
+	return dirty_flags_.IsSet(
+		impl::TransformDirty::Position | impl::TransformDirty::Rotation |
+		impl::TransformDirty::Scale
+	);
 }
 
 void Transform::ClearDirtyFlags() const {
-	dirty_flags_.ClearAll();
+	dirty_flags_.Clear(
+		impl::TransformDirty::Position | impl::TransformDirty::Rotation |
+		impl::TransformDirty::Scale
+	);
+}
+
+bool Transform::IsPhysicsDirty() const {
+	return dirty_flags_.IsSet(impl::TransformDirty::Physics);
+}
+
+void Transform::ClearPhysicsDirtyFlag() const {
+	dirty_flags_.Clear(impl::TransformDirty::Physics);
 }
 
 V2_float Transform::ApplyWithRotation(
@@ -338,7 +354,141 @@ Transform GetTransform(const Camera& camera) {
 	return { camera.GetScroll(), camera.GetRotation(), camera.GetZoom() };
 }
 
+namespace impl {
+
+WorldTransformCacheState& WorldTransformCacheState::Of(Manager& manager) {
+	return manager.world_transform_cache_;
+}
+
+const WorldTransformCacheState& WorldTransformCacheState::Of(const Manager& manager) {
+	return manager.world_transform_cache_;
+}
+
+// @return Cached world transform of the entity if it is valid for the current generation.
+static const WorldTransform* GetCachedWorldTransform(const Entity& entity) {
+	if (!entity) {
+		return nullptr;
+	}
+	auto generation{ WorldTransformCacheState::Of(entity.GetManager()).generation };
+	if (generation == 0) {
+		return nullptr;
+	}
+	const auto cache{ EntityAccess::TryGet<WorldTransform>(entity) };
+	if (cache == nullptr || cache->generation != generation) {
+		return nullptr;
+	}
+	return cache;
+}
+
+static const WorldTransform& UpdateWorldTransform(
+	Entity& entity, std::uint64_t generation, std::vector<Entity>& changed_entities
+) {
+	auto& cache{ EntityAccess::Get<WorldTransform>(entity) };
+	if (cache.generation == generation) {
+		return cache;
+	}
+
+	const auto transform{ EntityAccess::TryGet<Transform>(entity) };
+	const auto interpolated{ EntityAccess::TryGet<InterpolatedTransform>(entity) };
+
+	Entity parent;
+	if (!(entity.Has<IgnoreParentTransform>() && entity.Get<IgnoreParentTransform>()) &&
+		HasParent(entity)) {
+		parent = GetParent(entity);
+	}
+
+	// Entries which have never been computed start out with an identity transform.
+	// Interpolated poses move every frame, even when the transform does not.
+	bool changed{ cache.generation == 0 || parent != cache.parent || interpolated != nullptr ||
+				  (transform != nullptr && transform->IsDirty()) };
+
+	bool relative_to_camera{ entity.GetNonPrimaryCamera() != nullptr };
+
+	const WorldTransform* parent_cache{ nullptr };
+	if (parent && parent.Has<WorldTransform>()) {
+		parent_cache	   = &UpdateWorldTransform(parent, generation, changed_entities);
+		changed			   = changed || parent_cache->changed;
+		relative_to_camera = relative_to_camera || parent_cache->relative_to_camera;
+	} else if (parent) {
+		// Ancestors outside of the cache are always recomputed.
+		changed = true;
+	}
+
+	if (changed) {
+		Transform local;
+		if (interpolated != nullptr) {
+			local = interpolated->render;
+		} else if (transform != nullptr) {
+			local = *transform;
+		}
+		if (parent_cache != nullptr) {
+			cache.transform = local.RelativeTo(parent_cache->transform);
+		} else if (parent) {
+			cache.transform = local.RelativeTo(GetWorldTransform(parent));
+		} else {
+			cache.transform = local;
+		}
+		changed_entities.emplace_back(entity);
+	}
+
+	cache.parent			 = parent;
+	cache.changed			 = changed;
+	cache.relative_to_camera = relative_to_camera;
+	cache.generation		 = generation;
+	return cache;
+}
+
+void UpdateWorldTransformCache(Manager& manager, const std::vector<Entity>& entities) {
+	auto& state{ WorldTransformCacheState::Of(manager) };
+	state.generation = 0;
+
+	// Adding the cache entries first ensures that references to them remain valid while the
+	// hierarchy is traversed.
+	for (auto entity : entities) {
+		while (entity && !entity.Has<CameraInstance>() && !entity.Has<WorldTransform>()) {
+			EntityAccess::Add<WorldTransform>(entity);
+			if (!HasParent(entity)) {
+				break;
+			}
+			entity = GetParent(entity);
+		}
+	}
+
+	auto generation{ ++state.latest_generation };
+
+	state.changed.clear();
+	for (auto entity : entities) {
+		if (entity.Has<WorldTransform>()) {
+			UpdateWorldTransform(entity, generation, state.changed);
+		}
+	}
+
+	state.generation = generation;
+}
+
+void DisableWorldTransformCache(Manager& manager) {
+	WorldTransformCacheState::Of(manager).generation = 0;
+}
+
+void InvalidateWorldTransform(Entity& entity) {
+	// Entries which have never been computed are always recomputed.
+	if (const auto cache{ EntityAccess::TryGet<WorldTransform>(entity) }) {
+		cache->generation = 0;
+	}
+}
+
+bool HasWorldTransformChanged(const Entity& entity) {
+	const auto cache{ GetCachedWorldTransform(entity) };
+	return cache == nullptr || cache->changed;
+}
+
+} // namespace impl
+
 Transform GetAbsoluteTransform(const Entity& entity) {
+	if (const auto cache{ impl::GetCachedWorldTransform(entity) };
+		cache != nullptr && !cache->relative_to_camera) {
+		return cache->transform;
+	}
 	Transform world_transform;
 	auto transform{ GetTransform(entity) };
 	if (entity.Has<impl::IgnoreParentTransform>() && entity.Get<impl::IgnoreParentTransform>()) {
@@ -373,6 +523,9 @@ Transform GetAbsoluteTransform(const Camera& entity) {
 }
 
 Transform GetWorldTransform(const Entity& entity) {
+	if (const auto cache{ impl::GetCachedWorldTransform(entity) }) {
+		return cache->transform;
+	}
 	auto transform{ GetTransform(entity) };
 	if (entity.Has<impl::IgnoreParentTransform>() && entity.Get<impl::IgnoreParentTransform>()) {
 		return transform;
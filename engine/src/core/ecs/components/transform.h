@@ -16,6 +16,7 @@
 namespace ptgn {
 
 class Camera;
+class Manager;
 class Scene;
 
 namespace impl {
@@ -25,6 +26,8 @@ enum class TransformDirty : std::uint8_t {
 	Position = 1 << 0,
 	Rotation = 1 << 1,
 	Scale	 = 1 << 2,
+	// Set along with the other flags, but only cleared once a physics step has consumed it.
+	Physics	 = 1 << 3,
 };
 
 PTGN_FLAGS_OPERATORS(TransformDirty)
@@ -35,6 +38,8 @@ struct IgnoreParentTransform : public BoolComponent {
 	IgnoreParentTransform() : BoolComponent{ true } {}
 };
 
+struct WorldTransform;
+
 } // namespace impl
 
 struct Transform {
@@ -103,9 +108,15 @@ struct Transform {
 	Transform& ScaleX(float scale_x_multiplier);
 	Transform& ScaleY(float scale_y_multiplier);
 
+	// @return True if the position, rotation or scale changed since the dirty flags were cleared.
 	[[nodiscard]] bool IsDirty() const;
+	// Does not clear the physics dirty flag.
 	void ClearDirtyFlags() const;
 
+	// @return True if the transform changed since the latest physics step.
+	[[nodiscard]] bool IsPhysicsDirty() const;
+	void ClearPhysicsDirtyFlag() const;
+
 	[[nodiscard]] V2_float Apply(const V2_float& point) const;
 
 	[[nodiscard]] V2_float ApplyInverse(const V2_float& point) const;
@@ -156,9 +167,10 @@ private:
 	V2_float scale_{ 1.0f, 1.0f };
 
 	// By default all flags are dirty.
-	mutable Flags<impl::TransformDirty> dirty_flags_{ impl::TransformDirty::Position |
-													  impl::TransformDirty::Rotation |
-													  impl::TransformDirty::Scale };
+	mutable Flags<impl::TransformDirty> dirty_flags_{
+		impl::TransformDirty::Position | impl::TransformDirty::Rotation |
+		impl::TransformDirty::Scale | impl::TransformDirty::Physics
+	};
 
 	PTGN_SERIALIZER_REGISTER_NAMED_IGNORE_DEFAULTS(
 		Transform, KeyValue("position", position_), KeyValue("rotation", rotation_),
@@ -166,6 +178,89 @@ private:
 	)
 };
 
+namespace impl {
+
+// World transform of an entity cached by UpdateWorldTransformCache().
+struct WorldTransform {
+	Transform transform;
+
+	// Parent which the transform was computed relative to. Null if the parent transform is
+	// ignored or the entity has no parent.
+	Entity parent;
+
+	// Value of the cache generation when the entry was last validated.
+	std::uint64_t generation{ 0 };
+
+	// Transform was recomputed during the latest update, so children must be recomputed too.
+	bool changed{ false };
+
+	// Entity or one of its ancestors has a non-primary camera, so its absolute transform cannot
+	// be taken from the cache.
+	bool relative_to_camera{ false };
+
+	// The cache is rebuilt from the entity transforms, so it is never serialized.
+	friend void to_json([[maybe_unused]] json& j, [[maybe_unused]] const WorldTransform& cache) {}
+
+	friend void from_json([[maybe_unused]] const json& j, WorldTransform& cache) {
+		cache = {};
+	}
+};
+
+// Transforms of a rigid body at the start and end of the latest fixed physics step. Drawing
+// interpolates between the two, so that motion appears smooth when the frame rate and tick rate
+// differ.
+struct InterpolatedTransform {
+	Transform previous;
+	Transform current;
+	// Interpolated pose which the world transform cache uses in place of the transform of the
+	// rigid body, so that the transform itself is never modified for drawing.
+	Transform render;
+
+	// All transforms are recorded again on the next physics step, so they are never serialized.
+	friend void to_json(
+		[[maybe_unused]] json& j, [[maybe_unused]] const InterpolatedTransform& interpolated
+	) {}
+
+	friend void from_json([[maybe_unused]] const json& j, InterpolatedTransform& interpolated) {
+		interpolated = {};
+	}
+};
+
+// World transform cache generations of a manager.
+struct WorldTransformCacheState {
+	// Generation of the cache entries which may currently be used for lookups. Zero while the
+	// cache is disabled.
+	std::uint64_t generation{ 0 };
+	// Generation of the latest cache update.
+	std::uint64_t latest_generation{ 0 };
+	// Entities whose world transform was recomputed by the latest cache update. Kept to reuse its
+	// capacity.
+	std::vector<Entity> changed;
+
+	[[nodiscard]] static WorldTransformCacheState& Of(Manager& manager);
+	[[nodiscard]] static const WorldTransformCacheState& Of(const Manager& manager);
+};
+
+// Updates the cached world transforms of the entities and their ancestors in hierarchy order and
+// uses them for world and absolute transform lookups of entities in the manager until
+// DisableWorldTransformCache() is called. Only entities whose transform, parent or ancestors
+// changed since their dirty flags were last cleared are recomputed. Entities with an
+// InterpolatedTransform are cached at their interpolated render pose. Transforms must not be
+// modified while the cache is in use.
+void UpdateWorldTransformCache(Manager& manager, const std::vector<Entity>& entities);
+
+void DisableWorldTransformCache(Manager& manager);
+
+// Forces the world transform of the entity and its descendants to be recomputed during the next
+// cache update, even if the dirty flags of its transform have been cleared since it changed.
+void InvalidateWorldTransform(Entity& entity);
+
+// @return False if the world transform cache is in use and the world transform of the entity was
+// not recomputed during the latest cache update, true otherwise.
+[[nodiscard]] bool HasWorldTransformChanged(const Entity& entity);
+
+} // namespace impl
+
 // Set the transform of the entity with respect to its parent entity.
 // @return *this.
 template <EntityBase T>
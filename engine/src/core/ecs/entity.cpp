@@ -8,6 +8,7 @@
 #include "core/ecs/component_registry.h"
 #include "core/ecs/components/uuid.h"
 #include "core/ecs/entity_hierarchy.h"
+#include "core/scripting/script_listeners.h"
 #include "core/utils/type_info.h"
 #include "debug/runtime/assert.h"
 #include "ecs/ecs.h"
@@ -176,6 +177,10 @@ void Entity::DeserializeAllImpl(const json& j) {
 	}
 }
 
+void Entity::UpdateScriptListeners() {
+	impl::ScriptListeners::Update(*this);
+}
+
 void to_json(json& j, const Entity& entity) {
 	j = json{};
 
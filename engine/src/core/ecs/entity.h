@@ -181,6 +181,8 @@ public:
 			PTGN_ASSERT(*this, "Cannot deserialize to a null entity");
 			(DeserializeImpl<Ts>(j), ...);
 		}
+		// Deserialized scripts replace the existing ones without going through AddScript.
+		UpdateScriptListeners();
 	}
 
 	template <typename T, typename... TArgs>
@@ -265,6 +267,8 @@ private:
 	}
 
 	void DeserializeAllImpl(const json& j);
+
+	void UpdateScriptListeners();
 };
 
 template <typename T>
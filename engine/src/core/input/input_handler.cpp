@@ -194,68 +194,40 @@ void InputHandler::InvokeInputEvents(Manager& manager) {
 
 				// Mouse events.
 				if constexpr (std::is_same_v<T, impl::MouseMove>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&GlobalMouseScript::OnMouseMove);
-					}
+					impl::AddScriptActions(manager, &GlobalMouseScript::OnMouseMove);
 				} else if constexpr (std::is_same_v<T, impl::MouseDown>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&GlobalMouseScript::OnMouseDown, ev.button);
-					}
+					impl::AddScriptActions(manager, &GlobalMouseScript::OnMouseDown, ev.button);
 				} else if constexpr (std::is_same_v<T, impl::MousePressed>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&GlobalMouseScript::OnMousePressed, ev.button);
-					}
+					impl::AddScriptActions(manager, &GlobalMouseScript::OnMousePressed, ev.button);
 				} else if constexpr (std::is_same_v<T, impl::MouseUp>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&GlobalMouseScript::OnMouseUp, ev.button);
-					}
+					impl::AddScriptActions(manager, &GlobalMouseScript::OnMouseUp, ev.button);
 				} else if constexpr (std::is_same_v<T, impl::MouseScroll>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&GlobalMouseScript::OnMouseScroll, ev.scroll);
-					}
+					impl::AddScriptActions(manager, &GlobalMouseScript::OnMouseScroll, ev.scroll);
 				}
 
 				// Keyboard events.
 				if constexpr (std::is_same_v<T, impl::KeyDown>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&KeyScript::OnKeyDown, ev.key);
-						scripts.AddAction(&KeyScript::OnKeyPressed, ev.key);
-					}
+					impl::AddScriptActions(manager, &KeyScript::OnKeyDown, ev.key);
+					impl::AddScriptActions(manager, &KeyScript::OnKeyPressed, ev.key);
 				} else if constexpr (std::is_same_v<T, impl::KeyPressed>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&KeyScript::OnKeyPressed, ev.key);
-					}
+					impl::AddScriptActions(manager, &KeyScript::OnKeyPressed, ev.key);
 				} else if constexpr (std::is_same_v<T, impl::KeyUp>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&KeyScript::OnKeyUp, ev.key);
-					}
+					impl::AddScriptActions(manager, &KeyScript::OnKeyUp, ev.key);
 				}
 
 				// Window events.
 				else if constexpr (std::is_same_v<T, impl::WindowResized>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&WindowScript::OnWindowResized);
-					}
+					impl::AddScriptActions(manager, &WindowScript::OnWindowResized);
 				} else if constexpr (std::is_same_v<T, impl::WindowMoved>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&WindowScript::OnWindowMoved);
-					}
+					impl::AddScriptActions(manager, &WindowScript::OnWindowMoved);
 				} else if constexpr (std::is_same_v<T, impl::WindowMaximized>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&WindowScript::OnWindowMaximized);
-					}
+					impl::AddScriptActions(manager, &WindowScript::OnWindowMaximized);
 				} else if constexpr (std::is_same_v<T, impl::WindowMinimized>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&WindowScript::OnWindowMinimized);
-					}
+					impl::AddScriptActions(manager, &WindowScript::OnWindowMinimized);
 				} else if constexpr (std::is_same_v<T, impl::WindowFocusLost>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&WindowScript::OnWindowFocusLost);
-					}
+					impl::AddScriptActions(manager, &WindowScript::OnWindowFocusLost);
 				} else if constexpr (std::is_same_v<T, impl::WindowFocusGained>) {
-					for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-						scripts.AddAction(&WindowScript::OnWindowFocusGained);
-					}
+					impl::AddScriptActions(manager, &WindowScript::OnWindowFocusGained);
 				} else if constexpr (std::is_same_v<T, impl::WindowQuit>) {
 					game.Stop();
 				}
@@ -264,9 +236,7 @@ void InputHandler::InvokeInputEvents(Manager& manager) {
 		);
 	}
 
-	for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-		scripts.InvokeActions();
-	}
+	impl::InvokeScriptActions(manager);
 
 	manager.Refresh();
 }
@@ -59,10 +59,10 @@ public:
 	virtual void Load(const HandleType& key, const path& filepath);
 
 	// Unload a resource by its key. Does nothing if the resource was not loaded.
-	void Unload(const HandleType& key);
+	virtual void Unload(const HandleType& key);
 
 	// Clear all loaded resources.
-	void Clear();
+	virtual void Clear();
 
 	// @return True if the resource key is loaded.
 	[[nodiscard]] bool Has(const HandleType& key) const;
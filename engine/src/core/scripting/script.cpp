@@ -1,7 +1,59 @@
 #include "core/scripting/script.h"
 
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "core/scripting/script_interfaces.h"
+#include "debug/runtime/assert.h"
+
 namespace ptgn {
 
-namespace impl {} // namespace impl
+namespace impl {
+
+struct ScriptInvocationState {
+	std::size_t depth{ 0 };
+	std::vector<IScript*> scripts;
+	std::vector<std::shared_ptr<IScript>> retired;
+};
+
+static ScriptInvocationState& GetInvocationState() {
+	thread_local ScriptInvocationState state;
+	return state;
+}
+
+ScriptInvocation::ScriptInvocation() {
+	++GetInvocationState().depth;
+}
+
+ScriptInvocation::~ScriptInvocation() {
+	auto& state{ GetInvocationState() };
+	PTGN_ASSERT(state.depth > 0, "Script invocation ended without being started");
+	if (--state.depth > 0 || state.retired.empty()) {
+		return;
+	}
+	// Swapped out first, since destroying scripts may retire further scripts.
+	std::vector<std::shared_ptr<IScript>> retired;
+	retired.swap(state.retired);
+}
+
+std::vector<IScript*>& ScriptInvocation::GetScripts() {
+	return GetInvocationState().scripts;
+}
+
+void ScriptInvocation::Retire(
+	std::vector<std::shared_ptr<IScript>>::iterator first,
+	std::vector<std::shared_ptr<IScript>>::iterator last
+) {
+	auto& state{ GetInvocationState() };
+	if (state.depth == 0) {
+		return;
+	}
+	state.retired.insert(
+		state.retired.end(), std::make_move_iterator(first), std::make_move_iterator(last)
+	);
+}
+
+} // namespace impl
 
 } // namespace ptgn
@@ -3,17 +3,23 @@
 #include <algorithm>
 #include <array>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <new>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "core/app/manager.h"
 #include "core/ecs/entity.h"
 #include "core/scripting/script_interfaces.h"
+#include "core/scripting/script_listeners.h"
 #include "debug/runtime/assert.h"
 #include "math/hash.h"
 #include "nlohmann/json.hpp"
@@ -103,9 +109,34 @@ public:
 		return Hash(name);
 	}
 
+	using impl::IScript::GetInterface;
+
+	void* GetInterface(ScriptType type) final {
+		static constexpr auto interfaces{ MakeInterfaces() };
+		return interfaces[static_cast<std::size_t>(type)](this);
+	}
+
 private:
 	friend class Scripts;
 
+	using InterfaceCast = void* (*)(impl::IScript*);
+
+	// @return Casts from the script to each of its interfaces, indexed by script type.
+	static constexpr std::array<InterfaceCast, impl::script_type_count> MakeInterfaces() {
+		std::array<InterfaceCast, impl::script_type_count> interfaces{};
+		interfaces.fill([](impl::IScript*) -> void* { return nullptr; });
+		interfaces[static_cast<std::size_t>(ScriptType::Base)] = [](impl::IScript* script
+																 ) -> void* {
+			return script;
+		};
+		((interfaces[static_cast<std::size_t>(TScripts::GetScriptType())] =
+			  [](impl::IScript* script) -> void* {
+				  return static_cast<TScripts*>(static_cast<TDerived*>(script));
+			  }),
+		 ...);
+		return interfaces;
+	}
+
 	constexpr bool HasScriptType(ScriptType type) const final {
 		return HasScriptTypeImpl(type);
 	}
@@ -170,17 +201,91 @@ private:
 template <typename TDerived, typename... TScripts>
 bool Script<TDerived, TScripts...>::is_registered_ = Script<TDerived, TScripts...>::Register();
 
+namespace impl {
+
+// Tracks the script invocations in progress on the current thread. Scripts which are removed or
+// destroyed while an invocation is in progress are kept alive until the outermost invocation
+// returns, since the invoked script may remove itself or destroy its own entity.
+class ScriptInvocation {
+public:
+	ScriptInvocation();
+	~ScriptInvocation();
+	ScriptInvocation(ScriptInvocation&&)				 = delete;
+	ScriptInvocation& operator=(ScriptInvocation&&)		 = delete;
+	ScriptInvocation(const ScriptInvocation&)			 = delete;
+	ScriptInvocation& operator=(const ScriptInvocation&) = delete;
+
+	// @return Scripts being invoked by the invocations in progress on this thread. Each
+	// invocation appends the scripts it invokes and removes them when it returns.
+	[[nodiscard]] static std::vector<IScript*>& GetScripts();
+
+	// Keeps the scripts alive until the outermost invocation returns, if any invocation is in
+	// progress. The caller releases the scripts afterwards.
+	static void Retire(
+		std::vector<std::shared_ptr<IScript>>::iterator first,
+		std::vector<std::shared_ptr<IScript>>::iterator last
+	);
+};
+
+} // namespace impl
+
 class Scripts {
 public:
+	Scripts() = default;
+
+	Scripts(const Scripts& other) :
+		scripts_{ other.scripts_ }, actions_{ other.actions_ }, types_{ other.types_ } {}
+
+	Scripts& operator=(const Scripts& other) {
+		if (this != &other) {
+			impl::ScriptInvocation::Retire(scripts_.begin(), scripts_.end());
+			scripts_ = other.scripts_;
+			actions_ = other.actions_;
+			types_	 = other.types_;
+		}
+		return *this;
+	}
+
+	Scripts(Scripts&& other) noexcept :
+		scripts_{ std::move(other.scripts_) },
+		actions_{ std::move(other.actions_) },
+		types_{ std::exchange(other.types_, 0) } {
+		other.scripts_.clear();
+	}
+
+	Scripts& operator=(Scripts&& other) noexcept {
+		if (this != &other) {
+			impl::ScriptInvocation::Retire(scripts_.begin(), scripts_.end());
+			scripts_ = std::move(other.scripts_);
+			actions_ = std::move(other.actions_);
+			types_	 = std::exchange(other.types_, 0);
+			other.scripts_.clear();
+		}
+		return *this;
+	}
+
+	~Scripts() {
+		if (!scripts_.empty()) {
+			impl::ScriptInvocation::Retire(scripts_.begin(), scripts_.end());
+		}
+	}
+
 	// Will call ClearActions after all actions have been executed.
 	void InvokeActions() {
 		while (!actions_.empty()) {
-			auto current_actions{ std::move(actions_) };
-			ClearActions();
+			// Actions may queue further actions, which are invoked in the next pass.
+			std::vector<Action> current_actions;
+			current_actions.swap(actions_);
 
-			for (const auto& action : current_actions) {
+			for (auto& action : current_actions) {
 				action(*this);
 			}
+
+			// Reuse the larger queue so that steady state frames do not allocate.
+			current_actions.clear();
+			if (actions_.empty()) {
+				actions_.swap(current_actions);
+			}
 		}
 	}
 
@@ -193,48 +298,43 @@ public:
 	template <typename TInterface, typename... TArgs>
 	void AddAction(void (TInterface::*func)(TArgs...), TArgs... args) {
 		constexpr ScriptType type{ TInterface::GetScriptType() };
-		bool has_script{ false };
-		for (const auto& script : scripts_) {
-			if (script->HasScriptType(type)) {
-				has_script = true;
-				break;
-			}
-		}
-		if (!has_script) {
+		if (!HasScriptType(type)) {
 			return;
 		}
-		auto action{ MakeAction(func, std::forward<TArgs>(args)...) };
-		actions_.emplace_back(action);
+		if (actions_.empty()) {
+			// Scripts hold the entity which they are attached to.
+			if (const auto& entity{ scripts_.front()->entity }; entity) {
+				impl::ScriptListeners::AddPending(entity);
+			}
+		}
+		actions_.emplace_back(func, std::forward<TArgs>(args)...);
 	}
 
 	// Example usage:
 	// scripts.Invoke(&KeyScript::OnKeyDown, Key::W);
 	template <typename TInterface, typename... TArgs>
 	void Invoke(void (TInterface::*func)(TArgs...), TArgs&&... args) {
-		constexpr ScriptType type{ TInterface::GetScriptType() };
-
-		// In case the action function removes scripts, this prevents iterator
-		// invalidation.
-		auto scripts{ scripts_ };
-		for (std::shared_ptr<impl::IScript> script : scripts) {
-			if (!script->HasScriptType(type)) {
-				continue;
-			}
-			TryInvoke(script.get(), func, std::forward<TArgs>(args)...);
-		}
+		Dispatch(func, args...);
 	}
 
+	// Scripts of an entity should be added using the free AddScript function, which also updates
+	// the script listeners of the entity's manager.
 	template <typename TScript, typename... TArgs>
 		requires std::constructible_from<
 			TScript, TArgs...> // TODO: Fix concept impl::DerivedFromTemplate<TScript, Script>
 	TScript& AddScript(TArgs&&... args) {
-		auto& script{ scripts_.emplace_back(std::make_shared<TScript>(std::forward<TArgs>(args)...)
-		) };
-		// Explicit for debugging purposes.
-		TScript& s{ *std::dynamic_pointer_cast<TScript>(script) };
+		auto script{ std::make_shared<TScript>(std::forward<TArgs>(args)...) };
+		TScript& s{ *script };
+		types_ |= GetScriptTypes(s);
+		scripts_.emplace_back(std::move(script));
 		return s;
 	}
 
+	// @return True if any of the scripts implements the given script type.
+	[[nodiscard]] bool HasScriptType(ScriptType type) const {
+		return (types_ & GetScriptTypeBit(type)) != 0;
+	}
+
 	template <typename TScript>
 	[[nodiscard]] bool HasScript() const {
 		constexpr auto name{ type_name<TScript>() };
@@ -244,14 +344,24 @@ public:
 		});
 	}
 
+	// Scripts removed while a script is being invoked are kept alive until the invocation
+	// returns.
 	template <typename TScript>
 	void RemoveScripts() {
 		constexpr auto name{ type_name<TScript>() };
 		constexpr auto hash{ Hash(name) };
-		auto it{ std::remove_if(scripts_.begin(), scripts_.end(), [](const auto& script) {
-			return script->GetHash() == hash;
+		auto it{ std::stable_partition(scripts_.begin(), scripts_.end(), [](const auto& script) {
+			return script->GetHash() != hash;
 		}) };
+		if (it == scripts_.end()) {
+			return;
+		}
+		impl::ScriptInvocation::Retire(it, scripts_.end());
 		scripts_.erase(it, scripts_.end());
+		types_ = 0;
+		for (const auto& script : scripts_) {
+			types_ |= GetScriptTypes(*script);
+		}
 	}
 
 	friend void to_json(json& j, const Scripts& container) {
@@ -293,6 +403,7 @@ public:
 				instance->Deserialize(script);
 				PTGN_ASSERT(entity, "Failed to deserialize entity for type: ", class_name);
 				instance->entity = entity;
+				container.types_ |= GetScriptTypes(*instance);
 				container.scripts_.emplace_back(instance);
 			}
 		};
@@ -314,53 +425,186 @@ public:
 		const {
 		constexpr ScriptType type{ TInterface::GetScriptType() };
 
-		// In case the condition check function removes scripts, this prevents iterator
-		// invalidation.
-		auto scripts{ scripts_ };
-		for (const auto& script : scripts) {
-			if (!script->HasScriptType(type)) {
-				continue;
-			}
-			if (const auto* handler = dynamic_cast<const TInterface*>(script.get())) {
-				bool result{ (handler->*func)(std::forward<TArgs>(args)...) };
-				if (!result) {
-					return false;
-				}
-			}
+		if (!HasScriptType(type)) {
+			return true;
 		}
-		return true;
+
+		impl::ScriptInvocation invocation;
+		auto& scripts{ impl::ScriptInvocation::GetScripts() };
+		auto begin{ GatherScripts(scripts, type) };
+		auto end{ scripts.size() };
+
+		bool result{ true };
+		for (auto i{ begin }; i < end && result; ++i) {
+			const auto* handler{ std::as_const(*scripts[i]).template GetInterface<TInterface>() };
+			PTGN_ASSERT(handler != nullptr, "Script does not implement its script type");
+			result = (handler->*func)(args...);
+		}
+
+		scripts.resize(begin);
+		return result;
 	}
 
 private:
-	std::vector<std::shared_ptr<impl::IScript>> scripts_;
+	static_assert(impl::script_type_count <= 32, "Script types must fit in a 32 bit mask");
+
+	// Size of the arguments which an action can store. Unit: bytes.
+	static constexpr std::size_t action_capacity{ 64 };
+
+	// Queued call of a script interface function. The function and its arguments are stored
+	// inline, so queueing an action does not allocate once the queue has reached its steady state
+	// capacity.
+	class Action {
+	public:
+		template <typename TInterface, typename... TArgs>
+		Action(void (TInterface::*func)(TArgs...), std::type_identity_t<TArgs>... args) {
+			using Payload = ActionPayload<TInterface, TArgs...>;
+			static_assert(
+				sizeof(Payload) <= action_capacity, "Script action arguments exceed action capacity"
+			);
+			static_assert(alignof(Payload) <= alignof(std::max_align_t));
+			new (storage_) Payload{ func, { std::forward<TArgs>(args)... } };
+			ops_ = &GetOps<Payload>();
+		}
 
-	std::vector<std::function<void(Scripts&)>> actions_;
+		Action(const Action& other) : ops_{ other.ops_ } {
+			ops_->copy(storage_, other.storage_);
+		}
 
-	template <typename TInterface, typename... TArgs>
-	auto MakeAction(void (TInterface::*func)(TArgs...), TArgs&&... args) {
-		return
-			[func, tup = std::make_tuple(std::forward<TArgs>(args)...)](Scripts& scripts) mutable {
+		Action& operator=(const Action& other) {
+			if (this != &other) {
+				ops_->destroy(storage_);
+				ops_ = other.ops_;
+				ops_->copy(storage_, other.storage_);
+			}
+			return *this;
+		}
+
+		Action(Action&& other) noexcept : ops_{ other.ops_ } {
+			ops_->move(storage_, other.storage_);
+		}
+
+		Action& operator=(Action&& other) noexcept {
+			if (this != &other) {
+				ops_->destroy(storage_);
+				ops_ = other.ops_;
+				ops_->move(storage_, other.storage_);
+			}
+			return *this;
+		}
+
+		~Action() {
+			ops_->destroy(storage_);
+		}
+
+		void operator()(Scripts& scripts) {
+			ops_->invoke(scripts, storage_);
+		}
+
+	private:
+		template <typename TInterface, typename... TArgs>
+		struct ActionPayload {
+			void (TInterface::*func)(TArgs...);
+			std::tuple<std::decay_t<TArgs>...> args;
+
+			void operator()(Scripts& scripts) const {
 				std::apply(
-					[&scripts, func](auto&&... unpacked) mutable {
+					[&](const auto&... values) {
 						// If there is ever a crash here, it is most likely because the scripts
-						// reference is no longer valid. In this case, just change this lambda to
-						// take a copy of scripts into a variable to keep it valid throughout the
-						// invokation.
-						scripts.Invoke(func, std::forward<decltype(unpacked)>(unpacked)...);
+						// reference is no longer valid.
+						scripts.Dispatch(func, values...);
 					},
-					std::move(tup)
+					args
 				);
+			}
+		};
+
+		struct Ops {
+			void (*invoke)(Scripts&, void*);
+			void (*copy)(void*, const void*);
+			void (*move)(void*, void*);
+			void (*destroy)(void*);
+		};
+
+		template <typename TPayload>
+		[[nodiscard]] static const Ops& GetOps() {
+			static constexpr Ops ops{
+				[](Scripts& scripts, void* payload) {
+					(*static_cast<TPayload*>(payload))(scripts);
+				},
+				[](void* destination, const void* source) {
+					new (destination) TPayload{ *static_cast<const TPayload*>(source) };
+				},
+				[](void* destination, void* source) {
+					new (destination) TPayload{ std::move(*static_cast<TPayload*>(source)) };
+				},
+				[](void* payload) { static_cast<TPayload*>(payload)->~TPayload(); }
 			};
+			return ops;
+		}
+
+		const Ops* ops_{ nullptr };
+
+		alignas(std::max_align_t) std::byte storage_[action_capacity];
+	};
+
+	[[nodiscard]] static constexpr std::uint32_t GetScriptTypeBit(ScriptType type) {
+		return std::uint32_t{ 1 } << static_cast<std::uint32_t>(type);
 	}
 
-	template <typename TInterface, typename... TArgs>
-	static void TryInvoke(
-		impl::IScript* script, void (TInterface::*func)(TArgs...), TArgs&&... args
-	) {
-		if (auto* handler = dynamic_cast<TInterface*>(script)) {
-			(handler->*func)(std::forward<TArgs>(args)...);
+	// @return Mask of the script types which the script implements.
+	[[nodiscard]] static std::uint32_t GetScriptTypes(const impl::IScript& script) {
+		std::uint32_t types{ 0 };
+		for (std::size_t i{ 0 }; i < impl::script_type_count; ++i) {
+			auto type{ static_cast<ScriptType>(i) };
+			if (script.HasScriptType(type)) {
+				types |= GetScriptTypeBit(type);
+			}
 		}
+		return types;
 	}
+
+	// Invoked scripts may add or remove scripts, or cause this container to be moved, so the
+	// scripts of the given type are gathered before invoking any of them.
+	// @return Index of the first gathered script.
+	std::size_t GatherScripts(std::vector<impl::IScript*>& scripts, ScriptType type) const {
+		auto begin{ scripts.size() };
+		for (const auto& script : scripts_) {
+			if (script->HasScriptType(type)) {
+				scripts.emplace_back(script.get());
+			}
+		}
+		return begin;
+	}
+
+	template <typename TInterface, typename... TArgs, typename... TValues>
+	void Dispatch(void (TInterface::*func)(TArgs...), const TValues&... values) {
+		constexpr ScriptType type{ TInterface::GetScriptType() };
+
+		if (!HasScriptType(type)) {
+			return;
+		}
+
+		impl::ScriptInvocation invocation;
+		auto& scripts{ impl::ScriptInvocation::GetScripts() };
+		auto begin{ GatherScripts(scripts, type) };
+		auto end{ scripts.size() };
+
+		for (auto i{ begin }; i < end; ++i) {
+			auto* handler{ scripts[i]->template GetInterface<TInterface>() };
+			PTGN_ASSERT(handler != nullptr, "Script does not implement its script type");
+			(handler->*func)(values...);
+		}
+
+		scripts.resize(begin);
+	}
+
+	std::vector<std::shared_ptr<impl::IScript>> scripts_;
+
+	std::vector<Action> actions_;
+
+	// Mask of the script types implemented by any of the scripts.
+	std::uint32_t types_{ 0 };
 };
 
 /**
@@ -380,6 +624,8 @@ T& AddScript(Entity& entity, TArgs&&... args) {
 
 	auto& script{ scripts.AddScript<T>(std::forward<TArgs>(args)...) };
 
+	impl::ScriptListeners::Update(entity);
+
 	script.entity = entity;
 
 	script.OnCreate();
@@ -398,6 +644,8 @@ void TryAddScript(Entity& entity, TArgs&&... args) {
 
 	auto& script{ scripts.AddScript<T>(std::forward<TArgs>(args)...) };
 
+	impl::ScriptListeners::Update(entity);
+
 	script.entity = entity;
 
 	script.OnCreate();
@@ -432,6 +680,28 @@ void RemoveScripts(Entity& entity) {
 	}
 
 	scripts.RemoveScripts<T>();
+
+	impl::ScriptListeners::Update(entity);
+}
+
+namespace impl {
+
+// Queues the action on every entity of the manager which has a script implementing its interface.
+template <typename TInterface, typename... TArgs>
+void AddScriptActions(Manager& manager, void (TInterface::*func)(TArgs...), TArgs... args) {
+	constexpr ScriptType type{ TInterface::GetScriptType() };
+	for (Entity entity : manager.GetScriptListeners(type)) {
+		if (entity.IsAlive() && entity.Has<Scripts>()) {
+			entity.Get<Scripts>().AddAction(func, args...);
+		}
+	}
 }
 
+// Invokes the queued actions of every entity of the manager whose scripts have queued actions.
+inline void InvokeScriptActions(Manager& manager) {
+	ScriptListeners::InvokePending(manager);
+}
+
+} // namespace impl
+
 } // namespace ptgn
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
+
 #include "core/ecs/entity.h"
 #include "core/input/key.h"
 #include "core/input/mouse.h"
@@ -31,6 +34,8 @@ enum class ScriptType {
 
 namespace impl {
 
+constexpr std::size_t script_type_count{ static_cast<std::size_t>(ScriptType::Tween) + 1 };
+
 class IScript {
 public:
 	Entity entity;
@@ -55,6 +60,25 @@ public:
 
 	constexpr virtual std::size_t GetHash() const = 0;
 
+	// @return Pointer to the interface of the given script type, or nullptr if the script does
+	// not implement it. Resolved from a table built for each script class, instead of a
+	// dynamic_cast.
+	virtual void* GetInterface(ScriptType type) = 0;
+
+	template <typename TInterface>
+	[[nodiscard]] TInterface* GetInterface() {
+		if constexpr (std::is_same_v<TInterface, IScript>) {
+			return this;
+		} else {
+			return static_cast<TInterface*>(GetInterface(TInterface::GetScriptType()));
+		}
+	}
+
+	template <typename TInterface>
+	[[nodiscard]] const TInterface* GetInterface() const {
+		return const_cast<IScript*>(this)->GetInterface<TInterface>();
+	}
+
 	constexpr static ScriptType GetScriptType() {
 		return ScriptType::Base;
 	}
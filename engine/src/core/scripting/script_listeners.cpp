@@ -0,0 +1,151 @@
+#include "core/scripting/script_listeners.h"
+
+#include <cstddef>
+#include <vector>
+
+#include "core/app/manager.h"
+#include "core/ecs/entity.h"
+#include "core/scripting/script.h"
+#include "core/scripting/script_interfaces.h"
+#include "debug/runtime/assert.h"
+
+namespace ptgn {
+
+namespace impl {
+
+ScriptListeners::ScriptListeners(const ScriptListeners&) {}
+
+ScriptListeners& ScriptListeners::operator=(const ScriptListeners& other) {
+	if (this != &other) {
+		Reset();
+	}
+	return *this;
+}
+
+ScriptListeners::ScriptListeners(ScriptListeners&&) noexcept {}
+
+ScriptListeners& ScriptListeners::operator=(ScriptListeners&& other) noexcept {
+	if (this != &other) {
+		Reset();
+	}
+	return *this;
+}
+
+const std::vector<Entity>& ScriptListeners::Get(Manager& manager, ScriptType type) {
+	if (outdated_) {
+		Rebuild(manager);
+	}
+	auto index{ static_cast<std::size_t>(type) };
+	PTGN_ASSERT(index < listeners_.size(), "Unrecognized script type");
+	auto& listeners{ listeners_[index] };
+	// Compacting once at least half of the entries are null keeps removal amortized constant.
+	if (listeners.removed * 2 > listeners.entities.size()) {
+		Compact(listeners);
+	}
+	return listeners.entities;
+}
+
+void ScriptListeners::Connect(Manager& manager) {
+	manager.OnConstruct<Scripts>().Connect<&ScriptListeners::Update>();
+	manager.OnDestruct<Scripts>().Connect<&ScriptListeners::Remove>();
+}
+
+void ScriptListeners::Update(Entity entity) {
+	Of(entity.GetManager()).Set(entity, entity.Has<Scripts>() ? &entity.Get<Scripts>() : nullptr);
+}
+
+void ScriptListeners::Remove(Entity entity) {
+	Of(entity.GetManager()).Set(entity, nullptr);
+}
+
+void ScriptListeners::Reset() {
+	outdated_ = true;
+	// The outer vector keeps its size so that references returned by Get remain valid.
+	for (auto& listeners : listeners_) {
+		listeners.entities.clear();
+		listeners.slots.clear();
+		listeners.removed = 0;
+	}
+	pending_.clear();
+}
+
+void ScriptListeners::AddPending(Entity entity) {
+	Of(entity.GetManager()).pending_.emplace_back(entity);
+}
+
+void ScriptListeners::InvokePending(Manager& manager) {
+	auto& pending{ Of(manager).pending_ };
+	while (!pending.empty()) {
+		// Actions may queue further actions, which are invoked in the next pass.
+		std::vector<Entity> entities;
+		entities.swap(pending);
+
+		for (auto entity : entities) {
+			if (entity.IsAlive() && entity.Has<Scripts>()) {
+				entity.Get<Scripts>().InvokeActions();
+			}
+		}
+
+		// Reuse the larger list so that steady state frames do not allocate.
+		entities.clear();
+		if (pending.empty()) {
+			pending.swap(entities);
+		}
+	}
+}
+
+ScriptListeners& ScriptListeners::Of(Manager& manager) {
+	return manager.script_listeners_;
+}
+
+void ScriptListeners::Set(const Entity& entity, const Scripts* scripts) {
+	// Outdated indices pick up the entity when they are rebuilt.
+	if (outdated_) {
+		return;
+	}
+	for (std::size_t i{ 0 }; i < listeners_.size(); ++i) {
+		auto& listeners{ listeners_[i] };
+		bool listening{ scripts != nullptr && scripts->HasScriptType(static_cast<ScriptType>(i)) };
+		auto it{ listeners.slots.find(entity) };
+		if (listening == (it != listeners.slots.end())) {
+			continue;
+		}
+		if (listening) {
+			listeners.slots.emplace(entity, listeners.entities.size());
+			listeners.entities.emplace_back(entity);
+		} else {
+			listeners.entities[it->second] = Entity{};
+			listeners.slots.erase(it);
+			++listeners.removed;
+		}
+	}
+}
+
+void ScriptListeners::Rebuild(Manager& manager) {
+	if (listeners_.empty()) {
+		listeners_.resize(script_type_count);
+	}
+	Reset();
+	outdated_ = false;
+
+	for (auto [entity, scripts] : manager.EntitiesWith<Scripts>()) {
+		Set(entity, &scripts);
+	}
+}
+
+void ScriptListeners::Compact(Listeners& listeners) {
+	std::size_t count{ 0 };
+	for (const auto& entity : listeners.entities) {
+		if (entity == Entity{}) {
+			continue;
+		}
+		listeners.slots.find(entity)->second = count;
+		listeners.entities[count++]			 = entity;
+	}
+	listeners.entities.resize(count);
+	listeners.removed = 0;
+}
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
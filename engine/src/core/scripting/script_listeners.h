@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "core/ecs/entity.h"
+
+namespace ptgn {
+
+class Manager;
+class Scripts;
+
+enum class ScriptType;
+
+namespace impl {
+
+// Per manager index of the entities whose scripts implement each script type, so that events are
+// only queued for the entities which listen to them. The index is updated when a scripts component
+// is constructed or destroyed, when scripts are added or removed using AddScript, TryAddScript or
+// RemoveScripts, and when an entity is deserialized. Entities with queued actions are also
+// tracked, so that invoking them does not visit every scripted entity.
+class ScriptListeners {
+public:
+	ScriptListeners() = default;
+	// Entities belong to the manager they were created in, so copies and moves start out empty and
+	// are rebuilt from the scripted entities of their manager on first use.
+	ScriptListeners(const ScriptListeners&);
+	ScriptListeners& operator=(const ScriptListeners&);
+	ScriptListeners(ScriptListeners&&) noexcept;
+	ScriptListeners& operator=(ScriptListeners&&) noexcept;
+	~ScriptListeners() = default;
+
+	// @return Entities of the manager with a script of the given type, in the order in which they
+	// started listening. Entities which stopped listening leave null entries until the list is
+	// compacted. The reference remains valid until the manager is destroyed.
+	[[nodiscard]] const std::vector<Entity>& Get(Manager& manager, ScriptType type);
+
+	// Connects the scripts component hooks which keep the index of the manager up to date.
+	static void Connect(Manager& manager);
+
+	// Updates the index of the entity's manager to match the script types of the entity's scripts.
+	static void Update(Entity entity);
+
+	// Discards the index so that it is rebuilt on first use. Used when the entities of the manager
+	// are replaced wholesale.
+	void Reset();
+
+	// Records that the entity's scripts have queued actions. Called by Scripts::AddAction when its
+	// queue stops being empty.
+	static void AddPending(Entity entity);
+
+	// Invokes the queued actions of every entity of the manager which queued actions since the
+	// previous call, including actions queued while invoking them.
+	static void InvokePending(Manager& manager);
+
+private:
+	struct Listeners {
+		std::vector<Entity> entities;
+
+		// Index of each listening entity within entities.
+		std::unordered_map<Entity, std::size_t> slots;
+
+		// Number of null entries left behind by entities which stopped listening.
+		std::size_t removed{ 0 };
+	};
+
+	static void Remove(Entity entity);
+
+	static ScriptListeners& Of(Manager& manager);
+
+	void Set(const Entity& entity, const Scripts* scripts);
+
+	void Rebuild(Manager& manager);
+
+	static void Compact(Listeners& listeners);
+
+	// Indexed by script type.
+	std::vector<Listeners> listeners_;
+
+	bool outdated_{ true };
+
+	// Entities whose scripts queued actions since they were last invoked. May contain duplicates
+	// and entities whose actions have since been invoked elsewhere.
+	std::vector<Entity> pending_;
+};
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
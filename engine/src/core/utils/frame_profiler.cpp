@@ -0,0 +1,250 @@
+#include "core/utils/frame_profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/app/game.h"
+#include "core/utils/file.h"
+#include "debug/runtime/assert.h"
+
+namespace ptgn {
+
+namespace impl {
+
+// Five seconds worth of frames at 60 frames per second.
+constexpr std::size_t default_frame_capacity{ 300 };
+
+constexpr std::string_view frame_scope_name{ "Frame" };
+
+static void WriteJsonString(std::ofstream& stream, std::string_view string) {
+	stream << '"';
+	for (char c : string) {
+		if (c == '"' || c == '\\') {
+			stream << '\\';
+		}
+		stream << c;
+	}
+	stream << '"';
+}
+
+FrameProfiler::FrameProfiler() {
+	frames_.resize(default_frame_capacity);
+}
+
+FrameProfiler::~FrameProfiler() = default;
+
+void FrameProfiler::Enable() {
+	enabled_ = true;
+}
+
+void FrameProfiler::Disable() {
+	enabled_ = false;
+}
+
+bool FrameProfiler::IsEnabled() const {
+	return enabled_;
+}
+
+void FrameProfiler::SetFrameCapacity(std::size_t frame_capacity) {
+	PTGN_ASSERT(frame_capacity > 0, "Frame profiler must keep at least one frame");
+	std::scoped_lock lock{ mutex_ };
+	frames_.clear();
+	frames_.resize(frame_capacity);
+	frame_count_ = 0;
+}
+
+std::size_t FrameProfiler::GetFrameCapacity() const {
+	std::scoped_lock lock{ mutex_ };
+	return frames_.size();
+}
+
+std::size_t FrameProfiler::GetFrameCount() const {
+	std::scoped_lock lock{ mutex_ };
+	return static_cast<std::size_t>(
+		std::min(frame_count_, static_cast<std::uint64_t>(frames_.size()))
+	);
+}
+
+void FrameProfiler::Clear() {
+	std::scoped_lock lock{ mutex_ };
+	for (auto& frame : frames_) {
+		frame.events.clear();
+	}
+	frame_count_ = 0;
+}
+
+std::int64_t FrameProfiler::Now() const {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			   std::chrono::steady_clock::now() - epoch_
+	)
+		.count();
+}
+
+FrameProfiler::ThreadBuffer& FrameProfiler::GetThreadBuffer() {
+	// Buffers are owned by the profiler so that events of exited threads can still be gathered.
+	thread_local ThreadBuffer* buffer{ nullptr };
+	if (buffer == nullptr) {
+		std::scoped_lock lock{ mutex_ };
+		auto& new_buffer{ thread_buffers_.emplace_back(std::make_unique<ThreadBuffer>()) };
+		new_buffer->id = static_cast<std::uint32_t>(thread_buffers_.size() - 1);
+		buffer		   = new_buffer.get();
+	}
+	return *buffer;
+}
+
+void FrameProfiler::BeginScope() {
+	++GetThreadBuffer().depth;
+}
+
+void FrameProfiler::EndScope(const char* name, std::int64_t start) {
+	auto end{ Now() };
+	auto& buffer{ GetThreadBuffer() };
+	PTGN_ASSERT(buffer.depth > 0, "Profile scope ended without being started");
+	--buffer.depth;
+	std::scoped_lock lock{ buffer.mutex };
+	buffer.events.emplace_back(ProfileEvent{ name, start, end - start, buffer.depth, buffer.id });
+}
+
+void FrameProfiler::BeginFrame() {
+	frame_start_ = -1;
+	if (!enabled_) {
+		return;
+	}
+	main_thread_ = GetThreadBuffer().id;
+	frame_start_ = Now();
+	BeginScope();
+}
+
+void FrameProfiler::EndFrame() {
+	if (frame_start_ < 0) {
+		return;
+	}
+	EndScope(frame_scope_name.data(), frame_start_);
+
+	std::scoped_lock lock{ mutex_ };
+	auto& frame{ frames_[static_cast<std::size_t>(frame_count_ % frames_.size())] };
+	frame.index = frame_count_;
+	frame.events.clear();
+	for (const auto& buffer : thread_buffers_) {
+		std::scoped_lock buffer_lock{ buffer->mutex };
+		frame.events.insert(frame.events.end(), buffer->events.begin(), buffer->events.end());
+		buffer->events.clear();
+	}
+	++frame_count_;
+}
+
+std::vector<ProfileScopeStats> FrameProfiler::GetScopeStats() const {
+	std::unordered_map<std::string_view, ProfileScopeStats> stats;
+	std::unordered_map<std::string_view, std::int64_t> frame_totals;
+
+	std::scoped_lock lock{ mutex_ };
+	auto count{ std::min(frame_count_, static_cast<std::uint64_t>(frames_.size())) };
+	for (std::size_t i{ 0 }; i < count; ++i) {
+		frame_totals.clear();
+		for (const auto& event : frames_[i].events) {
+			frame_totals[event.name] += event.duration;
+		}
+		for (const auto& [name, total] : frame_totals) {
+			double ms{ static_cast<double>(total) / 1'000'000.0 };
+			auto [it, inserted] = stats.try_emplace(name);
+			auto& scope{ it->second };
+			if (inserted) {
+				scope.name = name;
+				scope.min  = ms;
+				scope.max  = ms;
+			} else {
+				scope.min = std::min(scope.min, ms);
+				scope.max = std::max(scope.max, ms);
+			}
+			// Running sum, divided below.
+			scope.avg += ms;
+			++scope.frames;
+		}
+	}
+
+	std::vector<ProfileScopeStats> result;
+	result.reserve(stats.size());
+	for (auto& [name, scope] : stats) {
+		scope.avg /= static_cast<double>(scope.frames);
+		result.emplace_back(scope);
+	}
+	std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+		return a.avg > b.avg;
+	});
+	return result;
+}
+
+void FrameProfiler::ExportChromeTrace(const path& file) const {
+	std::ofstream stream{ file };
+	PTGN_ASSERT(stream.good(), "Failed to open file for writing the chrome trace: ", file.string());
+
+	std::scoped_lock lock{ mutex_ };
+
+	stream << "{\"traceEvents\":[";
+	bool first{ true };
+	const auto separate = [&]() {
+		if (!first) {
+			stream << ",";
+		}
+		first = false;
+	};
+
+	for (const auto& buffer : thread_buffers_) {
+		separate();
+		stream << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+			   << ",\"args\":{\"name\":";
+		WriteJsonString(
+			stream, buffer->id == main_thread_ ? "Main" : "Worker " + std::to_string(buffer->id)
+		);
+		stream << "}}";
+	}
+
+	stream.setf(std::ios::fixed);
+	stream.precision(3);
+
+	// Oldest frame first.
+	auto count{ std::min(frame_count_, static_cast<std::uint64_t>(frames_.size())) };
+	for (std::uint64_t i{ frame_count_ - count }; i < frame_count_; ++i) {
+		const auto& frame{ frames_[static_cast<std::size_t>(i % frames_.size())] };
+		for (const auto& event : frame.events) {
+			separate();
+			stream << "\n{\"name\":";
+			WriteJsonString(stream, event.name);
+			// Chrome trace timestamps are in microseconds.
+			stream << ",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":"
+				   << static_cast<double>(event.start) / 1000.0
+				   << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0
+				   << ",\"pid\":1,\"tid\":" << event.thread << ",\"args\":{\"frame\":"
+				   << frame.index << ",\"depth\":" << event.depth << "}}";
+		}
+	}
+	stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+ProfileScope::ProfileScope(const char* name) : name_{ name } {
+	if (!game.profiler.IsEnabled()) {
+		return;
+	}
+	game.profiler.BeginScope();
+	start_ = game.profiler.Now();
+}
+
+ProfileScope::~ProfileScope() {
+	if (start_ < 0) {
+		return;
+	}
+	game.profiler.EndScope(name_, start_);
+}
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
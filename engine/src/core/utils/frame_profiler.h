@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "core/utils/file.h"
+#include "debug/core/debug_config.h"
+
+// Scope markers are compiled in for debug builds. Define PTGN_FRAME_PROFILER to also keep them
+// in release builds, for instance to capture frame spikes in production.
+#if defined(PTGN_DEBUG) || defined(PTGN_FRAME_PROFILER)
+#define PTGN_FRAME_PROFILER_ENABLED
+#endif
+
+namespace ptgn {
+
+namespace impl {
+
+class Game;
+
+struct ProfileEvent {
+	// Points to a string literal, so events can be recorded without allocating.
+	const char* name{ nullptr };
+	// Nanoseconds since the profiler was constructed.
+	std::int64_t start{ 0 };
+	std::int64_t duration{ 0 };
+	// Number of scopes which enclose this one on the same thread.
+	std::uint32_t depth{ 0 };
+	std::uint32_t thread{ 0 };
+};
+
+struct ProfileScopeStats {
+	std::string_view name;
+	// Time spent in the scope per frame, summed over every call and thread. Unit: milliseconds.
+	double min{ 0.0 };
+	double avg{ 0.0 };
+	double max{ 0.0 };
+	// Number of recorded frames in which the scope was entered.
+	std::size_t frames{ 0 };
+};
+
+// Records nested, named timing scopes from any thread. Each thread appends to its own buffer,
+// which is gathered into a ring of the most recent frames at the end of every frame. Use the
+// PTGN_FRAME_SCOPE / PTGN_FRAME_FUNCTION macros to add scopes.
+class FrameProfiler {
+public:
+	FrameProfiler();
+	~FrameProfiler();
+	FrameProfiler(FrameProfiler&&)				   = delete;
+	FrameProfiler& operator=(FrameProfiler&&)	   = delete;
+	FrameProfiler(const FrameProfiler&)			   = delete;
+	FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+	// Scopes are only recorded while the profiler is enabled. Disabled by default.
+	void Enable();
+	void Disable();
+	[[nodiscard]] bool IsEnabled() const;
+
+	// Sets how many of the most recent frames are kept. Clears all recorded frames.
+	void SetFrameCapacity(std::size_t frame_capacity);
+	[[nodiscard]] std::size_t GetFrameCapacity() const;
+
+	// @return Number of frames currently kept, at most the frame capacity.
+	[[nodiscard]] std::size_t GetFrameCount() const;
+
+	// Clears all recorded frames.
+	void Clear();
+
+	// @return Rolling min / avg / max of every scope over the kept frames, slowest average first.
+	[[nodiscard]] std::vector<ProfileScopeStats> GetScopeStats() const;
+
+	// Writes the kept frames in the Chrome trace event format, which can be opened in
+	// chrome://tracing or https://ui.perfetto.dev.
+	void ExportChromeTrace(const path& file) const;
+
+	// Used by the profiling macros.
+	void BeginScope();
+	void EndScope(const char* name, std::int64_t start);
+
+	// @return Nanoseconds since the profiler was constructed.
+	[[nodiscard]] std::int64_t Now() const;
+
+private:
+	friend class Game;
+
+	struct ThreadBuffer {
+		std::mutex mutex;
+		std::vector<ProfileEvent> events;
+		std::uint32_t depth{ 0 };
+		std::uint32_t id{ 0 };
+	};
+
+	struct Frame {
+		std::uint64_t index{ 0 };
+		std::vector<ProfileEvent> events;
+	};
+
+	// Called by the game around each frame.
+	void BeginFrame();
+	void EndFrame();
+
+	[[nodiscard]] ThreadBuffer& GetThreadBuffer();
+
+	std::chrono::steady_clock::time_point epoch_{ std::chrono::steady_clock::now() };
+
+	std::atomic<bool> enabled_{ false };
+
+	// Guards thread_buffers_ and frames_.
+	mutable std::mutex mutex_;
+
+	std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_;
+
+	std::vector<Frame> frames_;
+
+	// Total number of frames gathered since the last Clear().
+	std::uint64_t frame_count_{ 0 };
+
+	std::uint32_t main_thread_{ 0 };
+
+	std::int64_t frame_start_{ 0 };
+};
+
+// Times the enclosing scope. Does nothing if the profiler is disabled when the scope is entered.
+class ProfileScope {
+public:
+	explicit ProfileScope(const char* name);
+	~ProfileScope();
+	ProfileScope(ProfileScope&&)				 = delete;
+	ProfileScope& operator=(ProfileScope&&)		 = delete;
+	ProfileScope(const ProfileScope&)			 = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	const char* name_{ nullptr };
+	std::int64_t start_{ -1 };
+};
+
+} // namespace impl
+
+} // namespace ptgn
+
+#define PTGN_FRAME_CONCAT_IMPL(a, b) a##b
+#define PTGN_FRAME_CONCAT(a, b)		 PTGN_FRAME_CONCAT_IMPL(a, b)
+
+#ifdef PTGN_FRAME_PROFILER_ENABLED
+
+// @param name String literal.
+#define PTGN_FRAME_SCOPE(name) \
+	ptgn::impl::ProfileScope PTGN_FRAME_CONCAT(ptgn_frame_scope_, __LINE__) { name }
+
+#define PTGN_FRAME_FUNCTION() PTGN_FRAME_SCOPE(__func__)
+
+#else
+
+#define PTGN_FRAME_SCOPE(name) ((void)0)
+#define PTGN_FRAME_FUNCTION()  ((void)0)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "core/utils/thread_pool.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include "debug/runtime/assert.h"
+
+namespace ptgn {
+
+namespace impl {
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+#ifdef __EMSCRIPTEN__
+	// Web builds are not compiled with thread support, so all work runs on the calling thread.
+	thread_count = 1;
+#endif
+	if (thread_count == 0) {
+		thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	workers_.reserve(thread_count - 1);
+	for (std::size_t thread{ 1 }; thread < thread_count; ++thread) {
+		workers_.emplace_back(&ThreadPool::WorkerLoop, this, thread);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::scoped_lock lock{ mutex_ };
+		stop_ = true;
+	}
+	work_available_.notify_all();
+	for (auto& worker : workers_) {
+		worker.join();
+	}
+}
+
+std::size_t ThreadPool::GetThreadCount() const {
+	return workers_.size() + 1;
+}
+
+void ThreadPool::ParallelFor(
+	std::size_t count, std::size_t min_chunk_size, const RangeFunction& func
+) {
+	if (count == 0) {
+		return;
+	}
+
+	std::size_t chunk_size{
+		std::max((count + GetThreadCount() - 1) / GetThreadCount(), std::max(min_chunk_size, std::size_t{ 1 }))
+	};
+
+	if (workers_.empty() || chunk_size >= count) {
+		func(0, count, 0);
+		return;
+	}
+
+	{
+		std::scoped_lock lock{ mutex_ };
+		PTGN_ASSERT(pending_workers_ == 0, "Thread pool work cannot be nested");
+		func_			 = &func;
+		count_			 = count;
+		chunk_size_		 = chunk_size;
+		pending_workers_ = workers_.size();
+		++generation_;
+	}
+	work_available_.notify_all();
+
+	func(0, std::min(chunk_size, count), 0);
+
+	std::unique_lock lock{ mutex_ };
+	work_finished_.wait(lock, [&]() { return pending_workers_ == 0; });
+	func_ = nullptr;
+}
+
+void ThreadPool::WorkerLoop(std::size_t thread) {
+	std::uint64_t generation{ 0 };
+	while (true) {
+		const RangeFunction* func{ nullptr };
+		std::size_t begin{ 0 };
+		std::size_t end{ 0 };
+		{
+			std::unique_lock lock{ mutex_ };
+			work_available_.wait(lock, [&]() { return stop_ || generation_ != generation; });
+			if (stop_) {
+				return;
+			}
+			generation = generation_;
+			func	   = func_;
+			begin	   = std::min(thread * chunk_size_, count_);
+			end		   = std::min(begin + chunk_size_, count_);
+		}
+
+		if (begin < end) {
+			(*func)(begin, end, thread);
+		}
+
+		{
+			std::scoped_lock lock{ mutex_ };
+			--pending_workers_;
+		}
+		work_finished_.notify_one();
+	}
+}
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
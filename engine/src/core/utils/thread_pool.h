@@ -0,0 +1,62 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ptgn {
+
+namespace impl {
+
+// Fixed set of worker threads which split ranges of work between themselves and the calling
+// thread. Work is only ever submitted from one thread at a time.
+class ThreadPool {
+public:
+	// Invoked with a half open range [begin, end) and the index of the thread executing it, which
+	// is in [0, GetThreadCount()). Index 0 is always the calling thread.
+	using RangeFunction = std::function<void(std::size_t begin, std::size_t end, std::size_t thread)>;
+
+	// @param thread_count Total number of threads which execute work, including the calling
+	// thread. 0 uses the hardware concurrency.
+	explicit ThreadPool(std::size_t thread_count = 0);
+	~ThreadPool();
+	ThreadPool(ThreadPool&&)				 = delete;
+	ThreadPool& operator=(ThreadPool&&)		 = delete;
+	ThreadPool(const ThreadPool&)			 = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// @return Number of threads which execute work, including the calling thread.
+	[[nodiscard]] std::size_t GetThreadCount() const;
+
+	// Splits [0, count) into contiguous chunks of at least min_chunk_size elements and executes
+	// them across the pool. Blocks until every chunk has finished. Each thread executes at most
+	// one chunk, so the partition only depends on count and the thread count.
+	void ParallelFor(std::size_t count, std::size_t min_chunk_size, const RangeFunction& func);
+
+private:
+	void WorkerLoop(std::size_t thread);
+
+	std::vector<std::thread> workers_;
+
+	std::mutex mutex_;
+	std::condition_variable work_available_;
+	std::condition_variable work_finished_;
+
+	// Work of the current ParallelFor() call.
+	const RangeFunction* func_{ nullptr };
+	std::size_t count_{ 0 };
+	std::size_t chunk_size_{ 0 };
+
+	// Incremented for every ParallelFor() call so workers can tell new work apart.
+	std::uint64_t generation_{ 0 };
+	std::size_t pending_workers_{ 0 };
+
+	bool stop_{ false };
+};
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "core/utils/thread_stats.h"
+
+#include "core/app/game.h"
+#include "debug/runtime/debug_system.h"
+#include "debug/runtime/stats.h"
+
+namespace ptgn {
+
+namespace impl {
+
+// Null while the thread increments game.debug.stats.
+static thread_local Stats* thread_stats{ nullptr };
+
+Stats& GetThreadStats() {
+	return thread_stats != nullptr ? *thread_stats : game.debug.stats;
+}
+
+ThreadStatsScope::ThreadStatsScope(Stats& stats) : previous_{ thread_stats } {
+	thread_stats = &stats;
+}
+
+ThreadStatsScope::~ThreadStatsScope() {
+	thread_stats = previous_;
+}
+
+void MergeGeometryStats(Stats& destination, const Stats& source) {
+	destination.intersect_circle_circle += source.intersect_circle_circle;
+	destination.intersect_circle_polygon += source.intersect_circle_polygon;
+	destination.intersect_circle_rect += source.intersect_circle_rect;
+	destination.intersect_polygon_polygon += source.intersect_polygon_polygon;
+	destination.intersect_rect_rect += source.intersect_rect_rect;
+	destination.overlap_capsule_capsule += source.overlap_capsule_capsule;
+	destination.overlap_circle_capsule += source.overlap_circle_capsule;
+	destination.overlap_circle_circle += source.overlap_circle_circle;
+	destination.overlap_circle_rect += source.overlap_circle_rect;
+	destination.overlap_line_capsule += source.overlap_line_capsule;
+	destination.overlap_line_circle += source.overlap_line_circle;
+	destination.overlap_line_line += source.overlap_line_line;
+	destination.overlap_line_rect += source.overlap_line_rect;
+	destination.overlap_point_capsule += source.overlap_point_capsule;
+	destination.overlap_point_circle += source.overlap_point_circle;
+	destination.overlap_point_line += source.overlap_point_line;
+	destination.overlap_point_polygon += source.overlap_point_polygon;
+	destination.overlap_point_rect += source.overlap_point_rect;
+	destination.overlap_point_triangle += source.overlap_point_triangle;
+	destination.overlap_polygon_polygon += source.overlap_polygon_polygon;
+	destination.overlap_rect_capsule += source.overlap_rect_capsule;
+	destination.overlap_rect_rect += source.overlap_rect_rect;
+	destination.overlap_triangle_capsule += source.overlap_triangle_capsule;
+	destination.overlap_triangle_rect += source.overlap_triangle_rect;
+	destination.raycast_circle_rect += source.raycast_circle_rect;
+	destination.raycast_line_capsule += source.raycast_line_capsule;
+	destination.raycast_line_circle += source.raycast_line_circle;
+	destination.raycast_line_line += source.raycast_line_line;
+	destination.raycast_line_rect += source.raycast_line_rect;
+	destination.raycast_rect_rect += source.raycast_rect_rect;
+}
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
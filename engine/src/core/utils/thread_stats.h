@@ -0,0 +1,33 @@
+#pragma once
+
+#include "debug/runtime/stats.h"
+
+namespace ptgn {
+
+namespace impl {
+
+// @return Debug counters which the calling thread increments. These are game.debug.stats unless
+// a ThreadStatsScope is active on the calling thread.
+[[nodiscard]] Stats& GetThreadStats();
+
+// Redirects the debug counters of the calling thread to stats while in scope, so that threads
+// running concurrently never increment the shared game.debug.stats.
+class ThreadStatsScope {
+public:
+	explicit ThreadStatsScope(Stats& stats);
+	~ThreadStatsScope();
+	ThreadStatsScope(ThreadStatsScope&&)				 = delete;
+	ThreadStatsScope& operator=(ThreadStatsScope&&)		 = delete;
+	ThreadStatsScope(const ThreadStatsScope&)			 = delete;
+	ThreadStatsScope& operator=(const ThreadStatsScope&) = delete;
+
+private:
+	Stats* previous_{ nullptr };
+};
+
+// Adds the overlap, intersect and raycast counters of source to destination.
+void MergeGeometryStats(Stats& destination, const Stats& source);
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
@@ -49,6 +49,6 @@ struct Arc {
 	PTGN_SERIALIZER_REGISTER_IGNORE_DEFAULTS(Arc, radius, start_angle, end_angle, clockwise)
 };
 
-PTGN_DRAWABLE_REGISTER(Arc);
+PTGN_DRAWABLE_REGISTER_CONCURRENT(Arc);
 
 } // namespace ptgn
\ No newline at end of file
@@ -49,6 +49,6 @@ struct Capsule {
 	PTGN_SERIALIZER_REGISTER_IGNORE_DEFAULTS(Capsule, start, end, radius)
 };
 
-PTGN_DRAWABLE_REGISTER(Capsule);
+PTGN_DRAWABLE_REGISTER_CONCURRENT(Capsule);
 
 } // namespace ptgn
\ No newline at end of file
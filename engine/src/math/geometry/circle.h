@@ -43,6 +43,6 @@ struct Circle {
 	PTGN_SERIALIZER_REGISTER_IGNORE_DEFAULTS(Circle, radius)
 };
 
-PTGN_DRAWABLE_REGISTER(Circle);
+PTGN_DRAWABLE_REGISTER_CONCURRENT(Circle);
 
 } // namespace ptgn
\ No newline at end of file
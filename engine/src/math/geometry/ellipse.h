@@ -45,6 +45,6 @@ struct Ellipse {
 	PTGN_SERIALIZER_REGISTER_IGNORE_DEFAULTS(Ellipse, radius)
 };
 
-PTGN_DRAWABLE_REGISTER(Ellipse);
+PTGN_DRAWABLE_REGISTER_CONCURRENT(Ellipse);
 
 } // namespace ptgn
\ No newline at end of file
@@ -43,6 +43,6 @@ struct Line {
 	PTGN_SERIALIZER_REGISTER_IGNORE_DEFAULTS(Line, start, end)
 };
 
-PTGN_DRAWABLE_REGISTER(Line);
+PTGN_DRAWABLE_REGISTER_CONCURRENT(Line);
 
 } // namespace ptgn
\ No newline at end of file
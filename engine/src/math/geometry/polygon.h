@@ -45,6 +45,6 @@ struct Polygon {
 	PTGN_SERIALIZER_REGISTER_IGNORE_DEFAULTS(Polygon, vertices)
 };
 
-PTGN_DRAWABLE_REGISTER(Polygon);
+PTGN_DRAWABLE_REGISTER_CONCURRENT(Polygon);
 
 } // namespace ptgn
\ No newline at end of file
@@ -63,6 +63,6 @@ struct Rect {
 	PTGN_SERIALIZER_REGISTER_IGNORE_DEFAULTS(Rect, min, max)
 };
 
-PTGN_DRAWABLE_REGISTER(Rect);
+PTGN_DRAWABLE_REGISTER_CONCURRENT(Rect);
 
 } // namespace ptgn
\ No newline at end of file
@@ -60,6 +60,6 @@ struct RoundedRect {
 	PTGN_SERIALIZER_REGISTER_IGNORE_DEFAULTS(RoundedRect, min, max, radius)
 };
 
-PTGN_DRAWABLE_REGISTER(RoundedRect);
+PTGN_DRAWABLE_REGISTER_CONCURRENT(RoundedRect);
 
 } // namespace ptgn
\ No newline at end of file
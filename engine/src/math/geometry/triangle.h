@@ -38,6 +38,6 @@ struct Triangle {
 	PTGN_SERIALIZER_REGISTER_IGNORE_DEFAULTS(Triangle, a, b, c)
 };
 
-PTGN_DRAWABLE_REGISTER(Triangle);
+PTGN_DRAWABLE_REGISTER_CONCURRENT(Triangle);
 
 } // namespace ptgn
\ No newline at end of file
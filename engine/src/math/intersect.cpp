@@ -9,6 +9,7 @@
 
 #include "core/app/game.h"
 #include "core/ecs/components/transform.h"
+#include "core/utils/thread_stats.h"
 #include "core/utils/type_info.h"
 #include "debug/core/debug_config.h"
 #include "debug/core/log.h"
@@ -74,13 +75,13 @@ Intersection IntersectCircleCircle(
 	// No overlap.
 	if (!impl::WithinPerimeter(r, dist2)) {
 #ifdef PTGN_DEBUG
-		game.debug.stats.overlap_circle_circle++;
+		impl::GetThreadStats().overlap_circle_circle++;
 #endif
 		return c;
 	}
 
 #ifdef PTGN_DEBUG
-	game.debug.stats.intersect_circle_circle++;
+	impl::GetThreadStats().intersect_circle_circle++;
 #endif
 
 	if (dist2 > epsilon<float> * epsilon<float>) {
@@ -107,7 +108,7 @@ Intersection IntersectCircleRect(
 	}
 
 #ifdef PTGN_DEBUG
-	game.debug.stats.intersect_circle_rect++;
+	impl::GetThreadStats().intersect_circle_rect++;
 #endif
 	// Source:
 	// https://steamcdn-a.akamaihd.net/apps/valve/2015/DirkGregorius_Contacts.pdf
@@ -164,7 +165,7 @@ Intersection IntersectCirclePolygon(
 ) {
 	Intersection c;
 #ifdef PTGN_DEBUG
-	game.debug.stats.intersect_circle_polygon++;
+	impl::GetThreadStats().intersect_circle_polygon++;
 #endif
 
 	float min_penetration{ std::numeric_limits<float>::infinity() };
@@ -219,7 +220,7 @@ Intersection IntersectRectRect(
 	}
 
 #ifdef PTGN_DEBUG
-	game.debug.stats.intersect_rect_rect++;
+	impl::GetThreadStats().intersect_rect_rect++;
 #endif
 
 	auto rectA_center{ A.GetCenter(t1) };
@@ -260,7 +261,7 @@ Intersection IntersectPolygonPolygon(
 	const Transform& t1, const Polygon& A, const Transform& t2, const Polygon& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.intersect_polygon_polygon++;
+	impl::GetThreadStats().intersect_polygon_polygon++;
 #endif
 
 	Polygon polygon_A{ A.GetWorldVertices(t1) };
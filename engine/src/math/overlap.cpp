@@ -9,6 +9,7 @@
 
 #include "core/app/game.h"
 #include "core/ecs/components/transform.h"
+#include "core/utils/thread_stats.h"
 #include "core/utils/type_info.h"
 #include "debug/core/debug_config.h"
 #include "debug/core/log.h"
@@ -267,7 +268,7 @@ bool OverlapPointPoint(
 
 bool OverlapPointLine(const Transform& t1, const V2_float& A, const Transform& t2, const Line& B) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_point_line++;
+	impl::GetThreadStats().overlap_point_line++;
 #endif
 	auto point{ t1.Apply(A) };
 	auto [line_start, line_end] = B.GetWorldVertices(t2);
@@ -299,7 +300,7 @@ bool OverlapPointTriangle(
 	const Transform& t1, const V2_float& A, const Transform& t2, const Triangle& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_point_triangle++;
+	impl::GetThreadStats().overlap_point_triangle++;
 #endif
 	auto point{ t1.Apply(A) };
 	auto [triangle_a, triangle_b, triangle_c] = B.GetWorldVertices(t2);
@@ -326,7 +327,7 @@ bool OverlapPointCircle(
 		return false;
 	}
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_point_circle++;
+	impl::GetThreadStats().overlap_point_circle++;
 #endif
 	auto point{ t1.Apply(A) };
 	auto circle_center{ B.GetCenter(t2) };
@@ -341,7 +342,7 @@ bool OverlapPointRect(const Transform& t1, const V2_float& A, const Transform& t
 		return false;
 	}
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_point_rect++;
+	impl::GetThreadStats().overlap_point_rect++;
 #endif
 	if (t2.GetRotation() != 0.0f) {
 		return OverlapPointPolygon(t1, A, t2, Polygon{ B.GetLocalVertices() });
@@ -381,7 +382,7 @@ bool OverlapPointCapsule(
 		return false;
 	}
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_point_capsule++;
+	impl::GetThreadStats().overlap_point_capsule++;
 #endif
 
 	auto point{ t1.Apply(A) };
@@ -399,7 +400,7 @@ bool OverlapPointPolygon(
 	const Transform& t1, const V2_float& A, const Transform& t2, const Polygon& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_point_polygon++;
+	impl::GetThreadStats().overlap_point_polygon++;
 #endif
 	auto point{ t1.Apply(A) };
 
@@ -425,7 +426,7 @@ bool OverlapPointPolygon(
 
 bool OverlapLineLine(const Transform& t1, const Line& A, const Transform& t2, const Line& B) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_line_line++;
+	impl::GetThreadStats().overlap_line_line++;
 #endif
 	auto [lineA_start, lineA_end] = A.GetWorldVertices(t1);
 	auto [lineB_start, lineB_end] = B.GetWorldVertices(t2);
@@ -493,7 +494,7 @@ bool OverlapLineCircle(const Transform& t1, const Line& A, const Transform& t2,
 		return false;
 	}
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_line_circle++;
+	impl::GetThreadStats().overlap_line_circle++;
 #endif
 	auto [line_start, line_end] = A.GetWorldVertices(t1);
 	// Source: https://www.baeldung.com/cs/circle-line-segment-collision-detection
@@ -554,7 +555,7 @@ bool OverlapLineRect(const Transform& t1, const Line& A, const Transform& t2, co
 	}
 
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_line_rect++;
+	impl::GetThreadStats().overlap_line_rect++;
 #endif
 	auto rect_center{ B.GetCenter(t2) };
 
@@ -601,7 +602,7 @@ bool OverlapLineCapsule(const Transform& t1, const Line& A, const Transform& t2,
 		return false;
 	}
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_line_capsule++;
+	impl::GetThreadStats().overlap_line_capsule++;
 #endif
 	auto [line_start, line_end]		  = A.GetWorldVertices(t1);
 	auto [capsule_start, capsule_end] = B.GetWorldVertices(t2);
@@ -644,7 +645,7 @@ bool OverlapCircleCircle(
 	const Transform& t1, const Circle& A, const Transform& t2, const Circle& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_circle_circle++;
+	impl::GetThreadStats().overlap_circle_circle++;
 #endif
 	auto circleA_center{ A.GetCenter(t1) };
 	auto circleB_center{ B.GetCenter(t2) };
@@ -685,7 +686,7 @@ bool OverlapCircleRect(const Transform& t1, const Circle& A, const Transform& t2
 		return OverlapCirclePolygon(t1, A, t2, Polygon{ B.GetLocalVertices() });
 	}
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_circle_rect++;
+	impl::GetThreadStats().overlap_circle_rect++;
 #endif
 	auto circle_center{ A.GetCenter(t1) };
 	auto rect_center{ B.GetCenter(t2) };
@@ -742,7 +743,7 @@ bool OverlapCircleCapsule(
 		return false;
 	}
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_circle_capsule++;
+	impl::GetThreadStats().overlap_circle_capsule++;
 #endif
 	auto circle_center{ A.GetCenter(t1) };
 	auto [capsule_start, capsule_end] = B.GetWorldVertices(t2);
@@ -781,7 +782,7 @@ bool OverlapTriangleRect(
 		return false;
 	}
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_triangle_rect++;
+	impl::GetThreadStats().overlap_triangle_rect++;
 #endif
 	return OverlapPolygonPolygon(
 		t1, Polygon{ A.GetLocalVertices() }, t2, Polygon{ B.GetLocalVertices() }
@@ -823,7 +824,7 @@ bool OverlapTriangleCapsule(
 	}
 
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_triangle_capsule++;
+	impl::GetThreadStats().overlap_triangle_capsule++;
 #endif
 
 	auto [capsule_start, capsule_end] = B.GetWorldVertices(t2);
@@ -853,7 +854,7 @@ bool OverlapRectRect(const Transform& t1, const Rect& A, const Transform& t2, co
 		);
 	}
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_rect_rect++;
+	impl::GetThreadStats().overlap_rect_rect++;
 #endif
 	auto rectA_size{ A.GetSize(t1) };
 	auto rectB_size{ B.GetSize(t2) };
@@ -900,7 +901,7 @@ bool OverlapRectCapsule(const Transform& t1, const Rect& A, const Transform& t2,
 	}
 
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_rect_capsule++;
+	impl::GetThreadStats().overlap_rect_capsule++;
 #endif
 	auto [capsule_start, capsule_end] = B.GetWorldVertices(t2);
 
@@ -968,7 +969,7 @@ bool OverlapCapsuleCapsule(
 	const Transform& t1, const Capsule& A, const Transform& t2, const Capsule& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_capsule_capsule++;
+	impl::GetThreadStats().overlap_capsule_capsule++;
 #endif
 	// Source:
 	// http://www.r-5.org/files/books/computers/algo-list/realtime-3d/Christer_Ericson-Real-Time_Collision_Detection-EN.pdf
@@ -996,7 +997,7 @@ bool OverlapPolygonPolygon(
 	const Transform& t1, const Polygon& A, const Transform& t2, const Polygon& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.overlap_polygon_polygon++;
+	impl::GetThreadStats().overlap_polygon_polygon++;
 #endif
 	PTGN_ASSERT(
 		impl::IsConvexPolygon(A.vertices.data(), A.vertices.size()),
@@ -11,6 +11,7 @@
 
 #include "core/app/game.h"
 #include "core/ecs/components/transform.h"
+#include "core/utils/thread_stats.h"
 #include "core/utils/type_info.h"
 #include "debug/core/debug_config.h"
 #include "debug/core/log.h"
@@ -71,7 +72,7 @@ RaycastResult RaycastLine(
 	const V2_float& ray_start, const V2_float& ray_end, const Transform& t2, const Line& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.raycast_line_line++;
+	impl::GetThreadStats().raycast_line_line++;
 #endif
 	// Source:
 	// https://stackoverflow.com/questions/563198/how-do-you-detect-where-two-line-segments-intersect/565282#565282
@@ -129,7 +130,7 @@ RaycastResult RaycastCircle(
 	const V2_float& ray_start, const V2_float& ray_end, const Transform& transform2, const Circle& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.raycast_line_circle++;
+	impl::GetThreadStats().raycast_line_circle++;
 #endif
 	// Source:
 	// https://stackoverflow.com/questions/1073336/circle-line-segment-collision-detection-algorithm/1084899#1084899
@@ -189,7 +190,7 @@ RaycastResult RaycastRect(
 	const V2_float& ray_start, const V2_float& ray_end, const Transform& transform2, const Rect& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.raycast_line_rect++;
+	impl::GetThreadStats().raycast_line_rect++;
 #endif
 	RaycastResult c;
 
@@ -342,7 +343,7 @@ RaycastResult RaycastCapsule(
 	const Capsule& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.raycast_line_capsule++;
+	impl::GetThreadStats().raycast_line_capsule++;
 #endif
 	// Source: https://stackoverflow.com/a/52462458
 
@@ -492,7 +493,7 @@ RaycastResult RaycastCircleRect(
 	const Rect& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.raycast_circle_rect++;
+	impl::GetThreadStats().raycast_circle_rect++;
 #endif
 	if (transform2.GetRotation() != 0.0f) {
 		return RaycastCirclePolygon(
@@ -593,7 +594,7 @@ RaycastResult RaycastRectRect(
 	const Rect& B
 ) {
 #ifdef PTGN_DEBUG
-	game.debug.stats.raycast_rect_rect++;
+	impl::GetThreadStats().raycast_rect_rect++;
 #endif
 	bool rotated1{ transform1.GetRotation() != 0.0f };
 	bool rotated2{ transform2.GetRotation() != 0.0f };
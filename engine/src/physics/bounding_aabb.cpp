@@ -1,7 +1,9 @@
 #include "physics/bounding_aabb.h"
 
 #include <algorithm>
+#include <limits>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -51,6 +53,83 @@ BoundingAABB BoundingAABB::ExpandByVelocity(const V2_float& velocity) const {
 	return expanded;
 }
 
+BoundingAABB BoundingAABB::Expand(float amount) const {
+	return BoundingAABB{ min - V2_float{ amount }, max + V2_float{ amount } };
+}
+
+bool BoundingAABB::Contains(const BoundingAABB& other) const {
+	return min.x <= other.min.x && min.y <= other.min.y && max.x >= other.max.x &&
+		   max.y >= other.max.y;
+}
+
+bool BoundingAABB::SweptOverlaps(const BoundingAABB& aabb, const V2_float& dir, float& t_entry)
+	const {
+	if (IsEmpty()) {
+		return false;
+	}
+
+	// Small margin keeps the pruning conservative with respect to the edge tolerances used by
+	// RaycastRect.
+	constexpr float margin{ 0.001f };
+
+	V2_float half{ aabb.GetSize() * 0.5f + V2_float{ margin } };
+	V2_float origin{ aabb.GetCenter() };
+	V2_float expanded_min{ min - half };
+	V2_float expanded_max{ max + half };
+
+	float t_min{ 0.0f };
+	float t_max{ 1.0f };
+
+	for (std::size_t axis{ 0 }; axis < 2; ++axis) {
+		if (dir[axis] == 0.0f) {
+			if (origin[axis] < expanded_min[axis] || origin[axis] > expanded_max[axis]) {
+				return false;
+			}
+			continue;
+		}
+		float inverse_dir{ 1.0f / dir[axis] };
+		float t1{ (expanded_min[axis] - origin[axis]) * inverse_dir };
+		float t2{ (expanded_max[axis] - origin[axis]) * inverse_dir };
+		if (t1 > t2) {
+			std::swap(t1, t2);
+		}
+		t_min = std::max(t_min, t1);
+		t_max = std::min(t_max, t2);
+		if (t_min > t_max) {
+			return false;
+		}
+	}
+
+	t_entry = t_min;
+	return true;
+}
+
+BoundingAABB BoundingAABB::Merge(const BoundingAABB& other) const {
+	return BoundingAABB{ V2_float{ std::min(min.x, other.min.x), std::min(min.y, other.min.y) },
+						 V2_float{ std::max(max.x, other.max.x), std::max(max.y, other.max.y) } };
+}
+
+V2_float BoundingAABB::GetCenter() const {
+	return (min + max) * 0.5f;
+}
+
+V2_float BoundingAABB::GetSize() const {
+	return max - min;
+}
+
+float BoundingAABB::GetPerimeter() const {
+	return 2.0f * ((max.x - min.x) + (max.y - min.y));
+}
+
+bool BoundingAABB::IsEmpty() const {
+	return min.x > max.x || min.y > max.y;
+}
+
+BoundingAABB BoundingAABB::Empty() {
+	constexpr float inf{ std::numeric_limits<float>::infinity() };
+	return BoundingAABB{ V2_float{ inf, inf }, V2_float{ -inf, -inf } };
+}
+
 BoundingAABB GetBoundingAABB(const ColliderShape& shape, const Transform& transform) {
 	auto world_vertices{ GetWorldVertices(shape, transform) };
 
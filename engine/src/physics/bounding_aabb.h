@@ -16,6 +16,37 @@ struct BoundingAABB {
 	[[nodiscard]] bool Overlaps(const V2_float& point) const;
 
 	[[nodiscard]] BoundingAABB ExpandByVelocity(const V2_float& velocity) const;
+
+	// @return Bounding box grown by amount in every direction.
+	[[nodiscard]] BoundingAABB Expand(float amount) const;
+
+	// @return True if other lies entirely inside of this bounding box.
+	[[nodiscard]] bool Contains(const BoundingAABB& other) const;
+
+	// Slab test of a ray from the center of aabb along dir against this bounding box expanded by
+	// the half size of aabb (Minkowski sum). This is equivalent to sweeping aabb along dir.
+	// @param t_entry Set to the fraction of dir at which the swept aabb first touches this box.
+	// @return True if the swept aabb touches this bounding box anywhere along t in [0, 1].
+	[[nodiscard]] bool SweptOverlaps(const BoundingAABB& aabb, const V2_float& dir, float& t_entry)
+		const;
+
+	// @return Smallest bounding box which contains both this and other.
+	[[nodiscard]] BoundingAABB Merge(const BoundingAABB& other) const;
+
+	[[nodiscard]] V2_float GetCenter() const;
+
+	[[nodiscard]] V2_float GetSize() const;
+
+	[[nodiscard]] float GetPerimeter() const;
+
+	// @return True if the bounding box has not been expanded to contain anything (min > max).
+	[[nodiscard]] bool IsEmpty() const;
+
+	// @return A bounding box which contains nothing and overlaps nothing. Merging any other
+	// bounding box into it returns the other bounding box.
+	[[nodiscard]] static BoundingAABB Empty();
+
+	bool operator==(const BoundingAABB&) const = default;
 };
 
 // @return Axis aligned bounding box which contains the given shape (fully surrounding it).
@@ -1,12 +1,14 @@
 #include "physics/broadphase.h"
 
 #include <algorithm>
-#include <memory>
+#include <array>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
 #include "core/ecs/components/transform.h"
 #include "core/ecs/entity.h"
+#include "debug/runtime/assert.h"
 #include "math/geometry/rect.h"
 #include "math/raycast.h"
 #include "math/vector2.h"
@@ -22,116 +24,259 @@ float KDObject::GetCenter(KDAxis axis) const {
 	return center;
 }
 
+std::vector<Entity> Broadphase::Raycast(
+	const Entity& entity, const V2_float& dir, const BoundingAABB& aabb
+) const {
+	std::vector<Entity> hits;
+	Raycast(entity, dir, aabb, hits);
+	return hits;
+}
+
 KDTree::KDTree(std::size_t max_objects_per_node, float rebuild_threshold) :
-	max_objects_per_node{ max_objects_per_node }, rebuild_threshold{ rebuild_threshold } {}
+	max_objects_per_node_{ max_objects_per_node }, rebuild_threshold_{ rebuild_threshold } {
+	PTGN_ASSERT(max_objects_per_node_ > 0, "KD-tree leaves must be able to hold objects");
+}
 
 void KDTree::Build(const std::vector<KDObject>& objects) {
-	entity_map.clear();
-	std::vector<KDObject> objs = objects; // copy
-	for (const auto& o : objs) {
-		entity_map[o.entity] = o;
+	++stamp_;
+
+	// Existing entries are reused so that rebuilding the same set of entities does not allocate.
+	for (const auto& o : objects) {
+		auto& entry{ entity_map_[o.entity] };
+		entry.aabb	  = o.aabb;
+		entry.stamp	  = stamp_;
+		entry.dirty	  = false;
+		entry.removed = false;
 	}
-	root = BuildRecursive(objs, 0);
-	moved_entities.clear();
+
+	std::erase_if(entity_map_, [&](const auto& pair) { return pair.second.stamp != stamp_; });
+
+	dirty_.clear();
+	removed_count_ = 0;
+
+	Rebuild();
 }
 
 void KDTree::UpdateBoundingAABB(const Entity& e, const BoundingAABB& aabb) {
-	auto it = entity_map.find(e);
-	if (it != entity_map.end()) {
-		it->second.aabb = aabb; // update map (source of truth)
-		moved_entities.insert(e);
-	} else {
-		// new entity; treat as inserted
-		KDObject o{ e, aabb, false };
-		entity_map[e] = o;
-		moved_entities.insert(e);
-	}
+	auto& entry{ entity_map_[e] };
+	if (entry.removed) {
+		// Removed and re-added during the same frame.
+		entry.removed = false;
+		--removed_count_;
+	}
+	entry.aabb	= aabb; // update map (source of truth)
+	entry.stamp = stamp_;
+	MarkDirty(e, entry);
 }
 
 void KDTree::Insert(const Entity& e, const BoundingAABB& aabb) {
-	KDObject o{ e, aabb, false };
-	entity_map[e] = o;
-	moved_entities.insert(e);
+	// New entries have no object index, so EndFrameUpdate() will treat them as insertions.
+	UpdateBoundingAABB(e, aabb);
 }
 
 void KDTree::Remove(const Entity& e) {
-	entity_map.erase(e);
-	// mark so partial update will remove it if applicable
-	moved_entities.insert(e);
+	auto it{ entity_map_.find(e) };
+	if (it == entity_map_.end()) {
+		return;
+	}
+	auto& entry{ it->second };
+	if (!entry.removed) {
+		entry.removed = true;
+		++removed_count_;
+	}
+	MarkDirty(e, entry);
 }
 
-void KDTree::EndFrameUpdate() {
-	std::size_t moved = moved_entities.size();
-	std::size_t total = entity_map.size();
+void KDTree::MarkDirty(const Entity& e, Entry& entry) {
+	if (entry.dirty) {
+		return;
+	}
+	entry.dirty = true;
+	dirty_.emplace_back(e);
+}
 
-	if (moved == 0) {
+void KDTree::EndFrameUpdate() {
+	if (dirty_.empty()) {
 		return;
 	}
 
-	if (total == 0) {
+	std::size_t moved{ 0 };
+	std::size_t inserted{ 0 };
+	std::size_t removed{ 0 };
+
+	for (const auto& e : dirty_) {
+		auto it{ entity_map_.find(e) };
+		PTGN_ASSERT(it != entity_map_.end(), "Dirty KD-tree entity must have an entry");
+		const auto& entry{ it->second };
+		if (entry.removed) {
+			removed += entry.index != invalid_index_ ? 1 : 0;
+		} else if (entry.index == invalid_index_) {
+			++inserted;
+		} else {
+			++moved;
+		}
+	}
+
+	std::size_t total{ entity_map_.size() - removed_count_ };
+
+	std::size_t threshold{
+		std::max<std::size_t>(1, static_cast<std::size_t>(rebuild_threshold_ * total))
+	};
+
+	std::size_t pending{ objects_.size() - tree_object_count_ + inserted };
+
+	// If too many changed, rebuild fully from entity_map_ (fast, cache-friendly). Insertions are
+	// kept in a linearly tested pending list which must stay small, and deleted objects waste
+	// space in the leaves, so both of these also trigger a rebuild once they accumulate.
+	bool rebuild{ nodes_.empty() || moved + inserted + removed >= threshold ||
+				  pending > max_objects_per_node_ || deleted_count_ + removed >= threshold };
+
+	for (const auto& e : dirty_) {
+		auto it{ entity_map_.find(e) };
+		auto& entry{ it->second };
+		entry.dirty = false;
+		if (entry.removed) {
+			if (entry.index != invalid_index_) {
+				objects_[entry.index].deleted = true;
+				++deleted_count_;
+			}
+			entity_map_.erase(it);
+			continue;
+		}
+		if (rebuild) {
+			continue;
+		}
+		if (entry.index == invalid_index_) {
+			entry.index = static_cast<std::uint32_t>(objects_.size());
+			objects_.push_back({ e, entry.aabb, false });
+		} else {
+			objects_[entry.index].aabb = entry.aabb;
+		}
+	}
+
+	dirty_.clear();
+	removed_count_ = 0;
+
+	if (entity_map_.empty()) {
 		// nothing to do
-		root.reset();
-		moved_entities.clear();
+		nodes_.clear();
+		objects_.clear();
+		tree_object_count_ = 0;
+		deleted_count_	   = 0;
 		return;
 	}
 
-	// If too many changed, rebuild fully from entity_map (fast, cache-friendly)
-	if (moved >= std::max<std::size_t>(1, static_cast<std::size_t>(rebuild_threshold * total))) {
-		std::vector<KDObject> all;
-		all.reserve(entity_map.size());
-		for (const auto& kv : entity_map) {
-			all.push_back(kv.second);
+	if (rebuild) {
+		Rebuild();
+		++stats_.rebuilds;
+	} else {
+		// Otherwise, the moved objects were updated in place, so only the node bounds need to be
+		// refit.
+		RefitBounds();
+		++stats_.refits;
+	}
+}
+
+void KDTree::Update(const std::vector<KDObject>& objects) {
+	++stamp_;
+
+	for (const auto& object : objects) {
+		auto it{ entity_map_.find(object.entity) };
+		if (it != entity_map_.end() && !it->second.removed && it->second.aabb == object.aabb) {
+			it->second.stamp = stamp_;
+			continue;
+		}
+		UpdateBoundingAABB(object.entity, object.aabb);
+	}
+
+	// Every entity in the tree was provided, so nothing needs to be removed.
+	if (objects.size() != entity_map_.size() - removed_count_) {
+		for (auto& [e, entry] : entity_map_) {
+			if (entry.stamp != stamp_ && !entry.removed) {
+				entry.removed = true;
+				++removed_count_;
+				MarkDirty(e, entry);
+			}
 		}
-		root = BuildRecursive(all, 0);
-		moved_entities.clear();
-		return;
 	}
 
-	// Otherwise, do a partial update (bulk remove + bulk insert)
-	PartialUpdate();
+	EndFrameUpdate();
+}
 
-	CompactTree(root.get());
+const BroadphaseStats& KDTree::GetStats() const {
+	return stats_;
+}
 
-	moved_entities.clear();
+void KDTree::ResetStats() {
+	stats_ = {};
+}
+
+void KDTree::FindPairs(std::vector<BroadphasePair>& pairs) const {
+	pairs.clear();
+	for (std::size_t i{ 0 }; i < objects_.size(); ++i) {
+		const auto& obj{ objects_[i] };
+		if (obj.deleted) {
+			continue;
+		}
+		Traverse(
+			[&](const BoundingAABB& bounds) { return bounds.Overlaps(obj.aabb); },
+			[&](const KDObject& other) {
+				// Only report each pair from the object which comes first in objects_.
+				if (&other > &obj && other.aabb.Overlaps(obj.aabb)) {
+					pairs.push_back({ obj.entity, other.entity });
+				}
+			}
+		);
+	}
 }
 
 std::vector<Entity> KDTree::Query(const BoundingAABB& region) const {
 	std::vector<Entity> result;
-	Traverse(root.get(), [&](const KDObject& obj) {
-		if (obj.aabb.Overlaps(region)) {
-			result.emplace_back(obj.entity);
+	Traverse(
+		[&](const BoundingAABB& bounds) { return bounds.Overlaps(region); },
+		[&](const KDObject& obj) {
+			if (obj.aabb.Overlaps(region)) {
+				result.emplace_back(obj.entity);
+			}
 		}
-	});
+	);
 	return result;
 }
 
 std::vector<Entity> KDTree::Query(const V2_float& point) const {
 	std::vector<Entity> result;
-	Traverse(root.get(), [&](const KDObject& obj) {
-		if (obj.aabb.Overlaps(point)) {
-			result.emplace_back(obj.entity);
+	Traverse(
+		[&](const BoundingAABB& bounds) { return bounds.Overlaps(point); },
+		[&](const KDObject& obj) {
+			if (obj.aabb.Overlaps(point)) {
+				result.emplace_back(obj.entity);
+			}
 		}
-	});
+	);
 	return result;
 }
 
-std::vector<Entity> KDTree::Raycast(
-	const Entity& entity, const V2_float& dir, const BoundingAABB& aabb
+void KDTree::Raycast(
+	const Entity& entity, const V2_float& dir, const BoundingAABB& aabb, std::vector<Entity>& hits
 ) const {
-	std::vector<Entity> hits;
 	Rect rect{ aabb.min, aabb.max };
-	Traverse(root.get(), [&](const KDObject& obj) {
-		if (obj.entity == entity) {
-			return;
-		}
-		auto raycast{
-			RaycastRectRect(dir, Transform{}, rect, Transform{}, Rect{ obj.aabb.min, obj.aabb.max })
-		};
-		if (raycast.Occurred()) {
-			hits.emplace_back(obj.entity);
+	Traverse(
+		[&](const BoundingAABB& bounds) {
+			float t_entry{ 0.0f };
+			return bounds.SweptOverlaps(aabb, dir, t_entry);
+		},
+		[&](const KDObject& obj) {
+			if (obj.entity == entity) {
+				return;
+			}
+			auto raycast{ RaycastRectRect(
+				dir, Transform{}, rect, Transform{}, Rect{ obj.aabb.min, obj.aabb.max }
+			) };
+			if (raycast.Occurred()) {
+				hits.emplace_back(obj.entity);
+			}
 		}
-	});
-	return hits;
+	);
 }
 
 Entity KDTree::RaycastFirst(const Entity& entity, const V2_float& dir, const BoundingAABB& aabb)
@@ -139,8 +284,9 @@ Entity KDTree::RaycastFirst(const Entity& entity, const V2_float& dir, const Bou
 	Entity closest_hit;
 	float closest_t{ 1.0f };
 	Rect rect{ aabb.min, aabb.max };
-	Traverse(root.get(), [&](const KDObject& obj) {
-		if (obj.entity == entity) {
+
+	const auto raycast_object = [&](const KDObject& obj) {
+		if (obj.deleted || obj.entity == entity) {
 			return;
 		}
 		auto raycast{
@@ -150,256 +296,147 @@ Entity KDTree::RaycastFirst(const Entity& entity, const V2_float& dir, const Bou
 			closest_t	= raycast.t;
 			closest_hit = obj.entity;
 		}
-	});
-	return closest_hit;
-}
-
-std::unique_ptr<KDNode> KDTree::BuildRecursive(const std::vector<KDObject>& objects, int depth) {
-	if (objects.empty()) {
-		return nullptr;
-	}
-	auto node{ std::make_unique<KDNode>() };
-	// Alternate split axis each time the KD-tree splits.
-	node->split_axis = static_cast<KDAxis>(depth % 2);
-
-	// Stop splitting if the KDNode can hold the remaining objects.
-	if (objects.size() <= max_objects_per_node) {
-		node->objects = objects;
-		return node;
-	}
-
-	// Get the centers of all the KDObjects.
-	std::vector<float> centers(objects.size());
-	for (std::size_t i{ 0 }; i < objects.size(); ++i) {
-		centers[i] = objects[i].GetCenter(node->split_axis);
-	}
-
-	std::size_t mid{ centers.size() / 2 };
-	// Every center below mid index is smaller than mid center, everything above is larger, but
-	// not completely sorting the centers (faster).
-	std::nth_element(centers.begin(), centers.begin() + mid, centers.end());
-	node->split_value = centers[mid];
-
-	std::vector<KDObject> left_objs, right_objs;
-	left_objs.reserve(objects.size() / 2);
-	right_objs.reserve(objects.size() / 2);
-
-	// Split objects array into two based on median center. This is "repeated" after nth_element
-	// because that only does it for the centers vector, not the objects themselves.
-	for (const auto& obj : objects) {
-		float center{ obj.GetCenter(node->split_axis) };
-		if (center < node->split_value) {
-			left_objs.push_back(obj);
-		} else {
-			right_objs.push_back(obj);
+	};
+
+	float t_root{ 0.0f };
+
+	if (!nodes_.empty() && nodes_[0].bounds.SweptOverlaps(aabb, dir, t_root)) {
+		// Node indices paired with the fraction of dir at which the sweep enters them.
+		std::array<std::pair<std::uint32_t, float>, max_depth_> stack;
+		std::size_t size{ 0 };
+		stack[size++] = { 0, t_root };
+
+		while (size > 0) {
+			auto [index, t_entry] = stack[--size];
+			// Subtrees which the sweep reaches after the closest hit so far cannot contain a
+			// closer hit.
+			if (t_entry >= closest_t) {
+				continue;
+			}
+			const KDNode& node{ nodes_[index] };
+			if (node.IsLeaf()) {
+				for (std::uint32_t i{ node.first }; i < node.first + node.count; ++i) {
+					raycast_object(objects_[i]);
+				}
+				continue;
+			}
+			std::uint32_t left{ index + 1 };
+			float t_left{ 0.0f };
+			float t_right{ 0.0f };
+			bool hit_left{ nodes_[left].bounds.SweptOverlaps(aabb, dir, t_left) };
+			bool hit_right{ nodes_[node.right].bounds.SweptOverlaps(aabb, dir, t_right) };
+			// Push the child which the sweep reaches last first, so that the nearer child is
+			// visited first and closest_t shrinks as early as possible.
+			if (hit_left && hit_right && t_right < t_left) {
+				stack[size++] = { left, t_left };
+				stack[size++] = { node.right, t_right };
+			} else {
+				if (hit_right) {
+					stack[size++] = { node.right, t_right };
+				}
+				if (hit_left) {
+					stack[size++] = { left, t_left };
+				}
+			}
 		}
 	}
 
-	if (left_objs.empty() || right_objs.empty()) {
-		node->objects = objects;
-		return node;
+	for (std::size_t i{ tree_object_count_ }; i < objects_.size(); ++i) {
+		raycast_object(objects_[i]);
 	}
 
-	node->left	= BuildRecursive(left_objs, depth + 1);
-	node->right = BuildRecursive(right_objs, depth + 1);
-
-	return node;
+	return closest_hit;
 }
 
-void KDTree::PartialUpdate() {
-	if (!root) {
-		// No existing tree; build from scratch from entity_map
-		std::vector<KDObject> all;
-		all.reserve(entity_map.size());
-		for (const auto& kv : entity_map) {
-			all.push_back(kv.second);
-		}
-		root = BuildRecursive(all, 0);
-		return;
-	}
+void KDTree::Rebuild() {
+	nodes_.clear();
+	objects_.clear();
+	deleted_count_ = 0;
 
-	// 1) Mark/removal step: for each moved entity, try to find it in the tree and remove by
-	// swap-pop. We'll also record which leaves were touched so we can later split them if
-	// needed.
-	std::vector<KDNode*> touched_leaves;
-	touched_leaves.reserve(moved_entities.size());
-
-	for (Entity e : moved_entities) {
-		// if entity isn't present in the tree (inserted this frame), skip removal
-		// We'll insert it below from entity_map
-		bool found_and_removed = RemoveFromTree(root.get(), e, 0, touched_leaves);
-		(void)found_and_removed; // fine if not found
+	// Capacity of both arrays is retained between rebuilds.
+	objects_.reserve(entity_map_.size());
+	for (const auto& [e, entry] : entity_map_) {
+		PTGN_ASSERT(!entry.removed);
+		objects_.push_back({ e, entry.aabb, false });
 	}
 
-	// 2) Bulk-insert: gather moved objects from entity_map and insert into leaves without
-	// splitting yet We insert directly into leaves to avoid repeated traversals doing node
-	// splitting mid-flight.
-	for (Entity e : moved_entities) {
-		auto it = entity_map.find(e);
-		if (it == entity_map.end()) {
-			continue; // removed completely by user
-		}
-		InsertIntoLeaf(root.get(), it->second, 0);
-	}
+	tree_object_count_ = objects_.size();
 
-	// 3) Split all touched leaves (and recursively if children need splitting)
-	// We deduplicate touched leaves
-	std::ranges::sort(touched_leaves);
-	touched_leaves.erase(
-		std::unique(touched_leaves.begin(), touched_leaves.end()), touched_leaves.end()
-	);
-
-	for (KDNode* leaf : touched_leaves) {
-		// if leaf still exists and is over capacity, split it
-		if (leaf && leaf->objects.size() > max_objects_per_node) {
-			// We need to call SplitNode with a depth. We don't store depths in nodes, so we
-			// compute it by walking from root.
-			int depth = ComputeDepth(root.get(), leaf, 0);
-			if (depth >= 0) {
-				SplitNodeExternal(leaf, depth);
-			}
-		}
+	if (objects_.empty()) {
+		return;
 	}
-}
 
-bool KDTree::RemoveFromTree(
-	KDNode* node, Entity e, int depth, std::vector<KDNode*>& touched_leaves
-) {
-	if (!node) {
-		return false;
-	}
+	nodes_.reserve(2 * (objects_.size() / max_objects_per_node_) + 1);
 
-	// If leaf, search its vector and mark deleted if found
-	if (!node->left && !node->right) {
-		auto& vec = node->objects;
-		for (std::size_t i = 0; i < vec.size(); ++i) {
-			if (vec[i].entity == e) {
-				vec[i].deleted = true; // Lazy delete
-				touched_leaves.push_back(node);
-				return true;
-			}
-		}
-		return false;
-	}
+	BuildRecursive(0, static_cast<std::uint32_t>(objects_.size()), 0);
 
-	// Continue traversal
-	auto it = entity_map.find(e);
-	if (it == entity_map.end()) {
-		return false;
-	}
-	float val = it->second.GetCenter(node->split_axis);
-	if (val < node->split_value) {
-		return RemoveFromTree(node->left.get(), e, depth + 1, touched_leaves);
-	} else {
-		return RemoveFromTree(node->right.get(), e, depth + 1, touched_leaves);
+	for (std::uint32_t i{ 0 }; i < objects_.size(); ++i) {
+		auto it{ entity_map_.find(objects_[i].entity) };
+		PTGN_ASSERT(it != entity_map_.end());
+		it->second.index = i;
 	}
 }
 
-void KDTree::CompactTree(KDNode* node) {
-	if (!node) {
-		return;
-	}
-	if (!node->left && !node->right) {
-		auto& vec = node->objects;
-		vec.erase(
-			std::remove_if(vec.begin(), vec.end(), [](const KDObject& o) { return o.deleted; }),
-			vec.end()
-		);
-	} else {
-		CompactTree(node->left.get());
-		CompactTree(node->right.get());
-	}
-}
+std::uint32_t KDTree::BuildRecursive(std::uint32_t first, std::uint32_t count, int depth) {
+	auto index{ static_cast<std::uint32_t>(nodes_.size()) };
+	// Alternate split axis each time the KD-tree splits.
+	KDAxis axis{ static_cast<KDAxis>(depth % 2) };
 
-void KDTree::InsertIntoLeaf(KDNode* node, const KDObject& obj, int depth) {
-	if (!node) {
-		// This shouldn't normally happen as tree exists; if it does, create a small node on the
-		// heap.
-		return;
-	}
-	if (!node->left && !node->right) {
-		node->objects.push_back({ obj.entity, obj.aabb, false });
-		return;
+	BoundingAABB bounds{ BoundingAABB::Empty() };
+	for (std::uint32_t i{ first }; i < first + count; ++i) {
+		bounds = bounds.Merge(objects_[i].aabb);
 	}
-	float val{ obj.GetCenter(node->split_axis) };
-	if (val < node->split_value) {
-		InsertIntoLeaf(node->left.get(), obj, depth + 1);
-	} else {
-		InsertIntoLeaf(node->right.get(), obj, depth + 1);
-	}
-}
 
-int KDTree::ComputeDepth(KDNode* current, KDNode* target, int depth) {
-	if (!current) {
-		return -1;
-	}
-	if (current == target) {
-		return depth;
-	}
-	int d = ComputeDepth(current->left.get(), target, depth + 1);
-	if (d >= 0) {
-		return d;
-	}
-	return ComputeDepth(current->right.get(), target, depth + 1);
-}
+	// Not kept as a reference because the recursive calls below may reallocate nodes_.
+	KDNode node;
+	node.split_axis = axis;
+	node.bounds		= bounds;
+	node.first		= first;
+	node.count		= count;
+	nodes_.push_back(node);
 
-void KDTree::SplitNodeExternal(KDNode* node, int depth) {
-	if (!node) {
-		return;
-	}
-	// If node already has children, do nothing
-	if (node->left || node->right) {
-		return;
+	// Stop splitting if the KDNode can hold the remaining objects.
+	if (count <= max_objects_per_node_) {
+		return index;
 	}
 
-	node->split_axis = static_cast<KDAxis>(depth % 2);
-	std::vector<float> centers;
-	centers.reserve(node->objects.size());
-	for (const auto& o : node->objects) {
-		centers.push_back(o.GetCenter(node->split_axis));
-	}
+	std::uint32_t mid{ first + count / 2 };
 
-	if (centers.empty()) {
-		return;
-	}
+	// Every object before mid has a smaller center than the mid object, everything after has a
+	// larger one, without completely sorting the objects (faster). This partitions the object
+	// range in place, so each child covers a contiguous half of it.
+	auto begin{ objects_.begin() + first };
+	std::nth_element(
+		begin, objects_.begin() + mid, begin + count,
+		[axis](const KDObject& a, const KDObject& b) {
+			return a.GetCenter(axis) < b.GetCenter(axis);
+		}
+	);
 
-	bool all_same{ std::all_of(centers.begin(), centers.end(), [&](float v) {
-		return v == centers[0];
-	}) };
+	nodes_[index].split_value = objects_[mid].GetCenter(axis);
 
-	if (all_same) {
-		return;
-	}
+	// Left child immediately follows its parent.
+	BuildRecursive(first, mid - first, depth + 1);
+	std::uint32_t right{ BuildRecursive(mid, first + count - mid, depth + 1) };
+	nodes_[index].right = right;
 
-	std::size_t mid = centers.size() / 2;
-	std::nth_element(centers.begin(), centers.begin() + mid, centers.end());
-	node->split_value = centers[mid];
-
-	// Move objects into left/right
-	std::vector<KDObject> old = std::move(node->objects);
-	node->objects.clear();
-	for (const auto& o : old) {
-		float v = o.GetCenter(node->split_axis);
-		if (v < node->split_value) {
-			if (!node->left) {
-				node->left = std::make_unique<KDNode>();
-			}
-			node->left->objects.push_back(o);
-		} else {
-			if (!node->right) {
-				node->right = std::make_unique<KDNode>();
+	return index;
+}
+
+void KDTree::RefitBounds() {
+	for (std::size_t i{ nodes_.size() }; i-- > 0;) {
+		KDNode& node{ nodes_[i] };
+		if (!node.IsLeaf()) {
+			node.bounds = nodes_[i + 1].bounds.Merge(nodes_[node.right].bounds);
+			continue;
+		}
+		node.bounds = BoundingAABB::Empty();
+		for (std::uint32_t j{ node.first }; j < node.first + node.count; ++j) {
+			if (!objects_[j].deleted) {
+				node.bounds = node.bounds.Merge(objects_[j].aabb);
 			}
-			node->right->objects.push_back(o);
 		}
 	}
-
-	// Recursively split children if they are still oversized
-	if (node->left && node->left->objects.size() > max_objects_per_node) {
-		SplitNodeExternal(node->left.get(), depth + 1);
-	}
-	if (node->right && node->right->objects.size() > max_objects_per_node) {
-		SplitNodeExternal(node->right.get(), depth + 1);
-	}
 }
 
 } // namespace impl
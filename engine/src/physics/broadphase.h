@@ -1,8 +1,9 @@
 #pragma once
 
-#include <memory>
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "core/ecs/entity.h"
@@ -21,124 +22,256 @@ enum class KDAxis {
 struct KDObject {
 	Entity entity;
 	BoundingAABB aabb;
-	// "deleted" flag for lazy removals used inside partial updates
+	// "deleted" flag for lazy removals, cleared by the next rebuild.
 	bool deleted{ false };
 
 	[[nodiscard]] float GetCenter(KDAxis axis) const;
 };
 
+// Nodes are stored in preorder inside a single array: the left child of an internal node is
+// always the next node in the array, so only the right child index needs to be stored.
 struct KDNode {
 	KDAxis split_axis{ KDAxis::X };
 	float split_value{ 0.0f };
 
-	std::vector<KDObject> objects; // only populated on leaves
-	std::unique_ptr<KDNode> left;
-	std::unique_ptr<KDNode> right;
+	// Bounds of every object stored in this node's subtree. Used to prune queries.
+	BoundingAABB bounds{ BoundingAABB::Empty() };
+
+	// Index of the right child in the node array. 0 for leaves (the root can never be a child).
+	std::uint32_t right{ 0 };
+
+	// Range of the subtree's objects inside the object array. Objects of every subtree are
+	// contiguous because the build partitions the object array in place.
+	std::uint32_t first{ 0 };
+	std::uint32_t count{ 0 };
+
+	[[nodiscard]] bool IsLeaf() const {
+		return right == 0;
+	}
+};
+
+// Number of structural updates performed by a broadphase since the stats were last reset.
+struct BroadphaseStats {
+	// Full rebuilds of the structure from scratch.
+	std::size_t rebuilds{ 0 };
+	// In place updates where only moved, inserted or removed objects were touched.
+	std::size_t refits{ 0 };
+};
+
+// Two entities whose bounding AABBs overlap.
+struct BroadphasePair {
+	Entity first;
+	Entity second;
+};
+
+enum class BroadphaseType {
+	KDTree,
+	DynamicAABBTree,
+	// Uniform grid, suited to many similarly sized objects.
+	SpatialHash,
+	// Incrementally sorted intervals along one axis, suited to many small objects which move
+	// coherently.
+	SortAndSweep
 };
 
-class KDTree {
+// Spatial acceleration structure used to find potentially colliding objects.
+// Changes made through UpdateBoundingAABB(), Insert() and Remove() are only guaranteed to be
+// visible to queries after the following EndFrameUpdate().
+class Broadphase {
 public:
-	KDTree(std::size_t max_objects_per_node = 64, float rebuild_threshold = 0.25f);
+	virtual ~Broadphase() = default;
 
-	// (Re)Build KD-tree from scratch (clears moved list).
-	void Build(const std::vector<KDObject>& objects);
-
-	// TODO: In the future consider moving to a cached KD-tree where the following events will
-	// trigger an entity to be updated within the KD-tree.
-	/*
-	 * Entity moved (own transform changed)	-> Mark as dirty.
-	 * Entity's parent moved -> Mark entity and descendants as dirty.
-	 * Transform added/removed -> Mark entity as dirty.
-	 * Parent changed (reparenting)	-> Mark entity and descendants as dirty.
-	 * Shape changed -> Mark entity as dirty.
-	 * Shape added -> Insert into KD-tree.
-	 * Shape removed -> Remove from KD-tree.
-	 * Entity destroyed -> Remove from KD-tree (use a Spatial tag component with hooks).
-	 */
-	// Mark an entity as moved during the frame. Doesn't touch the tree immediately.
-	void UpdateBoundingAABB(const Entity& e, const BoundingAABB& aabb);
-
-	// Insert new entity immediately (optional). Also mark as moved to ensure it's processed.
-	void Insert(const Entity& e, const BoundingAABB& aabb);
-
-	// Remove entity immediately (mark for removal), processed at EndFrame.
-	void Remove(const Entity& e);
+	// (Re)Build the structure from scratch.
+	virtual void Build(const std::vector<KDObject>& objects) = 0;
+
+	// Mark an entity as moved during the frame.
+	virtual void UpdateBoundingAABB(const Entity& e, const BoundingAABB& aabb) = 0;
+
+	// Insert new entity.
+	virtual void Insert(const Entity& e, const BoundingAABB& aabb) = 0;
+
+	// Remove entity.
+	virtual void Remove(const Entity& e) = 0;
 
 	// Should be called once per frame after all
 	// UpdateBoundingAABB()/Insert()/Remove()
-	void EndFrameUpdate();
+	virtual void EndFrameUpdate() = 0;
+
+	// Bulk per-frame update. Objects is the complete set of objects which should be in the
+	// structure this frame: objects whose bounding AABB changed are moved, new objects are
+	// inserted and objects which are not in the given set are removed. All changes are then
+	// applied in a single EndFrameUpdate().
+	virtual void Update(const std::vector<KDObject>& objects) = 0;
+
+	[[nodiscard]] virtual const BroadphaseStats& GetStats() const = 0;
+
+	virtual void ResetStats() = 0;
 
-	// Note: If region is a bounding volume inside of the KD-tree, Query will return that region
+	// Replaces the contents of pairs with every pair of objects whose bounding AABBs overlap.
+	// Each pair is reported once, in no particular order.
+	virtual void FindPairs(std::vector<BroadphasePair>& pairs) const = 0;
+
+	// Note: If region is a bounding volume inside of the structure, Query will return that region
 	// entity as well (in other words, you must check for self collisions).
-	std::vector<Entity> Query(const BoundingAABB& region) const;
+	virtual std::vector<Entity> Query(const BoundingAABB& region) const = 0;
+
+	virtual std::vector<Entity> Query(const V2_float& point) const = 0;
 
-	std::vector<Entity> Query(const V2_float& point) const;
+	// Appends every entity hit by aabb moving along dir to hits, so that callers can reuse the
+	// capacity of hits between queries.
+	// @param entity passed to avoid raycasting against itself.
+	virtual void Raycast(
+		const Entity& entity, const V2_float& dir, const BoundingAABB& aabb,
+		std::vector<Entity>& hits
+	) const = 0;
 
 	// @param entity passed to avoid raycasting against itself.
-	std::vector<Entity> Raycast(const Entity& entity, const V2_float& dir, const BoundingAABB& aabb)
-		const;
+	[[nodiscard]] std::vector<Entity> Raycast(
+		const Entity& entity, const V2_float& dir, const BoundingAABB& aabb
+	) const;
 
 	// @param entity passed to avoid raycasting against itself.
-	Entity RaycastFirst(const Entity& entity, const V2_float& dir, const BoundingAABB& aabb) const;
+	virtual Entity RaycastFirst(const Entity& entity, const V2_float& dir, const BoundingAABB& aabb)
+		const = 0;
+};
+
+class KDTree : public Broadphase {
+public:
+	KDTree(std::size_t max_objects_per_node = 64, float rebuild_threshold = 0.25f);
+
+	// (Re)Build KD-tree from scratch (clears moved list).
+	void Build(const std::vector<KDObject>& objects) override;
+
+	// Mark an entity as moved during the frame. Doesn't touch the tree immediately: the entry is
+	// queued and EndFrameUpdate() either refits the affected nodes or, once the changes exceed
+	// the rebuild threshold, rebuilds the tree from the cached entries.
+	void UpdateBoundingAABB(const Entity& e, const BoundingAABB& aabb) override;
+
+	// Insert new entity. Processed at EndFrameUpdate().
+	void Insert(const Entity& e, const BoundingAABB& aabb) override;
+
+	// Remove entity (mark for removal), processed at EndFrameUpdate().
+	void Remove(const Entity& e) override;
+
+	void EndFrameUpdate() override;
+
+	void Update(const std::vector<KDObject>& objects) override;
+
+	[[nodiscard]] const BroadphaseStats& GetStats() const override;
+
+	void ResetStats() override;
+
+	void FindPairs(std::vector<BroadphasePair>& pairs) const override;
+
+	std::vector<Entity> Query(const BoundingAABB& region) const override;
+
+	std::vector<Entity> Query(const V2_float& point) const override;
+
+	using Broadphase::Raycast;
+
+	void Raycast(
+		const Entity& entity, const V2_float& dir, const BoundingAABB& aabb,
+		std::vector<Entity>& hits
+	) const override;
+
+	Entity RaycastFirst(const Entity& entity, const V2_float& dir, const BoundingAABB& aabb)
+		const override;
 
 private:
-	std::unique_ptr<KDNode> root;
-	std::unordered_map<Entity, KDObject> entity_map;
-	std::unordered_set<Entity> moved_entities;
+	constexpr static std::uint32_t invalid_index_{ std::numeric_limits<std::uint32_t>::max() };
+
+	// Each level halves the object count, so this comfortably covers any 32 bit object count.
+	constexpr static std::size_t max_depth_{ 64 };
+
+	struct Entry {
+		// Latest bounding AABB of the entity (source of truth).
+		BoundingAABB aabb;
+		// Index of the entity's object inside objects_, or invalid_index_ if not yet placed.
+		std::uint32_t index{ invalid_index_ };
+		// Value of stamp_ during the last Build() or Update() which contained the entity.
+		std::uint32_t stamp{ 0 };
+		// Entity is in dirty_ and waiting for EndFrameUpdate().
+		bool dirty{ false };
+		// Entity will be removed at EndFrameUpdate().
+		bool removed{ false };
+	};
 
-	std::size_t max_objects_per_node{ 64 };
-	float rebuild_threshold{ 0.25f };
+	void MarkDirty(const Entity& e, Entry& entry);
 
-	template <typename Func>
-	void Traverse(const KDNode* node, Func&& visit) const {
-		if (!node) {
-			return;
+	// Rebuilds the entire tree from entity_map_. Reuses the capacity of nodes_ and objects_ so no
+	// allocations occur once the tree has reached its steady state size.
+	void Rebuild();
+
+	// Builds the subtree for objects_[first, first + count) by partitioning the range in place
+	// around the median center of the split axis.
+	// @return Index of the subtree root in nodes_.
+	std::uint32_t BuildRecursive(std::uint32_t first, std::uint32_t count, int depth);
+
+	// Recomputes node bounds bottom-up from the objects they contain. Children always come after
+	// their parent in nodes_, so a reverse sweep visits children first.
+	void RefitBounds();
+
+	// Visits every non-deleted object in nodes whose bounds pass the descend check, followed by
+	// every non-deleted pending object whose own bounding AABB passes the check.
+	template <typename DescendFunc, typename VisitFunc>
+	void Traverse(DescendFunc&& descend, VisitFunc&& visit) const {
+		if (!nodes_.empty()) {
+			std::array<std::uint32_t, max_depth_> stack;
+			std::size_t size{ 0 };
+			stack[size++] = 0;
+			while (size > 0) {
+				std::uint32_t index{ stack[--size] };
+				const KDNode& node{ nodes_[index] };
+				if (!descend(node.bounds)) {
+					continue;
+				}
+				if (!node.IsLeaf()) {
+					stack[size++] = node.right;
+					stack[size++] = index + 1;
+					continue;
+				}
+				for (std::uint32_t i{ node.first }; i < node.first + node.count; ++i) {
+					if (!objects_[i].deleted) {
+						visit(objects_[i]);
+					}
+				}
+			}
 		}
-		for (const auto& obj : node->objects) {
-			if (!obj.deleted) {
+		for (std::size_t i{ tree_object_count_ }; i < objects_.size(); ++i) {
+			const auto& obj{ objects_[i] };
+			if (!obj.deleted && descend(obj.aabb)) {
 				visit(obj);
 			}
 		}
-		if (node->left) {
-			Traverse(node->left.get(), visit);
-		}
-		if (node->right) {
-			Traverse(node->right.get(), visit);
-		}
 	}
 
-	std::unique_ptr<KDNode> BuildRecursive(const std::vector<KDObject>& objects, int depth);
-
-	// Strategy:
-	// 1) For each moved entity that exists in the tree, find the leaf it currently resides in
-	// (using the
-	//    *old* rect stored in entity_map before the move). We use the entity_map's rect because
-	//    when the user called UpdateRect we already wrote the new rect there. To find the old tree
-	//    leaf we need the "previous" rect; to keep it simple here, we assume UpdateRect replaced
-	//    rect in entity_map but we have also kept a copy of the previous rect in the node's objects
-	//    (we will match by entity id). So we traverse the tree like in Remove() to find the leaf
-	//    and mark that object as deleted (swap-remove) so the node keeps compact storage.
-	// 2) Collect the moved objects from entity_map (current rect) and insert them into leaf nodes
-	// in bulk. 3) For any leaf nodes that exceed capacity, call SplitNode once per such node
-	// (recursive splitting)
-	void PartialUpdate();
-
-	// Find and remove the object with entity id from the tree by traversing to leaves using the
-	// object's position inside the node (we search node->objects for the entity). When found, we
-	// swap-pop to remove it quickly and record the leaf pointer.
-	bool RemoveFromTree(KDNode* node, Entity e, int depth, std::vector<KDNode*>& touched_leaves);
-
-	void CompactTree(KDNode* node);
-
-	// Insert object into a leaf (descend using object's rect). We do NOT split here.
-	void InsertIntoLeaf(KDNode* node, const KDObject& obj, int depth);
-
-	// Compute depth of a target leaf by walking tree; returns -1 if not found.
-	[[nodiscard]] int ComputeDepth(KDNode* current, KDNode* target, int depth);
-
-	// External SplitNode: we'll emulate the same logic as your original SplitNode but accept a
-	// pointer to an existing leaf.
-	void SplitNodeExternal(KDNode* node, int depth);
+	// Nodes in preorder. nodes_[0] is the root.
+	std::vector<KDNode> nodes_;
+
+	// Objects ordered such that every node covers a contiguous range. Objects at or after
+	// tree_object_count_ were inserted since the last rebuild and are not part of any node yet.
+	// They are tested linearly until the next rebuild.
+	std::vector<KDObject> objects_;
+	std::size_t tree_object_count_{ 0 };
+
+	// Number of objects_ flagged as deleted since the last rebuild.
+	std::size_t deleted_count_{ 0 };
+
+	std::unordered_map<Entity, Entry> entity_map_;
+
+	// Entities with pending moves, insertions or removals. Flagged in their entry to avoid
+	// duplicates.
+	std::vector<Entity> dirty_;
+
+	// Number of entries flagged as removed which are still inside entity_map_.
+	std::size_t removed_count_{ 0 };
+
+	std::uint32_t stamp_{ 0 };
+
+	std::size_t max_objects_per_node_{ 64 };
+	float rebuild_threshold_{ 0.25f };
+
+	BroadphaseStats stats_;
 };
 
 } // namespace impl
@@ -93,20 +93,19 @@ void Collider::ResetContainers() {
 }
 
 void Collider::ResetOverlaps() {
-	previous_overlaps_ = overlaps_;
 	overlaps_.clear();
 }
 
 void Collider::ResetIntersects() {
-	previous_intersects_ = intersects_;
 	intersects_.clear();
 }
 
 void Collider::ResetSweeps() {
-	previous_sweeps_ = sweeps_;
 	sweeps_.clear();
 }
 
+// The collision handler tests each pair of colliders once per frame, so duplicates are not
+// expected. They are still ignored so that release builds never report a collision twice.
 void Collider::AddOverlap(const Entity& other) {
 	if (OverlappedWith(other)) {
 		return;
@@ -114,6 +113,7 @@ void Collider::AddOverlap(const Entity& other) {
 	overlaps_.emplace_back(other);
 }
 
+// See AddOverlap.
 void Collider::AddIntersect(const Collision& collision) {
 	if (VectorContains(intersects_, collision)) {
 		return;
@@ -140,15 +140,11 @@ private:
 	// Which category this collider is a part of.
 	CollisionCategory category_{ 0 };
 
-	// Collisions from the current frame.
+	// Collisions from the current frame. Overlap start and stop events are tracked by the
+	// collision handler, so previous frames are not kept.
 	std::vector<Entity> overlaps_;
 	std::vector<Collision> intersects_;
 	std::vector<Collision> sweeps_;
-
-	// Collisions from the previous frame.
-	std::vector<Entity> previous_overlaps_;
-	std::vector<Collision> previous_intersects_;
-	std::vector<Collision> previous_sweeps_;
 };
 
 PTGN_SERIALIZER_REGISTER_ENUM(
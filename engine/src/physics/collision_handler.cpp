@@ -1,15 +1,23 @@
 #include "physics/collision_handler.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <span>
 #include <vector>
 
-#include "core/app/game.h"
 #include "core/app/manager.h"
+#include "core/ecs/components/movement.h"
 #include "core/ecs/components/transform.h"
 #include "core/ecs/entity.h"
 #include "core/ecs/entity_hierarchy.h"
 #include "core/scripting/script.h"
+#include "core/utils/frame_profiler.h"
 #include "core/utils/span.h"
+#include "core/utils/thread_pool.h"
+#include "core/utils/thread_stats.h"
 #include "debug/core/log.h"
 #include "debug/runtime/assert.h"
 #include "math/geometry/shape.h"
@@ -21,7 +29,11 @@
 #include "physics/bounding_aabb.h"
 #include "physics/broadphase.h"
 #include "physics/collider.h"
+#include "physics/dynamic_aabb_tree.h"
+#include "physics/physics.h"
 #include "physics/rigid_body.h"
+#include "physics/sort_and_sweep.h"
+#include "physics/spatial_hash_grid.h"
 #include "world/scene/scene.h"
 
 namespace ptgn::impl {
@@ -49,261 +61,697 @@ bool CollisionHandler::CanCollide(
 	return true;
 }
 
-template <auto ScriptType, auto EarlyExit>
-std::vector<Entity> GetDiscreteCollideables(Entity& entity1, const impl::KDTree& tree) {
-	const auto& collider{ entity1.Get<Collider>() };
+// @return True if entity1 is allowed to collide with entity2 from its own side, i.e. the
+// collision mask of entity1 and its scripts accept entity2.
+template <auto ScriptCheck>
+static bool CanCollideFrom(
+	Entity& entity1, const Collider& collider1, const Entity& entity2, const Collider& collider2
+) {
+	if (!CollisionHandler::CanCollide(entity1, collider1, entity2, collider2)) {
+		return false;
+	}
+	if (const auto scripts{ entity1.TryGet<Scripts>() }) {
+		return scripts->ConditionCheck(ScriptCheck, entity2);
+	}
+	return true;
+}
 
-	Transform transform{ GetAbsoluteTransform(entity1) };
-	transform = OffsetByOrigin(collider.shape, transform, entity1);
+BoundingAABB CollisionHandler::UpdateKDTree(const Entity& entity, float dt) {
+	const auto& collider{ entity.Get<Collider>() };
+	auto transform{ GetAbsoluteTransform(entity) };
+	transform = OffsetByOrigin(collider.shape, transform, entity);
+	const auto new_bounding_aabb{ GetBoundingAABB(collider.shape, transform) };
+	static_tree_->UpdateBoundingAABB(entity, new_bounding_aabb);
+	if (auto it{ broadphase_entries_.find(entity) }; it != broadphase_entries_.end()) {
+		it->second.aabb = new_bounding_aabb;
+	}
+	if (const auto rb{ entity.TryGet<RigidBody>() }) {
+		auto v{ rb->velocity * dt };
+		auto new_expanded_aabb{ new_bounding_aabb.ExpandByVelocity(v) };
+		dynamic_tree_->UpdateBoundingAABB(entity, new_expanded_aabb);
+		return new_expanded_aabb;
+	}
+	return new_bounding_aabb;
+}
 
-	auto bounding_aabb{ GetBoundingAABB(collider.shape, transform) };
+void CollisionHandler::ApplyBroadphaseUpdates() {
+	static_tree_->EndFrameUpdate();
+	dynamic_tree_->EndFrameUpdate();
+}
 
-	auto candidates{ tree.Query(bounding_aabb) };
+// @return True if the transform of the entity or of any of its ancestors was modified since the
+// latest physics step.
+static bool HasMoved(const Entity& entity) {
+	if (const auto transform{ entity.TryGet<Transform>() };
+		transform && transform->IsPhysicsDirty()) {
+		return true;
+	}
+	return HasParent(entity) && HasMoved(GetParent(entity));
+}
 
-	std::vector<Entity> collideables;
-	collideables.reserve(candidates.size());
+CollisionHandler::BodyState CollisionHandler::GetBodyState(Entity& entity) {
+	auto rigid_body{ entity.TryGet<RigidBody>() };
+	if (!rigid_body) {
+		return HasMoved(entity) ? BodyState::Moving : BodyState::Static;
+	}
+	if (rigid_body->sleeping_ && HasMoved(entity)) {
+		rigid_body->Wake();
+	}
+	return rigid_body->sleeping_ ? BodyState::Sleeping : BodyState::Moving;
+}
 
-	for (const auto& entity2 : candidates) {
-		if (entity2 == entity1) {
-			continue;
-		}
+void CollisionHandler::UpdateBroadphase(Scene& scene, float dt) {
+	static_objects_.clear();
+	object_indices_.clear();
+	collider_transforms_.clear();
+	object_states_.clear();
 
-		if (!entity1.Has<Collider>()) {
-			break;
+	++transform_generation_;
+	++broadphase_stamp_;
+
+	static_tree_->ResetStats();
+	dynamic_tree_->ResetStats();
+
+	for (auto [entity, collider] : scene.EntitiesWith<Collider>()) {
+		collider.ResetContainers();
+		auto state{ GetBodyState(entity) };
+		auto [it, inserted] = broadphase_entries_.try_emplace(entity);
+		auto& entry{ it->second };
+		entry.stamp = broadphase_stamp_;
+		// Sleeping bodies have not moved since they fell asleep, so their transform is reused and
+		// their tree entries are left untouched.
+		if (inserted || state != BodyState::Sleeping) {
+			auto transform{ GetAbsoluteTransform(entity) };
+			entry.transform = OffsetByOrigin(collider.shape, transform, entity);
+			auto bounding_aabb{ GetBoundingAABB(collider.shape, entry.transform) };
+			if (inserted || bounding_aabb != entry.aabb) {
+				entry.aabb = bounding_aabb;
+				static_tree_->UpdateBoundingAABB(entity, bounding_aabb);
+			}
+			if (const auto rb{ entity.TryGet<RigidBody>() }) {
+				auto velocity{ rb->velocity * dt };
+				dynamic_tree_->UpdateBoundingAABB(entity, bounding_aabb.ExpandByVelocity(velocity));
+				entry.dynamic = true;
+			} else if (entry.dynamic) {
+				dynamic_tree_->Remove(entity);
+				entry.dynamic = false;
+			}
 		}
+		object_indices_.emplace(entity, static_cast<std::uint32_t>(static_objects_.size()));
+		collider_transforms_.push_back({ entry.transform, transform_generation_ });
+		object_states_.emplace_back(state);
+		static_objects_.emplace_back(entity, entry.aabb);
+	}
 
-		if (!entity2.Has<Collider>()) {
-			continue;
+	// Every entry was gathered this frame, so no collider was removed.
+	if (broadphase_entries_.size() != static_objects_.size()) {
+		for (auto it{ broadphase_entries_.begin() }; it != broadphase_entries_.end();) {
+			if (it->second.stamp == broadphase_stamp_) {
+				++it;
+				continue;
+			}
+			static_tree_->Remove(it->first);
+			if (it->second.dynamic) {
+				dynamic_tree_->Remove(it->first);
+			}
+			it = broadphase_entries_.erase(it);
 		}
+	}
 
-		const auto& collider1{ entity1.Get<Collider>() };
-		const auto& collider2{ entity2.Get<Collider>() };
+	island_parents_.resize(static_objects_.size());
+	std::iota(island_parents_.begin(), island_parents_.end(), std::uint32_t{ 0 });
 
-		if (EarlyExit(entity1, collider1, entity2, collider2)) {
-			continue;
-		}
+	ApplyBroadphaseUpdates();
 
-		if (!CollisionHandler::CanCollide(entity1, collider1, entity2, collider2)) {
-			continue;
-		}
+	const auto& static_stats{ static_tree_->GetStats() };
+	const auto& dynamic_stats{ dynamic_tree_->GetStats() };
 
-		if (const auto scripts{ entity1.TryGet<Scripts>() }) {
-			bool can_collide{ scripts->ConditionCheck(ScriptType, entity2) };
-			if (can_collide) {
-				collideables.emplace_back(entity2);
-			}
-		} else {
-			collideables.emplace_back(entity2);
-		}
+	broadphase_stats_.rebuilds = static_stats.rebuilds + dynamic_stats.rebuilds;
+	broadphase_stats_.refits   = static_stats.refits + dynamic_stats.refits;
+}
+
+const BroadphaseStats& CollisionHandler::GetBroadphaseStats() const {
+	return broadphase_stats_;
+}
+
+static std::unique_ptr<Broadphase> CreateBroadphase(BroadphaseType type, float cell_size) {
+	switch (type) {
+		case BroadphaseType::KDTree:		  return std::make_unique<KDTree>(100);
+		case BroadphaseType::DynamicAABBTree: return std::make_unique<DynamicAABBTree>();
+		case BroadphaseType::SpatialHash:	  return std::make_unique<SpatialHashGrid>(cell_size);
+		case BroadphaseType::SortAndSweep:	  return std::make_unique<SortAndSweep>();
+		default:							  PTGN_ERROR("Unrecognized broadphase type");
 	}
+}
 
-	return collideables;
+void CollisionHandler::SetBroadphase(BroadphaseType type, float cell_size) {
+	PTGN_ASSERT(cell_size > 0.0f, "Spatial hash cell size must be positive");
+	if (type == broadphase_type_ &&
+		(type != BroadphaseType::SpatialHash || cell_size == cell_size_)) {
+		return;
+	}
+	broadphase_type_ = type;
+	cell_size_		 = cell_size;
+	static_tree_	 = CreateBroadphase(type, cell_size);
+	dynamic_tree_	 = CreateBroadphase(type, cell_size);
+	broadphase_entries_.clear();
 }
 
-void CollisionHandler::UpdateKDTree(const Entity& entity, float dt) {
-	const auto& collider{ entity.Get<Collider>() };
-	auto transform{ GetAbsoluteTransform(entity) };
-	transform = OffsetByOrigin(collider.shape, transform, entity);
-	const auto new_bounding_aabb{ GetBoundingAABB(collider.shape, transform) };
-	static_tree_.UpdateBoundingAABB(entity, new_bounding_aabb);
-	static_tree_.EndFrameUpdate();
-	if (const auto rb{ entity.TryGet<RigidBody>() }) {
-		auto v{ rb->velocity * dt };
-		auto new_expanded_aabb{ new_bounding_aabb.ExpandByVelocity(v) };
-		dynamic_tree_.UpdateBoundingAABB(entity, new_expanded_aabb);
-		dynamic_tree_.EndFrameUpdate();
+BroadphaseType CollisionHandler::GetBroadphaseType() const {
+	return broadphase_type_;
+}
+
+void CollisionHandler::SetNarrowphaseThreadCount(std::size_t thread_count) {
+	if (thread_count == 1) {
+		thread_pool_.reset();
+		return;
+	}
+	thread_pool_ = std::make_unique<ThreadPool>(thread_count);
+	if (thread_pool_->GetThreadCount() == 1) {
+		thread_pool_.reset();
 	}
 }
 
-void CollisionHandler::Overlap(Entity& entity1) const {
-	PTGN_ASSERT(entity1.Has<Collider>());
-	PTGN_ASSERT(entity1.Get<Collider>().mode == CollisionMode::Overlap);
+std::size_t CollisionHandler::GetNarrowphaseThreadCount() const {
+	return thread_pool_ ? thread_pool_->GetThreadCount() : 1;
+}
 
-	auto collideables{ GetDiscreteCollideables<
-		&OverlapScript::PreOverlapCheck, []([[maybe_unused]] const Entity& e1, const Collider& c1,
-											const Entity& e2, const Collider& c2) {
-			return c2.mode == CollisionMode::None || c1.OverlappedWith(e2);
-		}>(entity1, static_tree_) };
+void CollisionHandler::FindCandidatePairs() {
+	static_tree_->FindPairs(pairs_);
+
+	// Pairs are processed in the order of their first object so that the results do not depend on
+	// the order in which the broadphase reports them.
+	candidate_pairs_.clear();
+	candidate_pairs_.reserve(pairs_.size());
+	for (const auto& pair : pairs_) {
+		auto it1{ object_indices_.find(pair.first) };
+		auto it2{ object_indices_.find(pair.second) };
+		PTGN_ASSERT(
+			it1 != object_indices_.end() && it2 != object_indices_.end(),
+			"Broadphase pair contains an entity without a collider"
+		);
+		auto [first, second] = std::minmax(it1->second, it2->second);
+		candidate_pairs_.emplace_back(first, second);
+	}
+	std::ranges::sort(candidate_pairs_);
+}
 
-	for (const auto& entity2 : collideables) {
-		auto& collider1{ entity1.Get<Collider>() };
-		auto& collider2{ entity2.Get<Collider>() };
+const Transform& CollisionHandler::GetColliderTransform(std::uint32_t index) {
+	auto& cached{ collider_transforms_[index] };
+	if (cached.generation != transform_generation_) {
+		const auto& entity{ static_objects_[index].entity };
+		auto transform{ GetAbsoluteTransform(entity) };
+		cached.transform = OffsetByOrigin(entity.Get<Collider>().shape, transform, entity);
+		cached.generation = transform_generation_;
+	}
+	return cached.transform;
+}
 
-		auto t1{ GetAbsoluteTransform(entity1) };
-		auto t2{ GetAbsoluteTransform(entity2) };
+void CollisionHandler::ComputePairResults() {
+	pair_results_.clear();
+	moved_roots_.clear();
 
-		auto transform1{ OffsetByOrigin(collider1.shape, t1, entity1) };
-		auto transform2{ OffsetByOrigin(collider2.shape, t2, entity2) };
+	if (!thread_pool_ || candidate_pairs_.size() < 2 * min_pairs_per_thread_) {
+		return;
+	}
 
-		if (!ptgn::Overlap(transform1, collider1.shape, transform2, collider2.shape)) {
-			continue;
+	object_colliders_.clear();
+	object_roots_.clear();
+	for (const auto& object : static_objects_) {
+		object_colliders_.emplace_back(&object.entity.Get<Collider>());
+		object_roots_.emplace_back(GetRootEntity(object.entity));
+	}
+
+	pair_results_.resize(candidate_pairs_.size());
+
+	thread_stats_.assign(thread_pool_->GetThreadCount(), Stats{});
+
+	// Each pair writes to its own result, so no synchronization is needed and the results do not
+	// depend on how the pairs are partitioned.
+	thread_pool_->ParallelFor(
+		candidate_pairs_.size(), min_pairs_per_thread_,
+		[&](std::size_t begin, std::size_t end, std::size_t thread) {
+			PTGN_FRAME_SCOPE("CollisionHandler::Narrowphase");
+			ThreadStatsScope stats_scope{ thread_stats_[thread] };
+			for (std::size_t pair{ begin }; pair < end; ++pair) {
+				auto [index1, index2] = candidate_pairs_[pair];
+				const auto& collider1{ *object_colliders_[index1] };
+				const auto& collider2{ *object_colliders_[index2] };
+				if (collider1.mode == CollisionMode::None ||
+					collider2.mode == CollisionMode::None) {
+					continue;
+				}
+				const auto& transform1{ collider_transforms_[index1].transform };
+				const auto& transform2{ collider_transforms_[index2].transform };
+				auto& result{ pair_results_[pair] };
+				if (collider1.mode == CollisionMode::Overlap ||
+					collider2.mode == CollisionMode::Overlap) {
+					result.occurred =
+						ptgn::Overlap(transform1, collider1.shape, transform2, collider2.shape);
+				} else if (IsRestingPair(pair)) {
+					continue;
+				} else {
+					result.intersection =
+						ptgn::Intersect(transform1, collider1.shape, transform2, collider2.shape);
+					result.occurred = result.intersection.Occurred();
+				}
+				result.computed = true;
+			}
 		}
+	);
 
-		collider1.AddOverlap(entity2);
-		collider2.AddOverlap(entity1);
+	auto& stats{ GetThreadStats() };
+	for (const auto& thread_stats : thread_stats_) {
+		MergeGeometryStats(stats, thread_stats);
 	}
 }
 
-void CollisionHandler::Intersect(Entity& entity1, float dt) {
-	PTGN_ASSERT(entity1.Has<Collider>());
+const CollisionHandler::PairResult* CollisionHandler::GetPairResult(std::size_t pair) const {
+	if (pair_results_.empty() || !pair_results_[pair].computed) {
+		return nullptr;
+	}
+	auto [index1, index2] = candidate_pairs_[pair];
+	if (!moved_roots_.empty() &&
+		(moved_roots_.contains(object_roots_[index1]) ||
+		 moved_roots_.contains(object_roots_[index2]))) {
+		return nullptr;
+	}
+	return &pair_results_[pair];
+}
 
-	auto collideables{ GetDiscreteCollideables<
-		&CollisionScript::PreCollisionCheck,
-		[]([[maybe_unused]] const Entity& e1, [[maybe_unused]] const Collider& c1,
-		   [[maybe_unused]] const Entity& e2, const Collider& c2) {
-			return c2.mode == CollisionMode::Overlap ||
-				   c2.mode == CollisionMode::None; //|| c1.IntersectedWith(e2);
-		}>(entity1, static_tree_) };
+void CollisionHandler::ProcessPair(std::size_t pair, float dt) {
+	auto [index1, index2] = candidate_pairs_[pair];
 
-	std::vector<Entity> moved_entities;
+	Entity entity1{ static_objects_[index1].entity };
+	Entity entity2{ static_objects_[index2].entity };
 
-	for (auto& entity2 : collideables) {
-		auto& collider1{ entity1.Get<Collider>() };
-		auto& collider2{ entity2.Get<Collider>() };
+	if (!entity1.Has<Collider>() || !entity2.Has<Collider>()) {
+		return;
+	}
 
-		auto t1{ GetAbsoluteTransform(entity1) };
-		auto t2{ GetAbsoluteTransform(entity2) };
+	const auto& collider1{ entity1.Get<Collider>() };
+	const auto& collider2{ entity2.Get<Collider>() };
 
-		auto transform1{ OffsetByOrigin(collider1.shape, t1, entity1) };
-		auto transform2{ OffsetByOrigin(collider2.shape, t2, entity2) };
+	if (collider1.mode == CollisionMode::None || collider2.mode == CollisionMode::None) {
+		return;
+	}
 
-		auto intersection{
-			ptgn::Intersect(transform1, collider1.shape, transform2, collider2.shape)
-		};
+	if (collider1.mode == CollisionMode::Overlap || collider2.mode == CollisionMode::Overlap) {
+		Overlap(pair);
+		return;
+	}
 
-		if (!intersection.Occurred()) {
-			continue;
-		}
+	if (IsRestingPair(pair)) {
+		return;
+	}
 
-		if (auto scripts1{ entity1.TryGet<Scripts>() }) {
-			scripts1->AddAction(
-				&CollisionScript::OnCollision, Collision{ entity2, intersection.normal }
-			);
-		}
-		if (auto scripts2{ entity2.TryGet<Scripts>() }) {
-			scripts2->AddAction(
-				&CollisionScript::OnCollision, Collision{ entity1, -intersection.normal }
-			);
-		}
+	// Sleeping bodies are woken up by any moving collider which reaches them.
+	WakeBody(index1);
+	WakeBody(index2);
 
-		collider1.AddIntersect(Collision{ entity2, intersection.normal });
-		collider2.AddIntersect(Collision{ entity1, -intersection.normal });
+	Intersect(pair, dt);
+}
 
-		if (!entity1.Has<RigidBody>()) {
-			continue;
-		}
+bool CollisionHandler::IsRestingPair(std::size_t pair) const {
+	auto [index1, index2] = candidate_pairs_[pair];
+	auto state1{ object_states_[index1] };
+	auto state2{ object_states_[index2] };
+	return state1 != BodyState::Moving && state2 != BodyState::Moving &&
+		   (state1 == BodyState::Sleeping || state2 == BodyState::Sleeping);
+}
 
-		if (IsImmovable(entity1)) {
-			continue;
-		}
+void CollisionHandler::WakeBody(std::uint32_t index) {
+	if (object_states_[index] != BodyState::Sleeping) {
+		return;
+	}
+	static_objects_[index].entity.Get<RigidBody>().Wake();
+	object_states_[index] = BodyState::Moving;
+}
 
-		Entity root_entity{ GetRootEntity(entity1) };
+void CollisionHandler::Overlap(std::size_t pair) {
+	auto [index1, index2] = candidate_pairs_[pair];
 
-		auto& root_transform{ GetTransform(root_entity) };
+	Entity entity1{ static_objects_[index1].entity };
+	Entity entity2{ static_objects_[index2].entity };
 
-		auto minimum_translation_vector{ intersection.normal * (intersection.depth + slop_) };
+	auto& collider1{ entity1.Get<Collider>() };
+	auto& collider2{ entity2.Get<Collider>() };
 
-		root_transform.Translate(minimum_translation_vector);
+	// Each overlap collider checks the pair from its own side, so either one may accept it.
+	bool check1{ collider1.mode == CollisionMode::Overlap &&
+				 CanCollideFrom<&OverlapScript::PreOverlapCheck>(
+					 entity1, collider1, entity2, collider2
+				 ) };
+	bool check2{ !check1 && collider2.mode == CollisionMode::Overlap &&
+				 CanCollideFrom<&OverlapScript::PreOverlapCheck>(
+					 entity2, collider2, entity1, collider1
+				 ) };
 
-		moved_entities.emplace_back(entity1);
+	if (!check1 && !check2) {
+		return;
+	}
 
-		if (auto rigid_body{ root_entity.TryGet<RigidBody>() }) {
-			rigid_body->velocity = GetRemainingVelocity(
-				rigid_body->velocity, { 0.0f, intersection.normal }, collider1.response
-			);
-		}
+	bool overlap{ false };
+	if (const auto result{ GetPairResult(pair) }) {
+		overlap = result->occurred;
+	} else {
+		const auto& transform1{ GetColliderTransform(index1) };
+		const auto& transform2{ GetColliderTransform(index2) };
+		overlap = ptgn::Overlap(transform1, collider1.shape, transform2, collider2.shape);
+	}
+
+	if (!overlap) {
+		return;
+	}
+
+	collider1.AddOverlap(entity2);
+	collider2.AddOverlap(entity1);
+
+	AddContact(entity1, entity2);
+}
+
+void CollisionHandler::Intersect(std::size_t pair, float dt) {
+	auto [index1, index2] = candidate_pairs_[pair];
+
+	Entity entity1{ static_objects_[index1].entity };
+	Entity entity2{ static_objects_[index2].entity };
+
+	auto& collider1{ entity1.Get<Collider>() };
+	auto& collider2{ entity2.Get<Collider>() };
+
+	// Continuous colliders without a rigid body are not resolved at all.
+	const auto resolves = [](const Entity& entity, const Collider& collider) {
+		return collider.mode == CollisionMode::Discrete ||
+			   (collider.mode == CollisionMode::Continuous && entity.Has<RigidBody>());
+	};
+
+	bool check1{ resolves(entity1, collider1) &&
+				 CanCollideFrom<&CollisionScript::PreCollisionCheck>(
+					 entity1, collider1, entity2, collider2
+				 ) };
+	bool check2{ resolves(entity2, collider2) &&
+				 CanCollideFrom<&CollisionScript::PreCollisionCheck>(
+					 entity2, collider2, entity1, collider1
+				 ) };
+
+	if (!check1 && !check2) {
+		return;
 	}
 
-	for (const auto& entity : moved_entities) {
-		UpdateKDTree(entity, dt);
+	Intersection intersection;
+	if (const auto result{ GetPairResult(pair) }) {
+		intersection = result->intersection;
+	} else {
+		const auto& transform1{ GetColliderTransform(index1) };
+		const auto& transform2{ GetColliderTransform(index2) };
+		intersection = ptgn::Intersect(transform1, collider1.shape, transform2, collider2.shape);
+	}
+
+	if (!intersection.Occurred()) {
+		return;
+	}
+
+	if (auto scripts1{ entity1.TryGet<Scripts>() }) {
+		scripts1->AddAction(&CollisionScript::OnCollision, Collision{ entity2, intersection.normal });
+	}
+	if (auto scripts2{ entity2.TryGet<Scripts>() }) {
+		scripts2->AddAction(
+			&CollisionScript::OnCollision, Collision{ entity1, -intersection.normal }
+		);
+	}
+
+	collider1.AddIntersect(Collision{ entity2, intersection.normal });
+	collider2.AddIntersect(Collision{ entity1, -intersection.normal });
+
+	const auto movable = [](const Entity& entity) {
+		return entity.Has<RigidBody>() && !IsImmovable(entity);
+	};
+
+	// Bodies supporting each other must fall asleep and wake up together.
+	if (movable(entity1) && movable(entity2)) {
+		MergeIslands(index1, index2);
+	}
+
+	// Only one of the entities is moved out of the other. If it is pushed into another collider,
+	// the overlap is only resolved this frame if that pair is among the candidates which are yet
+	// to be processed, since candidates are gathered before any pair is resolved. Otherwise it is
+	// resolved by the next broadphase, one frame later.
+	if (check1 && movable(entity1)) {
+		Resolve(entity1, intersection.normal, intersection.depth, collider1.response, dt);
+	} else if (check2 && movable(entity2)) {
+		Resolve(entity2, -intersection.normal, intersection.depth, collider2.response, dt);
 	}
 }
 
-std::vector<Entity> CollisionHandler::GetSweepCandidates(
-	Entity& entity1, const V2_float& velocity, const KDTree& tree
+void CollisionHandler::Resolve(
+	const Entity& entity, const V2_float& normal, float depth, CollisionResponse response, float dt
 ) {
-	const auto& collider{ entity1.Get<Collider>() };
+	Entity root_entity{ GetRootEntity(entity) };
 
-	Transform transform{ GetAbsoluteTransform(entity1) };
-	transform = OffsetByOrigin(collider.shape, transform, entity1);
+	auto& root_transform{ GetTransform(root_entity) };
 
-	auto bounding_aabb{ GetBoundingAABB(collider.shape, transform) };
+	auto minimum_translation_vector{ normal * (depth + slop_) };
 
-	auto candidates{ tree.Raycast(entity1, velocity, bounding_aabb) };
+	root_transform.Translate(minimum_translation_vector);
 
-	std::vector<Entity> collideables;
-	collideables.reserve(candidates.size());
+	if (auto rigid_body{ root_entity.TryGet<RigidBody>() }) {
+		rigid_body->velocity = GetRemainingVelocity(rigid_body->velocity, { 0.0f, normal }, response);
+	}
 
-	for (const auto& entity2 : candidates) {
-		PTGN_ASSERT(entity2 != entity1);
+	// Moving the root moves every collider in its hierarchy, so all cached transforms and
+	// precomputed results involving it are considered stale.
+	++transform_generation_;
+	if (!pair_results_.empty()) {
+		moved_roots_.emplace(root_entity);
+	}
 
-		if (!entity1.Has<Collider>() || !entity1.Has<RigidBody>()) {
-			break;
-		}
+	UpdateKDTree(entity, dt);
+}
 
-		if (!entity2.Has<Collider>()) {
-			continue;
+std::uint32_t CollisionHandler::FindIsland(std::uint32_t index) {
+	while (island_parents_[index] != index) {
+		// Path halving keeps the trees shallow.
+		island_parents_[index] = island_parents_[island_parents_[index]];
+		index				   = island_parents_[index];
+	}
+	return index;
+}
+
+void CollisionHandler::MergeIslands(std::uint32_t index1, std::uint32_t index2) {
+	auto island1{ FindIsland(index1) };
+	auto island2{ FindIsland(index2) };
+	if (island1 != island2) {
+		island_parents_[std::max(island1, island2)] = std::min(island1, island2);
+	}
+}
+
+void CollisionHandler::WakeIslands() {
+	std::erase_if(sleep_islands_, [](std::vector<Entity>& island) {
+		bool awake{ std::ranges::any_of(island, [](const Entity& entity) {
+			if (!entity.IsAlive()) {
+				return true;
+			}
+			const auto rigid_body{ entity.TryGet<RigidBody>() };
+			return rigid_body == nullptr || !rigid_body->sleeping_;
+		}) };
+		if (!awake) {
+			return false;
+		}
+		for (auto& entity : island) {
+			if (!entity.IsAlive()) {
+				continue;
+			}
+			if (auto rigid_body{ entity.TryGet<RigidBody>() }) {
+				rigid_body->Wake();
+			}
 		}
+		return true;
+	});
+}
 
-		const auto& collider2{ entity2.Get<Collider>() };
+void CollisionHandler::UpdateSleep(Scene& scene, const ptgn::Physics& physics, float dt) {
+	WakeIslands();
 
-		if (collider2.mode == CollisionMode::None || collider2.mode == CollisionMode::Overlap) {
+	float time_to_sleep{ physics.GetTimeToSleep() };
+
+	for (auto [entity, rigid_body] : scene.EntitiesWith<RigidBody>()) {
+		if (rigid_body.sleeping_) {
+			if (time_to_sleep == 0.0f) {
+				rigid_body.Wake();
+			}
+			continue;
+		}
+		// Bodies driven by movement components may be accelerated at any time.
+		if (time_to_sleep == 0.0f || !rigid_body.can_sleep || !physics.IsResting(rigid_body) ||
+			entity.Has<TopDownMovement>() || entity.Has<PlatformerMovement>()) {
+			rigid_body.sleep_time_ = 0.0f;
 			continue;
 		}
+		rigid_body.sleep_time_ += dt;
+	}
 
-		const auto& collider1{ entity1.Get<Collider>() };
+	if (time_to_sleep == 0.0f) {
+		sleep_islands_.clear();
+		return;
+	}
 
-		/*if (collider1.SweptWith(entity2)) {
-			continue;
-		}*/
+	const auto fall_asleep = [](RigidBody& rigid_body) {
+		rigid_body.sleeping_		= true;
+		rigid_body.velocity			= {};
+		rigid_body.angular_velocity = 0.0f;
+	};
 
-		if (!CanCollide(entity1, collider1, entity2, collider2)) {
+	// Bodies without a collider never collide, so each of them sleeps on its own.
+	for (auto [entity, rigid_body] : scene.EntitiesWith<RigidBody>()) {
+		if (!rigid_body.sleeping_ && rigid_body.sleep_time_ >= time_to_sleep &&
+			!object_indices_.contains(entity)) {
+			fall_asleep(rigid_body);
+			sleep_islands_.push_back({ entity });
+		}
+	}
+
+	// Islands fall asleep once every member has been resting for long enough.
+	island_sleep_times_.assign(static_objects_.size(), std::numeric_limits<float>::infinity());
+	for (std::uint32_t index{ 0 }; index < static_objects_.size(); ++index) {
+		const auto& entity{ static_objects_[index].entity };
+		if (!entity.IsAlive() || !entity.Has<RigidBody>()) {
 			continue;
 		}
+		const auto& rigid_body{ entity.Get<RigidBody>() };
+		auto& island_time{ island_sleep_times_[FindIsland(index)] };
+		island_time = std::min(
+			island_time, rigid_body.sleeping_ ? time_to_sleep : rigid_body.sleep_time_
+		);
+	}
 
-		if (const auto scripts{ entity1.TryGet<Scripts>() }) {
-			bool can_collide{
-				scripts->ConditionCheck(&CollisionScript::PreCollisionCheck, entity2)
-			};
-			if (can_collide) {
-				collideables.emplace_back(entity2);
-			}
-		} else {
-			collideables.emplace_back(entity2);
+	constexpr auto no_slot{ std::numeric_limits<std::uint32_t>::max() };
+	island_slots_.assign(static_objects_.size(), no_slot);
+	for (std::uint32_t index{ 0 }; index < static_objects_.size(); ++index) {
+		Entity entity{ static_objects_[index].entity };
+		if (!entity.IsAlive() || !entity.Has<RigidBody>()) {
+			continue;
+		}
+		auto& rigid_body{ entity.Get<RigidBody>() };
+		auto island{ FindIsland(index) };
+		if (rigid_body.sleeping_ || island_sleep_times_[island] < time_to_sleep) {
+			continue;
+		}
+		auto& slot{ island_slots_[island] };
+		if (slot == no_slot) {
+			slot = static_cast<std::uint32_t>(sleep_islands_.size());
+			sleep_islands_.emplace_back();
 		}
+		sleep_islands_[slot].emplace_back(entity);
+		fall_asleep(rigid_body);
 	}
+}
 
-	return collideables;
+std::size_t CollisionHandler::ContactKeyHash::operator()(const ContactKey& key) const {
+	// Symmetric so that both orders of the pair hash to the same value.
+	return key.first.GetHash() + key.second.GetHash();
 }
 
-std::vector<CollisionHandler::SweepCollision> CollisionHandler::GetSortedCollisions(
-	Entity& entity1, const V2_float& offset, const V2_float& velocity1, float dt
-) const {
-	auto static_collideables{ GetSweepCandidates(entity1, velocity1, static_tree_) };
-	auto dynamic_collideables{ GetSweepCandidates(entity1, velocity1, dynamic_tree_) };
+// Queues an overlap callback for the entity if it is an overlap collider with scripts.
+static void AddOverlapAction(Entity entity, void (OverlapScript::*func)(Entity), Entity other) {
+	if (!entity.IsAlive() || !entity.Has<Collider, Scripts>()) {
+		return;
+	}
+	if (entity.Get<Collider>().mode != CollisionMode::Overlap) {
+		return;
+	}
+	entity.Get<Scripts>().AddAction(func, other);
+}
 
-	auto collideables{ ConcatenateVectors(static_collideables, dynamic_collideables) };
+void CollisionHandler::AddContact(const Entity& entity1, const Entity& entity2) {
+	auto [it, inserted] = contact_indices_.try_emplace(ContactKey{ entity1, entity2 });
+	if (!inserted) {
+		contacts_[it->second].frame = frame_;
+		AddOverlapAction(entity1, &OverlapScript::OnOverlap, entity2);
+		AddOverlapAction(entity2, &OverlapScript::OnOverlap, entity1);
+		return;
+	}
+	it->second = static_cast<std::uint32_t>(contacts_.size());
+	contacts_.push_back({ ContactKey{ entity1, entity2 }, frame_ });
+	AddOverlapAction(entity1, &OverlapScript::OnOverlapStart, entity2);
+	AddOverlapAction(entity2, &OverlapScript::OnOverlapStart, entity1);
+}
 
-	VectorRemoveDuplicates(collideables);
+void CollisionHandler::RemoveStaleContacts() {
+	for (std::size_t i{ 0 }; i < contacts_.size();) {
+		const auto contact{ contacts_[i] };
+		if (contact.frame == frame_) {
+			++i;
+			continue;
+		}
 
-	std::vector<SweepCollision> collisions;
+		AddOverlapAction(contact.key.first, &OverlapScript::OnOverlapStop, contact.key.second);
+		AddOverlapAction(contact.key.second, &OverlapScript::OnOverlapStop, contact.key.first);
 
-	for (const auto& entity2 : collideables) {
-		if (entity1 == entity2) {
-			continue;
+		contact_indices_.erase(contact.key);
+		if (i + 1 != contacts_.size()) {
+			contacts_[i] = contacts_.back();
+			contact_indices_.at(contacts_[i].key) = static_cast<std::uint32_t>(i);
 		}
+		contacts_.pop_back();
+	}
+}
 
-		auto t1{ GetAbsoluteTransform(entity1) };
-		auto t2{ GetAbsoluteTransform(entity2) };
+void CollisionHandler::GatherSweepCandidates(std::uint32_t index, const V2_float& velocity) {
+	Entity entity1{ static_objects_[index].entity };
 
-		Transform offset_transform{ t1 };
-		offset_transform.Translate(offset);
+	const auto& collider1{ entity1.Get<Collider>() };
+
+	auto bounding_aabb{ GetBoundingAABB(collider1.shape, GetColliderTransform(index)) };
+
+	sweep_candidates_.clear();
+	static_tree_->Raycast(entity1, velocity, bounding_aabb, sweep_candidates_);
+	dynamic_tree_->Raycast(entity1, velocity, bounding_aabb, sweep_candidates_);
+	swept_tree_.Raycast(entity1, velocity, bounding_aabb, sweep_candidates_);
+
+	VectorRemoveDuplicates(sweep_candidates_);
+
+	const auto scripts{ entity1.TryGet<Scripts>() };
+
+	std::erase_if(sweep_candidates_, [&](const Entity& entity2) {
+		PTGN_ASSERT(entity2 != entity1);
+
+		if (!entity2.Has<Collider>()) {
+			return true;
+		}
 
-		const auto& collider1{ entity1.Get<Collider>() };
 		const auto& collider2{ entity2.Get<Collider>() };
 
-		auto transform1{ OffsetByOrigin(collider1.shape, offset_transform, entity1) };
-		auto transform2{ OffsetByOrigin(collider2.shape, t2, entity2) };
+		if (collider2.mode == CollisionMode::None || collider2.mode == CollisionMode::Overlap) {
+			return true;
+		}
+
+		if (!CanCollide(entity1, collider1, entity2, collider2)) {
+			return true;
+		}
+
+		return scripts && !scripts->ConditionCheck(&CollisionScript::PreCollisionCheck, entity2);
+	});
+}
+
+void CollisionHandler::FindSweepCollisions(
+	std::uint32_t index, const V2_float& offset, const V2_float& velocity1, float dt,
+	std::vector<SweepCollision>& collisions
+) {
+	GatherSweepCandidates(index, velocity1);
+
+	Entity entity1{ static_objects_[index].entity };
+
+	const auto& collider1{ entity1.Get<Collider>() };
+
+	Transform transform1{ GetColliderTransform(index) };
+	transform1.Translate(offset);
+
+	for (const auto& entity2 : sweep_candidates_) {
+		auto it{ object_indices_.find(entity2) };
+		PTGN_ASSERT(it != object_indices_.end(), "Sweep candidate is missing a collider");
+
+		const auto& collider2{ entity2.Get<Collider>() };
+		const auto& transform2{ GetColliderTransform(it->second) };
 
 		auto relative_velocity{ GetRelativeVelocity(velocity1, entity2, dt) };
 
@@ -315,114 +763,94 @@ std::vector<CollisionHandler::SweepCollision> CollisionHandler::GetSortedCollisi
 			continue;
 		}
 
-		auto center1{ transform1.GetPosition() };
-		auto center2{ transform2.GetPosition() };
-		V2_float center_dist{ center1 - center2 };
-		float dist2{ center_dist.MagnitudeSquared() };
-		collisions.emplace_back(raycast, dist2, entity2);
+		V2_float center_dist{ transform1.GetPosition() - transform2.GetPosition() };
+		collisions.emplace_back(raycast, center_dist.MagnitudeSquared(), entity2);
 	}
-
-	SortCollisions(collisions);
-
-	return collisions;
 }
 
-void CollisionHandler::Sweep(Entity& entity, float dt) {
-	PTGN_ASSERT(entity.Has<Collider>());
-	PTGN_ASSERT(entity.Get<Collider>().mode == CollisionMode::Continuous);
-	PTGN_ASSERT(entity.Has<RigidBody>());
+void CollisionHandler::Sweep(float dt) {
+	sweep_bodies_.clear();
+	sweep_collisions_.clear();
+	swept_tree_.Build({});
 
-	[[maybe_unused]] std::size_t iterations{ 0 };
+	// Entities moved out of intersections must be swept against where they are now.
+	ApplyBroadphaseUpdates();
 
-	V2_float offset;
-
-	bool raycast_hit{ false };
+	// Times of impact of all bodies are computed against the velocities from the start of the
+	// stage, so the order of the bodies does not affect which collisions are found.
+	for (std::uint32_t index{ 0 }; index < static_objects_.size(); ++index) {
+		const auto& entity{ static_objects_[index].entity };
+		if (!entity.Has<Collider, RigidBody>() ||
+			entity.Get<Collider>().mode != CollisionMode::Continuous) {
+			continue;
+		}
 
-	do {
 		auto velocity{ entity.Get<RigidBody>().velocity * dt };
 
 		if (velocity.IsZero()) {
-			break;
+			continue;
 		}
 
-		auto collisions{ GetSortedCollisions(entity, offset, velocity, dt) };
+		SweepBody body{ index, velocity, sweep_collisions_.size(), 0 };
+		FindSweepCollisions(index, {}, velocity, dt, sweep_collisions_);
+		body.end = sweep_collisions_.size();
 
-		if (collisions.empty()) {
-			break;
+		if (body.begin != body.end) {
+			sweep_bodies_.emplace_back(body);
 		}
+	}
 
-		raycast_hit = true;
-
-		// no collisions occured.
-		// TODO: Fix or get rid of.
-		/*if (debug_draw) {
-			DrawDebugLine(transform.position, velocity, color::Gray);
-		}*/
-		auto earliest{ collisions.front().collision };
-
-		// TODO: Fix or get rid of.
-		/*if (debug_draw) {
-			DrawDebugLine(transform.position, velocity * earliest.t, color::Blue);
-			if constexpr (std::is_same_v<T, BoxCollider>) {
-				Rect rect{ transform.position + velocity * earliest.t, collider.size,
-						   collider.origin };
-				rect.Draw(color::Purple);
-			} else if constexpr (std::is_same_v<T, CircleCollider>) {
-				Circle circle{ transform.position + velocity * earliest.t, collider.radius };
-				circle.Draw(color::Purple);
-			}
-		}*/
+	for (const auto& body : sweep_bodies_) {
+		ResolveSweep(body, dt);
+	}
+}
 
-		AddEarliestCollisions(entity, collisions);
+void CollisionHandler::ResolveSweep(const SweepBody& body, float dt) {
+	PTGN_ASSERT(dt > 0.0f);
 
-		entity.Get<RigidBody>().velocity *= earliest.t;
+	Entity entity{ static_objects_[body.index].entity };
 
-		auto new_velocity{
-			GetRemainingVelocity(velocity, earliest, entity.Get<Collider>().response)
-		};
+	std::span<SweepCollision> collisions{ sweep_collisions_.begin() + body.begin,
+										  sweep_collisions_.begin() + body.end };
 
-		if (new_velocity.IsZero()) {
-			break;
-		}
+	SelectEarliestCollisions(collisions);
 
-		offset += velocity * earliest.t;
+	// Bodies hit by a continuous collider are woken up.
+	if (auto it{ object_indices_.find(collisions.front().entity) }; it != object_indices_.end()) {
+		WakeBody(it->second);
+	}
 
-		auto collisions2{ GetSortedCollisions(entity, offset, new_velocity, dt) };
+	auto earliest{ collisions.front().collision };
 
-		PTGN_ASSERT(dt > 0.0f);
+	AddEarliestCollisions(entity, collisions);
 
-		if (collisions2.empty()) {
-			// TODO: Fix or get rid of.
-			/*if (debug_draw) {
-				DrawDebugLine(
-					transform.position + velocity * earliest.t, new_velocity, color::Orange
-				);
-			}*/
+	entity.Get<RigidBody>().velocity *= earliest.t;
 
-			entity.Get<RigidBody>().AddImpulse(new_velocity / dt);
-			break;
-		}
-
-		auto earliest2{ collisions2.front().collision };
+	auto new_velocity{
+		GetRemainingVelocity(body.velocity, earliest, entity.Get<Collider>().response)
+	};
 
-		// TODO: Fix or get rid of.
-		/*if (debug_draw) {
-			DrawDebugLine(
-				transform.position + velocity * earliest.t, new_velocity * earliest2.t, color::Green
-			);
-		}*/
+	if (!new_velocity.IsZero()) {
+		// Second sweep in the direction of the remaining velocity.
+		remaining_sweep_collisions_.clear();
+		FindSweepCollisions(
+			body.index, body.velocity * earliest.t, new_velocity, dt, remaining_sweep_collisions_
+		);
 
-		AddEarliestCollisions(entity, collisions2);
+		if (remaining_sweep_collisions_.empty()) {
+			entity.Get<RigidBody>().AddImpulse(new_velocity / dt);
+		} else {
+			SelectEarliestCollisions(remaining_sweep_collisions_);
 
-		entity.Get<RigidBody>().AddImpulse(new_velocity / dt * earliest2.t);
+			auto earliest2{ remaining_sweep_collisions_.front().collision };
 
-		iterations++;
-	} while (false /*TODO: Consider readding: iterations < max_sweep_iterations_*/);
+			AddEarliestCollisions(entity, remaining_sweep_collisions_);
 
-	if (raycast_hit) {
-		// TODO: Check if this is even needed.
-		UpdateKDTree(entity, dt);
+			entity.Get<RigidBody>().AddImpulse(new_velocity / dt * earliest2.t);
+		}
 	}
+
+	swept_tree_.Insert(entity, UpdateKDTree(entity, dt));
 }
 
 V2_float CollisionHandler::GetRelativeVelocity(
@@ -437,7 +865,7 @@ V2_float CollisionHandler::GetRelativeVelocity(
 }
 
 void CollisionHandler::AddEarliestCollisions(
-	Entity& entity, const std::vector<SweepCollision>& sweep_collisions
+	Entity& entity, std::span<const SweepCollision> sweep_collisions
 ) {
 	PTGN_ASSERT(!sweep_collisions.empty());
 
@@ -470,29 +898,42 @@ void CollisionHandler::AddEarliestCollisions(
 	}
 };
 
-void CollisionHandler::SortCollisions(std::vector<SweepCollision>& collisions) {
+void CollisionHandler::SelectEarliestCollisions(std::span<SweepCollision> collisions) {
+	PTGN_ASSERT(!collisions.empty());
+
 	/*
-	 * Initial sort based on distances of collision manifolds to the collider.
-	 * This is required for RectVsRect collisions to prevent sticking
-	 * to corners in certain configurations, such as if the player (o) gives
-	 * a bottom right velocity into the following rectangle (x) configuration:
+	 * Collisions are ordered by collision time. If collision times are equal, walls are
+	 * prioritized over corners, i.e. normals (1,0) come before (1,1). Remaining ties are broken
+	 * by the distance of the collision manifolds to the collider. This is required for RectVsRect
+	 * collisions to prevent sticking to corners in certain configurations, such as if the player
+	 * (o) gives a bottom right velocity into the following rectangle (x) configuration:
 	 *       x
 	 *     o x
 	 *   x   x
-	 * (player would stay still instead of moving down if this distance sort did not exist).
+	 * (player would stay still instead of moving down if this distance ordering did not exist).
+	 * Only the earliest collisions are used, so a linear selection replaces a full sort.
 	 */
-	std::ranges::sort(collisions, [](const SweepCollision& a, const SweepCollision& b) {
-		return a.dist2 < b.dist2;
-	});
-	// Sort based on collision times, and if they are equal, by collision normal magnitudes.
-	std::ranges::sort(collisions, [](const SweepCollision& a, const SweepCollision& b) {
-		// If time of collision are equal, prioritize walls to corners, i.e. normals
-		// (1,0) come before (1,1).
-		if (a.collision.t == b.collision.t) {
-			return a.collision.normal.MagnitudeSquared() < b.collision.normal.MagnitudeSquared();
+	auto earliest{ std::ranges::min_element(
+		collisions,
+		[](const SweepCollision& a, const SweepCollision& b) {
+			if (a.collision.t != b.collision.t) {
+				return a.collision.t < b.collision.t;
+			}
+			auto a_normal{ a.collision.normal.MagnitudeSquared() };
+			auto b_normal{ b.collision.normal.MagnitudeSquared() };
+			if (a_normal != b_normal) {
+				return a_normal < b_normal;
+			}
+			return a.dist2 < b.dist2;
 		}
-		// If collision times are not equal, sort by collision time.
-		return a.collision.t < b.collision.t;
+	) };
+
+	std::iter_swap(collisions.begin(), earliest);
+
+	float t{ collisions.front().collision.t };
+
+	std::ranges::partition(collisions.subspan(1), [t](const SweepCollision& collision) {
+		return collision.collision.t == t;
 	});
 }
 
@@ -529,75 +970,35 @@ V2_float CollisionHandler::GetRemainingVelocity(
 }
 
 void CollisionHandler::Update(Scene& scene) {
-	std::vector<KDObject> objects;
-	std::vector<KDObject> dynamic_objects;
+	PTGN_FRAME_SCOPE("CollisionHandler::Update");
 
-	float dt{ game.dt() };
+	float dt{ scene.physics.dt() };
 
-	for (auto [entity, collider] : scene.EntitiesWith<Collider>()) {
-		collider.ResetContainers();
-		auto transform{ GetAbsoluteTransform(entity) };
-		transform = OffsetByOrigin(collider.shape, transform, entity);
-		auto bounding_aabb{ GetBoundingAABB(collider.shape, transform) };
-		objects.emplace_back(entity, bounding_aabb);
-		if (entity.Has<RigidBody>()) {
-			const auto& rb{ entity.Get<RigidBody>() };
-			auto velocity{ rb.velocity * dt };
-			auto expanded_aabb{ bounding_aabb.ExpandByVelocity(velocity) };
-			dynamic_objects.emplace_back(entity, expanded_aabb);
-		}
-	}
+	++frame_;
 
-	static_tree_.Build(objects);
-	dynamic_tree_.Build(dynamic_objects);
+	// Bodies woken up since the last update wake the rest of their island before any collisions
+	// are skipped.
+	WakeIslands();
 
-	for (auto& object : objects) {
-		const auto& collider{ object.entity.Get<Collider>() };
-		switch (collider.mode) {
-			case CollisionMode::Discrete: {
-				Intersect(object.entity, dt);
-				break;
-			}
-			case CollisionMode::Overlap: {
-				Overlap(object.entity);
-				break;
-			}
-			case CollisionMode::Continuous: {
-				if (!object.entity.Has<RigidBody>()) {
-					break;
-				}
-				// Ensure the collider does not start within an object (at least most of the time).
-				Intersect(object.entity, dt);
-				Sweep(object.entity, dt);
-				break;
-			}
-			case CollisionMode::None: {
-				break;
-			}
-			default: PTGN_ERROR("Unknown collision mode")
-		}
-	}
+	UpdateBroadphase(scene, dt);
 
-	for (auto [entity, collider, scripts] : scene.EntitiesWith<Collider, Scripts>()) {
-		if (collider.mode != CollisionMode::Overlap) {
-			continue;
-		}
-		for (const auto& current : collider.overlaps_) {
-			PTGN_ASSERT(current != entity);
-			if (!VectorContains(collider.previous_overlaps_, current)) {
-				scripts.AddAction(&OverlapScript::OnOverlapStart, current);
-			}
-		}
-		for (const auto& previous : collider.previous_overlaps_) {
-			PTGN_ASSERT(previous != entity);
-			if (!VectorContains(collider.overlaps_, previous)) {
-				scripts.AddAction(&OverlapScript::OnOverlapStop, previous);
-			} else {
-				scripts.AddAction(&OverlapScript::OnOverlap, previous);
-			}
-		}
+	FindCandidatePairs();
+
+	ComputePairResults();
+
+	for (std::size_t pair{ 0 }; pair < candidate_pairs_.size(); ++pair) {
+		ProcessPair(pair, dt);
 	}
 
+	Sweep(dt);
+
+	// Raycasts and queries made after the collision update see the resolved positions and
+	// velocities.
+	ApplyBroadphaseUpdates();
+
+	// Overlaps which were not detected this frame have stopped.
+	RemoveStaleContacts();
+
 	for (auto [entity, collider, scripts] : scene.EntitiesWith<Collider, Scripts>()) {
 		scripts.InvokeActions();
 	}
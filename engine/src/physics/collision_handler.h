@@ -1,16 +1,29 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "core/ecs/components/transform.h"
 #include "core/ecs/entity.h"
+#include "core/utils/thread_pool.h"
+#include "core/utils/thread_stats.h"
+#include "math/intersect.h"
 #include "math/raycast.h"
 #include "math/vector2.h"
+#include "physics/bounding_aabb.h"
 #include "physics/broadphase.h"
 #include "physics/collider.h"
+#include "physics/dynamic_aabb_tree.h"
 
 namespace ptgn {
 
 class Scene;
+class Physics;
 
 namespace impl {
 
@@ -31,19 +44,144 @@ public:
 		const Collider& collider2
 	);
 
+	// @return Number of broadphase rebuilds and refits performed during the most recent update.
+	[[nodiscard]] const BroadphaseStats& GetBroadphaseStats() const;
+
+	// Replaces the data structure used to find collision candidates. The new broadphase is
+	// populated during the next collision update.
+	// @param cell_size Side length of the grid cells of BroadphaseType::SpatialHash. Should be
+	// close to the typical collider size. Ignored by the other broadphase types.
+	void SetBroadphase(BroadphaseType type, float cell_size = 64.0f);
+
+	[[nodiscard]] BroadphaseType GetBroadphaseType() const;
+
+	// Sets the number of threads which test candidate pairs for collisions. Collision responses
+	// and script callbacks are always applied on the calling thread in a fixed order, so the
+	// results do not depend on the thread count.
+	// @param thread_count 1 runs the narrowphase on the calling thread, 0 uses the hardware
+	// concurrency.
+	void SetNarrowphaseThreadCount(std::size_t thread_count);
+
+	[[nodiscard]] std::size_t GetNarrowphaseThreadCount() const;
+
 private:
 	friend class Game;
 	friend class Physics;
 	friend class ptgn::Scene;
 
-	void Overlap(Entity& entity) const;
+	// Pair of overlapping entities. Equal regardless of the order of the entities.
+	struct ContactKey {
+		Entity first;
+		Entity second;
+
+		friend bool operator==(const ContactKey& a, const ContactKey& b) {
+			return (a.first == b.first && a.second == b.second) ||
+				   (a.first == b.second && a.second == b.first);
+		}
+	};
+
+	struct ContactKeyHash {
+		[[nodiscard]] std::size_t operator()(const ContactKey& key) const;
+	};
+
+	struct Contact {
+		ContactKey key;
+		// Value of frame_ when the overlap was last detected.
+		std::uint64_t frame{ 0 };
+	};
+
+	struct CachedTransform {
+		Transform transform;
+		// Value of transform_generation_ when the transform was computed.
+		std::uint64_t generation{ 0 };
+	};
+
+	// Collider as currently stored in the trees.
+	struct BroadphaseEntry {
+		// Absolute transform of the collider, offset by its origin.
+		Transform transform;
+		BoundingAABB aabb;
+		// Value of broadphase_stamp_ when the collider was last gathered.
+		std::uint64_t stamp{ 0 };
+		// Collider is stored in the dynamic tree.
+		bool dynamic{ false };
+	};
+
+	// Sleep state of a collider during the current frame.
+	enum class BodyState : std::uint8_t {
+		// Collider without a rigid body which has not moved this frame.
+		Static,
+		Moving,
+		// Collider with a sleeping rigid body.
+		Sleeping
+	};
+
+	// Narrowphase result of a candidate pair computed ahead of time by the thread pool.
+	struct PairResult {
+		Intersection intersection;
+		bool occurred{ false };
+		// Both colliders could collide, so the result is valid.
+		bool computed{ false };
+	};
+
+	// Gathers the overlapping pairs reported by the broadphase as sorted pairs of indices into
+	// static_objects_.
+	void FindCandidatePairs();
+
+	// @return Absolute transform of the collider at index, offset by its origin. Only recomputed
+	// after a collision resolution moved an entity.
+	[[nodiscard]] const Transform& GetColliderTransform(std::uint32_t index);
+
+	// Tests every candidate pair across the thread pool using the transforms from the start of
+	// the frame. Only reads collider state, so the entity manager is never accessed concurrently.
+	void ComputePairResults();
+
+	// @return Result of ComputePairResults() for the candidate pair, or nullptr if it was not
+	// computed or one of its entities has since been moved by a collision response.
+	[[nodiscard]] const PairResult* GetPairResult(std::size_t pair) const;
+
+	// @return State of the collider, waking its rigid body if its transform was modified.
+	[[nodiscard]] static BodyState GetBodyState(Entity& entity);
+
+	// @return True if neither collider of an intersect pair moved and at least one is asleep, in
+	// which case the pair is not tested.
+	[[nodiscard]] bool IsRestingPair(std::size_t pair) const;
+
+	// Wakes the rigid body of the collider at index if it is sleeping.
+	void WakeBody(std::uint32_t index);
+
+	// @return Index of the collider which represents the island containing the collider at index.
+	[[nodiscard]] std::uint32_t FindIsland(std::uint32_t index);
 
-	void Intersect(Entity& entity, float dt);
+	void MergeIslands(std::uint32_t index1, std::uint32_t index2);
 
-	[[nodiscard]] static std::vector<Entity> GetSweepCandidates(
-		Entity& entity1, const V2_float& velocity, const KDTree& tree
+	// Wakes every sleeping island which has a member that was woken up or destroyed.
+	void WakeIslands();
+
+	// Advances the sleep timers of resting rigid bodies and puts islands of bodies which have all
+	// been resting for long enough to sleep. Must be called after the rigid bodies were moved.
+	void UpdateSleep(Scene& scene, const ptgn::Physics& physics, float dt);
+
+	// Runs the narrowphase once for the candidate pair at the given index.
+	void ProcessPair(std::size_t pair, float dt);
+
+	void Overlap(std::size_t pair);
+
+	void Intersect(std::size_t pair, float dt);
+
+	// Moves the root of the entity out of a discrete collision.
+	void Resolve(
+		const Entity& entity, const V2_float& normal, float depth, CollisionResponse response,
+		float dt
 	);
 
+	// Marks the pair as overlapping this frame and queues the overlap start or overlap callbacks.
+	void AddContact(const Entity& entity1, const Entity& entity2);
+
+	// Removes contacts which were not overlapping this frame and queues their overlap stop
+	// callbacks.
+	void RemoveStaleContacts();
+
 	struct SweepCollision {
 		SweepCollision() = default;
 
@@ -57,22 +195,41 @@ private:
 		float dist2{ 0.0f };
 	};
 
-	[[nodiscard]] std::vector<SweepCollision> GetSortedCollisions(
-		Entity& entity1, const V2_float& offset, const V2_float& velocity1, float dt
-	) const;
+	// Continuous collider whose time of impact was computed during the batched sweep stage.
+	struct SweepBody {
+		std::uint32_t index{ 0 };
+		// Velocity of the body at the start of the sweep stage, multiplied by dt.
+		V2_float velocity;
+		// Range of the body's collisions in sweep_collisions_.
+		std::size_t begin{ 0 };
+		std::size_t end{ 0 };
+	};
+
+	// Appends the colliders which the collider at index may hit while moving with the given
+	// velocity to sweep_candidates_.
+	void GatherSweepCandidates(std::uint32_t index, const V2_float& velocity);
 
+	// Appends the collisions of the collider at index moving with the given velocity to
+	// collisions. Does not allocate once the scratch buffers have grown to fit.
 	// @param offset Offset from the transform position of the entity. This enables doing a second
 	// sweep.
-	// @param vel Velocity of the entity. As above, this enables a second sweep in the direction of
-	// the remaining velocity.
+	// @param velocity1 Velocity of the entity. As above, this enables a second sweep in the
+	// direction of the remaining velocity.
+	void FindSweepCollisions(
+		std::uint32_t index, const V2_float& offset, const V2_float& velocity1, float dt,
+		std::vector<SweepCollision>& collisions
+	);
 
 	// Adds all collisions which occurred at the earliest time to box.collisions. This ensures all
 	// callbacks are called.
+	// @param sweep_collisions Must be ordered by SelectEarliestCollisions().
 	static void AddEarliestCollisions(
-		Entity& entity, const std::vector<SweepCollision>& sweep_collisions
+		Entity& entity, std::span<const SweepCollision> sweep_collisions
 	);
 
-	static void SortCollisions(std::vector<SweepCollision>& collisions);
+	// Moves the earliest collision to the front, followed by the other collisions which occurred
+	// at the same time. The remaining collisions are left in no particular order.
+	static void SelectEarliestCollisions(std::span<SweepCollision> collisions);
 
 	[[nodiscard]] static V2_float GetRemainingVelocity(
 		const V2_float& velocity, const RaycastResult& collision, CollisionResponse response
@@ -82,18 +239,102 @@ private:
 		const V2_float& velocity1, const Entity& entity2, float dt
 	);
 
-	void UpdateKDTree(const Entity& entity, float dt);
+	// Marks the bounding volumes of an entity which was moved during collision resolution as
+	// dirty. The trees are not touched until the next ApplyBroadphaseUpdates().
+	// @return Bounding AABB of the entity, expanded by its velocity if it has a rigid body.
+	BoundingAABB UpdateKDTree(const Entity& entity, float dt);
+
+	// Applies the bounding volumes marked dirty by UpdateKDTree() to both trees, so that
+	// subsequent queries see where resolved entities are now.
+	void ApplyBroadphaseUpdates();
 
-	// Updates the velocity of the object to prevent it from colliding with the target objects.
-	void Sweep(Entity& entity, float dt);
+	// Gathers the colliders of the scene and applies the bounding volumes which changed, as well
+	// as added and removed colliders, to each tree in a single update (one rebuild or refit per
+	// tree). Sleeping bodies keep their transform and tree entries without being recomputed, so
+	// changes to the collider shape of a sleeping body take effect once it wakes up.
+	void UpdateBroadphase(Scene& scene, float dt);
+
+	// Computes the time of impact of every continuous collider with a rigid body in a single
+	// pass, then updates their velocities in order to prevent them from tunnelling through other
+	// colliders.
+	void Sweep(float dt);
+
+	// Updates the velocity of the body using its earliest collisions.
+	void ResolveSweep(const SweepBody& body, float dt);
 
 	void Update(Scene& scene);
 
-	KDTree static_tree_{ 100 };
-	KDTree dynamic_tree_{ 100 };
+	BroadphaseType broadphase_type_{ BroadphaseType::KDTree };
+	float cell_size_{ 64.0f };
+
+	std::unique_ptr<Broadphase> static_tree_{ std::make_unique<KDTree>(100) };
+	std::unique_ptr<Broadphase> dynamic_tree_{ std::make_unique<KDTree>(100) };
+
+	// Bounding volumes gathered during the current frame. Kept to reuse their capacity.
+	std::vector<KDObject> static_objects_;
+
+	// Colliders stored in the trees, persisting across frames.
+	std::unordered_map<Entity, BroadphaseEntry> broadphase_entries_;
+	std::uint64_t broadphase_stamp_{ 0 };
+
+	// Index of each collider entity in static_objects_.
+	std::unordered_map<Entity, std::uint32_t> object_indices_;
+
+	// Transforms of the colliders in static_objects_, computed while gathering bounding volumes.
+	std::vector<CachedTransform> collider_transforms_;
+	std::uint64_t transform_generation_{ 0 };
+
+	// Broadphase pairs of the current frame. Kept to reuse their capacity.
+	std::vector<BroadphasePair> pairs_;
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> candidate_pairs_;
+
+	// Only used when the narrowphase runs on multiple threads. Colliders and root entities are
+	// indexed like static_objects_.
+	std::unique_ptr<ThreadPool> thread_pool_;
+	std::vector<const Collider*> object_colliders_;
+	std::vector<Entity> object_roots_;
+	std::vector<PairResult> pair_results_;
+	std::unordered_set<Entity> moved_roots_;
+	// Debug counters of each narrowphase thread, merged into the calling thread's counters once
+	// every thread has finished.
+	std::vector<Stats> thread_stats_;
+
+	// Overlapping pairs persist across frames so that overlap callbacks can be dispatched without
+	// comparing the overlaps of every collider to the previous frame.
+	std::vector<Contact> contacts_;
+	std::unordered_map<ContactKey, std::uint32_t, ContactKeyHash> contact_indices_;
+	std::uint64_t frame_{ 0 };
+
+	// Sleep state of each collider in static_objects_.
+	std::vector<BodyState> object_states_;
+
+	// Union-find forest of colliders with movable rigid bodies which intersected this frame.
+	// Bodies in the same island only fall asleep together.
+	std::vector<std::uint32_t> island_parents_;
+
+	// Minimum sleep time and members of each island, indexed by its representative collider.
+	// Kept to reuse their capacity.
+	std::vector<float> island_sleep_times_;
+	std::vector<std::uint32_t> island_slots_;
+
+	// Members of each sleeping island. The whole island wakes up when any member does.
+	std::vector<std::vector<Entity>> sleep_islands_;
+
+	// Scratch buffers of the sweep stage, kept to reuse their capacity.
+	std::vector<SweepBody> sweep_bodies_;
+	std::vector<SweepCollision> sweep_collisions_;
+	std::vector<SweepCollision> remaining_sweep_collisions_;
+	std::vector<Entity> sweep_candidates_;
+	// Motion of the bodies whose velocity was changed by ResolveSweep() after the trees were last
+	// updated, which the trees may not cover. Rebuilt every sweep stage.
+	DynamicAABBTree swept_tree_;
+
+	BroadphaseStats broadphase_stats_;
 
 	constexpr static float slop_{ 0.0005f };
-	constexpr static std::size_t max_sweep_iterations_{ 4 };
+
+	// Fewer pairs than this per thread are not worth the cost of waking the workers.
+	constexpr static std::size_t min_pairs_per_thread_{ 64 };
 };
 
 } // namespace impl
@@ -0,0 +1,489 @@
+#include "physics/dynamic_aabb_tree.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "core/ecs/components/transform.h"
+#include "core/ecs/entity.h"
+#include "debug/runtime/assert.h"
+#include "math/geometry/rect.h"
+#include "math/raycast.h"
+#include "math/vector2.h"
+#include "physics/bounding_aabb.h"
+#include "physics/broadphase.h"
+
+namespace ptgn {
+
+namespace impl {
+
+DynamicAABBTree::DynamicAABBTree(float margin) : margin_{ margin } {
+	PTGN_ASSERT(margin_ >= 0.0f, "Dynamic AABB tree margin cannot be negative");
+}
+
+void DynamicAABBTree::Build(const std::vector<KDObject>& objects) {
+	// Capacity of the node array is retained.
+	nodes_.clear();
+	leaves_.clear();
+	root_	   = null_node_;
+	free_list_ = null_node_;
+
+	for (const auto& object : objects) {
+		Insert(object.entity, object.aabb);
+	}
+
+	changed_ = false;
+	++stats_.rebuilds;
+}
+
+void DynamicAABBTree::UpdateBoundingAABB(const Entity& e, const BoundingAABB& aabb) {
+	auto it{ leaves_.find(e) };
+	if (it == leaves_.end()) {
+		Insert(e, aabb);
+		return;
+	}
+	MoveLeaf(it->second, aabb);
+}
+
+void DynamicAABBTree::Insert(const Entity& e, const BoundingAABB& aabb) {
+	if (auto it{ leaves_.find(e) }; it != leaves_.end()) {
+		MoveLeaf(it->second, aabb);
+		return;
+	}
+
+	std::int32_t leaf{ AllocateNode() };
+	Node& node{ nodes_[static_cast<std::size_t>(leaf)] };
+	node.entity = e;
+	node.aabb	= aabb;
+	node.bounds = aabb.Expand(margin_);
+	node.stamp	= stamp_;
+
+	leaves_.emplace(e, leaf);
+	InsertLeaf(leaf);
+	changed_ = true;
+}
+
+void DynamicAABBTree::Remove(const Entity& e) {
+	auto it{ leaves_.find(e) };
+	if (it == leaves_.end()) {
+		return;
+	}
+	RemoveLeaf(it->second);
+	FreeNode(it->second);
+	leaves_.erase(it);
+	changed_ = true;
+}
+
+void DynamicAABBTree::EndFrameUpdate() {
+	if (!changed_) {
+		return;
+	}
+	changed_ = false;
+	++stats_.refits;
+}
+
+void DynamicAABBTree::Update(const std::vector<KDObject>& objects) {
+	++stamp_;
+
+	for (const auto& object : objects) {
+		UpdateBoundingAABB(object.entity, object.aabb);
+	}
+
+	// Every entity in the tree was provided, so nothing needs to be removed.
+	if (objects.size() != leaves_.size()) {
+		stale_.clear();
+		for (const auto& [e, leaf] : leaves_) {
+			if (nodes_[static_cast<std::size_t>(leaf)].stamp != stamp_) {
+				stale_.emplace_back(e);
+			}
+		}
+		for (const auto& e : stale_) {
+			Remove(e);
+		}
+	}
+
+	EndFrameUpdate();
+}
+
+const BroadphaseStats& DynamicAABBTree::GetStats() const {
+	return stats_;
+}
+
+void DynamicAABBTree::ResetStats() {
+	stats_ = {};
+}
+
+void DynamicAABBTree::FindPairs(std::vector<BroadphasePair>& pairs) const {
+	pairs.clear();
+	for (const auto& node : nodes_) {
+		if (node.height != 0) {
+			continue;
+		}
+		Traverse(
+			[&](const BoundingAABB& bounds) { return bounds.Overlaps(node.aabb); },
+			[&](const Node& leaf) {
+				// Only report each pair from the leaf which comes first in nodes_.
+				if (&leaf > &node && leaf.aabb.Overlaps(node.aabb)) {
+					pairs.push_back({ node.entity, leaf.entity });
+				}
+			}
+		);
+	}
+}
+
+std::vector<Entity> DynamicAABBTree::Query(const BoundingAABB& region) const {
+	std::vector<Entity> result;
+	Traverse(
+		[&](const BoundingAABB& bounds) { return bounds.Overlaps(region); },
+		[&](const Node& leaf) {
+			if (leaf.aabb.Overlaps(region)) {
+				result.emplace_back(leaf.entity);
+			}
+		}
+	);
+	return result;
+}
+
+std::vector<Entity> DynamicAABBTree::Query(const V2_float& point) const {
+	std::vector<Entity> result;
+	Traverse(
+		[&](const BoundingAABB& bounds) { return bounds.Overlaps(point); },
+		[&](const Node& leaf) {
+			if (leaf.aabb.Overlaps(point)) {
+				result.emplace_back(leaf.entity);
+			}
+		}
+	);
+	return result;
+}
+
+void DynamicAABBTree::Raycast(
+	const Entity& entity, const V2_float& dir, const BoundingAABB& aabb, std::vector<Entity>& hits
+) const {
+	Rect rect{ aabb.min, aabb.max };
+	Traverse(
+		[&](const BoundingAABB& bounds) {
+			float t_entry{ 0.0f };
+			return bounds.SweptOverlaps(aabb, dir, t_entry);
+		},
+		[&](const Node& leaf) {
+			if (leaf.entity == entity) {
+				return;
+			}
+			auto raycast{ RaycastRectRect(
+				dir, Transform{}, rect, Transform{}, Rect{ leaf.aabb.min, leaf.aabb.max }
+			) };
+			if (raycast.Occurred()) {
+				hits.emplace_back(leaf.entity);
+			}
+		}
+	);
+}
+
+Entity DynamicAABBTree::RaycastFirst(
+	const Entity& entity, const V2_float& dir, const BoundingAABB& aabb
+) const {
+	Entity closest_hit;
+	float closest_t{ 1.0f };
+
+	float t_root{ 0.0f };
+
+	if (root_ == null_node_ ||
+		!nodes_[static_cast<std::size_t>(root_)].bounds.SweptOverlaps(aabb, dir, t_root)) {
+		return closest_hit;
+	}
+
+	Rect rect{ aabb.min, aabb.max };
+
+	// Node indices paired with the fraction of dir at which the sweep enters them.
+	std::array<std::pair<std::int32_t, float>, max_stack_size_> stack;
+	std::size_t size{ 0 };
+	stack[size++] = { root_, t_root };
+
+	while (size > 0) {
+		auto [index, t_entry] = stack[--size];
+		// Subtrees which the sweep reaches after the closest hit so far cannot contain a closer
+		// hit.
+		if (t_entry >= closest_t) {
+			continue;
+		}
+		const Node& node{ nodes_[static_cast<std::size_t>(index)] };
+		if (node.IsLeaf()) {
+			if (node.entity == entity) {
+				continue;
+			}
+			auto raycast{ RaycastRectRect(
+				dir, Transform{}, rect, Transform{}, Rect{ node.aabb.min, node.aabb.max }
+			) };
+			if (raycast.Occurred() && raycast.t < closest_t) {
+				closest_t	= raycast.t;
+				closest_hit = node.entity;
+			}
+			continue;
+		}
+		float t1{ 0.0f };
+		float t2{ 0.0f };
+		bool hit1{ nodes_[static_cast<std::size_t>(node.child1)].bounds.SweptOverlaps(
+			aabb, dir, t1
+		) };
+		bool hit2{ nodes_[static_cast<std::size_t>(node.child2)].bounds.SweptOverlaps(
+			aabb, dir, t2
+		) };
+		PTGN_ASSERT(size + 2 <= stack.size(), "Dynamic AABB tree exceeded maximum height");
+		// Push the child which the sweep reaches last first, so that the nearer child is visited
+		// first and closest_t shrinks as early as possible.
+		if (hit1 && hit2 && t2 < t1) {
+			stack[size++] = { node.child1, t1 };
+			stack[size++] = { node.child2, t2 };
+		} else {
+			if (hit2) {
+				stack[size++] = { node.child2, t2 };
+			}
+			if (hit1) {
+				stack[size++] = { node.child1, t1 };
+			}
+		}
+	}
+
+	return closest_hit;
+}
+
+std::int32_t DynamicAABBTree::AllocateNode() {
+	std::int32_t index{ free_list_ };
+	if (index == null_node_) {
+		index = static_cast<std::int32_t>(nodes_.size());
+		nodes_.emplace_back();
+	} else {
+		free_list_ = nodes_[static_cast<std::size_t>(index)].parent;
+	}
+	Node& node{ nodes_[static_cast<std::size_t>(index)] };
+	node		= Node{};
+	node.height = 0;
+	return index;
+}
+
+void DynamicAABBTree::FreeNode(std::int32_t index) {
+	Node& node{ nodes_[static_cast<std::size_t>(index)] };
+	node		= Node{};
+	node.parent = free_list_;
+	free_list_	= index;
+}
+
+void DynamicAABBTree::MoveLeaf(std::int32_t leaf, const BoundingAABB& aabb) {
+	Node& node{ nodes_[static_cast<std::size_t>(leaf)] };
+	node.aabb  = aabb;
+	node.stamp = stamp_;
+
+	BoundingAABB fat{ aabb.Expand(margin_) };
+
+	// Most small movements stay within the fat bounds and require no change to the tree. Bounds
+	// which are far larger than needed (i.e. after the object shrank) are refit to keep queries
+	// tight.
+	if (node.bounds.Contains(aabb) && fat.Expand(4.0f * margin_).Contains(node.bounds)) {
+		return;
+	}
+
+	RemoveLeaf(leaf);
+	nodes_[static_cast<std::size_t>(leaf)].bounds = fat;
+	InsertLeaf(leaf);
+	changed_ = true;
+}
+
+void DynamicAABBTree::InsertLeaf(std::int32_t leaf) {
+	if (root_ == null_node_) {
+		root_ = leaf;
+
+		nodes_[static_cast<std::size_t>(leaf)].parent = null_node_;
+		return;
+	}
+
+	const BoundingAABB leaf_bounds{ nodes_[static_cast<std::size_t>(leaf)].bounds };
+
+	// Find the best sibling for the new leaf.
+	std::int32_t index{ root_ };
+	while (!nodes_[static_cast<std::size_t>(index)].IsLeaf()) {
+		const Node& node{ nodes_[static_cast<std::size_t>(index)] };
+
+		float perimeter{ node.bounds.GetPerimeter() };
+		float combined_perimeter{ node.bounds.Merge(leaf_bounds).GetPerimeter() };
+
+		// Cost of creating a new parent for this node and the new leaf.
+		float cost{ 2.0f * combined_perimeter };
+
+		// Minimum cost of pushing the leaf further down the tree.
+		float inheritance_cost{ 2.0f * (combined_perimeter - perimeter) };
+
+		const auto descend_cost = [&](std::int32_t child_index) {
+			const Node& child{ nodes_[static_cast<std::size_t>(child_index)] };
+			float merged{ leaf_bounds.Merge(child.bounds).GetPerimeter() };
+			if (child.IsLeaf()) {
+				return merged + inheritance_cost;
+			}
+			return merged - child.bounds.GetPerimeter() + inheritance_cost;
+		};
+
+		float cost1{ descend_cost(node.child1) };
+		float cost2{ descend_cost(node.child2) };
+
+		if (cost < cost1 && cost < cost2) {
+			break;
+		}
+
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	std::int32_t sibling{ index };
+
+	// Allocating may reallocate nodes_, so no node references are held across this call.
+	std::int32_t new_parent{ AllocateNode() };
+
+	Node& sibling_node{ nodes_[static_cast<std::size_t>(sibling)] };
+	Node& parent_node{ nodes_[static_cast<std::size_t>(new_parent)] };
+
+	std::int32_t old_parent{ sibling_node.parent };
+
+	parent_node.parent = old_parent;
+	parent_node.bounds = leaf_bounds.Merge(sibling_node.bounds);
+	parent_node.height = sibling_node.height + 1;
+	parent_node.child1 = sibling;
+	parent_node.child2 = leaf;
+
+	sibling_node.parent = new_parent;
+
+	nodes_[static_cast<std::size_t>(leaf)].parent = new_parent;
+
+	if (old_parent == null_node_) {
+		root_ = new_parent;
+	} else {
+		Node& old_parent_node{ nodes_[static_cast<std::size_t>(old_parent)] };
+		if (old_parent_node.child1 == sibling) {
+			old_parent_node.child1 = new_parent;
+		} else {
+			old_parent_node.child2 = new_parent;
+		}
+	}
+
+	RefitAncestors(new_parent);
+}
+
+void DynamicAABBTree::RemoveLeaf(std::int32_t leaf) {
+	if (leaf == root_) {
+		root_ = null_node_;
+		return;
+	}
+
+	std::int32_t parent{ nodes_[static_cast<std::size_t>(leaf)].parent };
+	const Node& parent_node{ nodes_[static_cast<std::size_t>(parent)] };
+	std::int32_t grandparent{ parent_node.parent };
+	std::int32_t sibling{ parent_node.child1 == leaf ? parent_node.child2 : parent_node.child1 };
+
+	// The sibling takes the place of the parent.
+	nodes_[static_cast<std::size_t>(sibling)].parent = grandparent;
+	FreeNode(parent);
+
+	if (grandparent == null_node_) {
+		root_ = sibling;
+		return;
+	}
+
+	Node& grandparent_node{ nodes_[static_cast<std::size_t>(grandparent)] };
+	if (grandparent_node.child1 == parent) {
+		grandparent_node.child1 = sibling;
+	} else {
+		grandparent_node.child2 = sibling;
+	}
+
+	RefitAncestors(grandparent);
+}
+
+void DynamicAABBTree::RefitAncestors(std::int32_t index) {
+	while (index != null_node_) {
+		index = Balance(index);
+
+		Node& node{ nodes_[static_cast<std::size_t>(index)] };
+		const Node& child1{ nodes_[static_cast<std::size_t>(node.child1)] };
+		const Node& child2{ nodes_[static_cast<std::size_t>(node.child2)] };
+
+		node.height = 1 + std::max(child1.height, child2.height);
+		node.bounds = child1.bounds.Merge(child2.bounds);
+
+		index = node.parent;
+	}
+}
+
+std::int32_t DynamicAABBTree::Balance(std::int32_t a) {
+	const Node& node{ nodes_[static_cast<std::size_t>(a)] };
+	if (node.IsLeaf() || node.height < 2) {
+		return a;
+	}
+
+	std::int32_t balance{ nodes_[static_cast<std::size_t>(node.child2)].height -
+						  nodes_[static_cast<std::size_t>(node.child1)].height };
+
+	if (balance > 1) {
+		return Rotate(a, node.child2);
+	}
+	if (balance < -1) {
+		return Rotate(a, node.child1);
+	}
+	return a;
+}
+
+std::int32_t DynamicAABBTree::Rotate(std::int32_t a, std::int32_t child) {
+	Node& node_a{ nodes_[static_cast<std::size_t>(a)] };
+	Node& node_c{ nodes_[static_cast<std::size_t>(child)] };
+
+	bool child_is_first{ node_a.child1 == child };
+	std::int32_t sibling{ child_is_first ? node_a.child2 : node_a.child1 };
+
+	// The taller grandchild stays under the rotated child, the shorter one moves under a.
+	std::int32_t taller{ node_c.child1 };
+	std::int32_t shorter{ node_c.child2 };
+	if (nodes_[static_cast<std::size_t>(taller)].height <
+		nodes_[static_cast<std::size_t>(shorter)].height) {
+		std::swap(taller, shorter);
+	}
+
+	// Swap a and child.
+	node_c.child1 = a;
+	node_c.child2 = taller;
+	node_c.parent = node_a.parent;
+	node_a.parent = child;
+
+	if (node_c.parent == null_node_) {
+		root_ = child;
+	} else {
+		Node& parent{ nodes_[static_cast<std::size_t>(node_c.parent)] };
+		if (parent.child1 == a) {
+			parent.child1 = child;
+		} else {
+			parent.child2 = child;
+		}
+	}
+
+	if (child_is_first) {
+		node_a.child1 = shorter;
+	} else {
+		node_a.child2 = shorter;
+	}
+
+	Node& shorter_node{ nodes_[static_cast<std::size_t>(shorter)] };
+	const Node& sibling_node{ nodes_[static_cast<std::size_t>(sibling)] };
+	const Node& taller_node{ nodes_[static_cast<std::size_t>(taller)] };
+
+	shorter_node.parent = a;
+
+	node_a.bounds = sibling_node.bounds.Merge(shorter_node.bounds);
+	node_a.height = 1 + std::max(sibling_node.height, shorter_node.height);
+
+	node_c.bounds = node_a.bounds.Merge(taller_node.bounds);
+	node_c.height = 1 + std::max(node_a.height, taller_node.height);
+
+	return child;
+}
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
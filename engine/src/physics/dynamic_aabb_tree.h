@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "core/ecs/entity.h"
+#include "debug/runtime/assert.h"
+#include "math/vector2.h"
+#include "physics/bounding_aabb.h"
+#include "physics/broadphase.h"
+
+namespace ptgn {
+
+namespace impl {
+
+// Incrementally balanced bounding volume hierarchy. Every object is stored in a leaf whose bounds
+// are enlarged by a margin (fat AABB), so objects which only move a little each frame do not touch
+// the tree at all. Objects which leave their fat AABB are removed and reinserted in O(log n), and
+// tree rotations keep the hierarchy balanced.
+// Unlike the KDTree, changes are applied to the tree immediately.
+class DynamicAABBTree : public Broadphase {
+public:
+	// @param margin Distance by which leaf bounds are enlarged in every direction.
+	explicit DynamicAABBTree(float margin = 4.0f);
+
+	// Clears the tree and inserts every object.
+	void Build(const std::vector<KDObject>& objects) override;
+
+	// Inserts the entity if it is not in the tree yet.
+	void UpdateBoundingAABB(const Entity& e, const BoundingAABB& aabb) override;
+
+	void Insert(const Entity& e, const BoundingAABB& aabb) override;
+
+	void Remove(const Entity& e) override;
+
+	// Counts a refit if the structure of the tree changed since the previous call.
+	void EndFrameUpdate() override;
+
+	void Update(const std::vector<KDObject>& objects) override;
+
+	[[nodiscard]] const BroadphaseStats& GetStats() const override;
+
+	void ResetStats() override;
+
+	void FindPairs(std::vector<BroadphasePair>& pairs) const override;
+
+	std::vector<Entity> Query(const BoundingAABB& region) const override;
+
+	std::vector<Entity> Query(const V2_float& point) const override;
+
+	using Broadphase::Raycast;
+
+	void Raycast(
+		const Entity& entity, const V2_float& dir, const BoundingAABB& aabb,
+		std::vector<Entity>& hits
+	) const override;
+
+	Entity RaycastFirst(const Entity& entity, const V2_float& dir, const BoundingAABB& aabb)
+		const override;
+
+private:
+	constexpr static std::int32_t null_node_{ -1 };
+
+	// Rotations keep the tree height logarithmic, so this covers any realistic object count.
+	constexpr static std::size_t max_stack_size_{ 256 };
+
+	struct Node {
+		// Fat bounds for leaves, union of the children bounds for internal nodes.
+		BoundingAABB bounds;
+
+		// Exact bounding AABB of the leaf object. Unused for internal nodes.
+		BoundingAABB aabb;
+		Entity entity;
+
+		// Next free node while the node is inside the free list.
+		std::int32_t parent{ null_node_ };
+		std::int32_t child1{ null_node_ };
+		std::int32_t child2{ null_node_ };
+
+		// Leaves have height 0, free nodes have height -1.
+		std::int32_t height{ -1 };
+
+		// Value of stamp_ during the last Update() which contained the leaf object.
+		std::uint32_t stamp{ 0 };
+
+		[[nodiscard]] bool IsLeaf() const {
+			return child1 == null_node_;
+		}
+	};
+
+	[[nodiscard]] std::int32_t AllocateNode();
+
+	void FreeNode(std::int32_t index);
+
+	void MoveLeaf(std::int32_t leaf, const BoundingAABB& aabb);
+
+	// Inserts the leaf next to the sibling which least increases the total perimeter of the tree.
+	void InsertLeaf(std::int32_t leaf);
+
+	void RemoveLeaf(std::int32_t leaf);
+
+	// Rebalances and recomputes the bounds and heights of index and all of its ancestors.
+	void RefitAncestors(std::int32_t index);
+
+	// Rotates the taller child of a up if the heights of its children differ by more than one.
+	// @return Index of the node which now roots the subtree of a.
+	[[nodiscard]] std::int32_t Balance(std::int32_t a);
+
+	// Replaces node a with its child. Node a takes the shorter grandchild.
+	// @return Index of the child, which now roots the subtree.
+	std::int32_t Rotate(std::int32_t a, std::int32_t child);
+
+	// Visits every leaf whose fat bounds pass the descend check.
+	template <typename DescendFunc, typename VisitFunc>
+	void Traverse(DescendFunc&& descend, VisitFunc&& visit) const {
+		if (root_ == null_node_) {
+			return;
+		}
+		std::array<std::int32_t, max_stack_size_> stack;
+		std::size_t size{ 0 };
+		stack[size++] = root_;
+		while (size > 0) {
+			const Node& node{ nodes_[static_cast<std::size_t>(stack[--size])] };
+			if (!descend(node.bounds)) {
+				continue;
+			}
+			if (node.IsLeaf()) {
+				visit(node);
+				continue;
+			}
+			PTGN_ASSERT(size + 2 <= stack.size(), "Dynamic AABB tree exceeded maximum height");
+			stack[size++] = node.child2;
+			stack[size++] = node.child1;
+		}
+	}
+
+	std::vector<Node> nodes_;
+
+	std::int32_t root_{ null_node_ };
+
+	// Head of the singly linked list of free nodes, linked through Node::parent.
+	std::int32_t free_list_{ null_node_ };
+
+	std::unordered_map<Entity, std::int32_t> leaves_;
+
+	// Entities which were not part of the latest Update(). Kept to reuse its capacity.
+	std::vector<Entity> stale_;
+
+	std::uint32_t stamp_{ 0 };
+
+	float margin_{ 4.0f };
+
+	// Structure of the tree changed since the last EndFrameUpdate().
+	bool changed_{ false };
+
+	BroadphaseStats stats_;
+};
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
@@ -1,12 +1,19 @@
 #include "physics/physics.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
 #include "core/app/game.h"
 #include "core/app/manager.h"
 #include "core/ecs/components/movement.h"
 #include "core/ecs/components/transform.h"
 #include "core/ecs/entity.h"
+#include "core/utils/frame_profiler.h"
 #include "debug/core/log.h"
 #include "debug/runtime/assert.h"
+#include "math/math_utils.h"
 #include "math/vector2.h"
 #include "physics/rigid_body.h"
 #include "world/scene/scene.h"
@@ -40,8 +47,54 @@ void Physics::SetGravity(const V2_float& gravity) {
 	gravity_ = gravity;
 }
 
+void Physics::SetSleepThresholds(
+	float linear_velocity, float angular_velocity, float time_to_sleep
+) {
+	PTGN_ASSERT(linear_velocity >= 0.0f);
+	PTGN_ASSERT(angular_velocity >= 0.0f);
+	PTGN_ASSERT(time_to_sleep >= 0.0f);
+
+	sleep_linear_velocity_	= linear_velocity;
+	sleep_angular_velocity_ = angular_velocity;
+	time_to_sleep_			= time_to_sleep;
+}
+
+float Physics::GetSleepLinearVelocity() const {
+	return sleep_linear_velocity_;
+}
+
+float Physics::GetSleepAngularVelocity() const {
+	return sleep_angular_velocity_;
+}
+
+float Physics::GetTimeToSleep() const {
+	return time_to_sleep_;
+}
+
+bool Physics::IsResting(const RigidBody& rigid_body) const {
+	if (Abs(rigid_body.angular_velocity) > sleep_angular_velocity_) {
+		return false;
+	}
+
+	V2_float velocity{ rigid_body.velocity };
+
+	// Discount up to one step of gravity, which a body resting on the ground gains every step.
+	V2_float gravity_step{ gravity_ * rigid_body.gravity * dt() };
+	float gravity_step_squared{ gravity_step.MagnitudeSquared() };
+	if (gravity_step_squared > 0.0f) {
+		float fraction{ velocity.Dot(gravity_step) / gravity_step_squared };
+		if (fraction > 0.0f) {
+			velocity -= gravity_step * std::min(fraction, 1.0f);
+		}
+	}
+
+	return velocity.MagnitudeSquared() <= sleep_linear_velocity_ * sleep_linear_velocity_;
+}
+
 float Physics::dt() const {
-	// TODO: Consider changing in the future.
+	if (game.IsFixedTimestep()) {
+		return game.GetFixedTimestep();
+	}
 	return game.dt();
 }
 
@@ -62,6 +115,8 @@ void Physics::Enable() {
 }
 
 void Physics::PreCollisionUpdate(Scene& scene) const {
+	PTGN_FRAME_SCOPE("Physics::PreCollisionUpdate");
+
 	if (!enabled_) {
 		return;
 	}
@@ -87,6 +142,13 @@ void Physics::PreCollisionUpdate(Scene& scene) const {
 	}
 
 	for (auto [e, rigid_body] : scene.EntitiesWith<RigidBody>()) {
+		if (rigid_body.sleeping_) {
+			// Sleeping bodies have no velocity, so any velocity was set by the user.
+			if (IsResting(rigid_body)) {
+				continue;
+			}
+			rigid_body.Wake();
+		}
 		rigid_body.Update(gravity_, dt);
 	}
 
@@ -111,6 +173,10 @@ void Physics::PostCollisionUpdate(Scene& scene) const {
 
 	for (auto [entity, transform, rigid_body] :
 		 scene.InternalEntitiesWith<Transform, RigidBody>()) {
+		if (rigid_body.sleeping_) {
+			continue;
+		}
+
 		transform.Translate(rigid_body.velocity * dt);
 		transform.Rotate(rigid_body.angular_velocity * dt);
 		transform.ClampRotation();
@@ -133,6 +199,59 @@ void Physics::PostCollisionUpdate(Scene& scene) const {
 	scene.Refresh();
 }
 
+void Physics::RecordPreviousTransforms(Scene& scene) const {
+	for (auto [entity, transform, rigid_body] : scene.InternalEntitiesWith<Transform, RigidBody>()) {
+		if (entity.Has<impl::InterpolatedTransform>()) {
+			entity.Get<impl::InterpolatedTransform>().previous = transform;
+		} else {
+			entity.Add<impl::InterpolatedTransform>(transform, transform, transform);
+		}
+	}
+}
+
+void Physics::ClearPhysicsDirtyFlags(Scene& scene) const {
+	// Ancestors without colliders are included, since their moves also move their descendants.
+	for (auto [entity, transform] : scene.InternalEntitiesWith<Transform>()) {
+		transform.ClearPhysicsDirtyFlag();
+	}
+}
+
+void Physics::InterpolateTransforms(Scene& scene, std::size_t steps, float alpha) const {
+	for (auto [entity, transform, rigid_body, interpolated] :
+		 scene.InternalEntitiesWith<Transform, RigidBody, impl::InterpolatedTransform>()) {
+		// Transforms which were changed outside of a physics step, such as teleports, are not
+		// interpolated.
+		if (steps == 0 && transform != interpolated.current) {
+			interpolated.previous = transform;
+		}
+		interpolated.current = transform;
+
+		const auto& previous{ interpolated.previous };
+
+		// Rotations are interpolated along the shortest arc.
+		float rotation_difference{ std::remainder(
+			transform.GetRotation() - previous.GetRotation(), two_pi<float>
+		) };
+
+		auto& render{ interpolated.render };
+		render.SetPosition(Lerp(previous.GetPosition(), transform.GetPosition(), alpha));
+		render.SetRotation(previous.GetRotation() + rotation_difference * alpha);
+		render.SetScale(Lerp(previous.GetScale(), transform.GetScale(), alpha));
+	}
+}
+
+void Physics::RemoveInterpolation(Scene& scene) const {
+	std::vector<Entity> entities;
+	for (auto [entity, interpolated] : scene.InternalEntitiesWith<impl::InterpolatedTransform>()) {
+		entities.emplace_back(entity);
+	}
+	for (auto entity : entities) {
+		entity.Remove<impl::InterpolatedTransform>();
+		// The cached world transform was computed from the interpolated pose.
+		impl::InvalidateWorldTransform(entity);
+	}
+}
+
 void Physics::HandleBoundary(
 	Transform& transform, V2_float& velocity, const V2_float& min_bound, const V2_float& max_bound,
 	BoundaryBehavior behavior
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include "math/vector2.h"
 #include "serialization/json/enum.h"
 #include "serialization/json/serializable.h"
@@ -8,6 +10,7 @@ namespace ptgn {
 
 class Scene;
 struct Transform;
+struct RigidBody;
 
 namespace impl {
 
@@ -34,9 +37,29 @@ public:
 	[[nodiscard]] V2_float GetGravity() const;
 	void SetGravity(const V2_float& gravity);
 
-	// @return Physics time step in seconds.
+	// @return Physics time step in seconds. Equal to game.GetFixedTimestep() if the game uses a
+	// fixed timestep, otherwise the previous frame time.
 	[[nodiscard]] float dt() const;
 
+	// Rigid bodies which move slower than both velocity thresholds for time_to_sleep seconds are
+	// put to sleep, together with every body they are resting on or supporting. Sleeping bodies
+	// keep zero velocity and receive no collision callbacks against the colliders they rest on
+	// until they are woken up. Bodies controlled by a movement component never sleep. Sleeping is
+	// disabled by default.
+	// @param linear_velocity Unit: units per second. Velocity of up to one step of gravity along
+	// the gravity direction is not counted, since bodies resting on the ground under gravity
+	// alternate between zero velocity and gravity * dt.
+	// @param angular_velocity Unit: radians per second.
+	// @param time_to_sleep Unit: seconds. A value of 0 disables sleeping.
+	void SetSleepThresholds(float linear_velocity, float angular_velocity, float time_to_sleep);
+
+	[[nodiscard]] float GetSleepLinearVelocity() const;
+	[[nodiscard]] float GetSleepAngularVelocity() const;
+	[[nodiscard]] float GetTimeToSleep() const;
+
+	// @return True if the body moves slower than the sleep thresholds.
+	[[nodiscard]] bool IsResting(const RigidBody& rigid_body) const;
+
 	void SetEnabled(bool enabled = true);
 	void Disable();
 	void Enable();
@@ -45,7 +68,9 @@ public:
 	PTGN_SERIALIZER_REGISTER_NAMED(
 		Physics, KeyValue("gravity", gravity_), KeyValue("bounds_top_left", bounds_top_left_),
 		KeyValue("bounds_size", bounds_size_), KeyValue("boundary_behavior", boundary_behavior_),
-		KeyValue("enabled", enabled_)
+		KeyValue("enabled", enabled_), KeyValue("sleep_linear_velocity", sleep_linear_velocity_),
+		KeyValue("sleep_angular_velocity", sleep_angular_velocity_),
+		KeyValue("time_to_sleep", time_to_sleep_)
 	)
 
 private:
@@ -55,6 +80,25 @@ private:
 	void PreCollisionUpdate(Scene& scene) const;
 	void PostCollisionUpdate(Scene& scene) const;
 
+	// Used for fixed timesteps. Records the transforms of rigid bodies before each physics step.
+	void RecordPreviousTransforms(Scene& scene) const;
+
+	// Clears the physics dirty flags of transforms after each physics step, so that only moves made
+	// since the step wake sleeping bodies and move static colliders during the next step. Other
+	// dirty flags are left for drawing.
+	void ClearPhysicsDirtyFlags(Scene& scene) const;
+
+	// Used for fixed timesteps. Records the simulated transforms of rigid bodies and the
+	// interpolation between their previous and simulated transforms, which is drawn in place of
+	// the transform.
+	// @param steps Number of physics steps simulated during the frame.
+	// @param alpha Fraction of a step to interpolate by.
+	void InterpolateTransforms(Scene& scene, std::size_t steps, float alpha) const;
+
+	// Used for variable timesteps. Removes the interpolated poses of rigid bodies so that they are
+	// drawn at their transforms.
+	void RemoveInterpolation(Scene& scene) const;
+
 	static void HandleBoundary(
 		Transform& transform, V2_float& velocity, const V2_float& min_bound,
 		const V2_float& max_bound, BoundaryBehavior behavior
@@ -65,6 +109,9 @@ private:
 	V2_float bounds_size_;
 	BoundaryBehavior boundary_behavior_{ BoundaryBehavior::SlideVelocity };
 	V2_float gravity_{ 0.0f, 0.0f };
+	float sleep_linear_velocity_{ 2.0f };
+	float sleep_angular_velocity_{ 0.1f };
+	float time_to_sleep_{ 0.0f };
 };
 
 PTGN_SERIALIZER_REGISTER_ENUM(
@@ -28,21 +28,34 @@ RigidBody::RigidBody(float rb_max_speed, float rb_drag, float rb_gravity, bool r
 	max_speed{ rb_max_speed }, drag{ rb_drag }, gravity{ rb_gravity }, immovable{ rb_immovable } {}
 
 void RigidBody::AddAcceleration(const V2_float& acceleration, float dt) {
+	Wake();
 	velocity += acceleration * dt;
 }
 
 void RigidBody::AddAngularAcceleration(float angular_acceleration, float dt) {
+	Wake();
 	angular_velocity += angular_acceleration * dt;
 }
 
 void RigidBody::AddImpulse(const V2_float& impulse) {
+	Wake();
 	velocity += impulse;
 }
 
 void RigidBody::AddAngularImpulse(float angular_impulse) {
+	Wake();
 	angular_velocity += angular_impulse;
 }
 
+bool RigidBody::IsSleeping() const {
+	return sleeping_;
+}
+
+void RigidBody::Wake() {
+	sleeping_	= false;
+	sleep_time_ = 0.0f;
+}
+
 bool IsImmovable(const Entity& entity, bool check_parents) {
 	if (entity.Has<RigidBody>() && entity.Get<RigidBody>().immovable) {
 		return true;
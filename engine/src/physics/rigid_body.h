@@ -6,11 +6,20 @@
 namespace ptgn {
 
 class Entity;
+class Physics;
+
+namespace impl {
+
+class CollisionHandler;
+
+} // namespace impl
 
 struct RigidBody {
 	RigidBody() = default;
 	RigidBody(float max_speed, float drag, float gravity, bool immovable);
 
+	// Adding accelerations or impulses wakes the body up.
+
 	// vel += accel * dt
 	// @param dt Unit: seconds.
 	void AddAcceleration(const V2_float& acceleration, float dt);
@@ -28,9 +37,17 @@ struct RigidBody {
 	// @param dt Unit: seconds.
 	void Update(const V2_float& physics_gravity, float dt);
 
+	// @return True if the body is at rest. Sleeping bodies are skipped by physics integration
+	// and by collision tests against other resting colliders until they are woken up.
+	[[nodiscard]] bool IsSleeping() const;
+
+	// Wakes the body up and restarts its sleep timer. Bodies are also woken up when an awake
+	// collider hits them or when a body they were resting on wakes up.
+	void Wake();
+
 	PTGN_SERIALIZER_REGISTER_IGNORE_DEFAULTS(
 		RigidBody, max_speed, max_angular_speed, drag, angular_drag, gravity, immovable, velocity,
-		angular_velocity
+		angular_velocity, can_sleep
 	)
 
 	// -1 means no enforcement of maximum speed.
@@ -43,6 +60,17 @@ struct RigidBody {
 	bool immovable{ false };
 	V2_float velocity;
 	float angular_velocity{ 0.0f };
+	// If false, the body is never put to sleep.
+	bool can_sleep{ true };
+
+private:
+	friend class Physics;
+	friend class impl::CollisionHandler;
+
+	// Time for which the body has been moving slower than the physics sleep thresholds.
+	// Unit: seconds.
+	float sleep_time_{ 0.0f };
+	bool sleeping_{ false };
 };
 
 [[nodiscard]] bool IsImmovable(const Entity& entity, bool check_parents = true);
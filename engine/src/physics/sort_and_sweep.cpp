@@ -0,0 +1,315 @@
+#include "physics/sort_and_sweep.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "core/ecs/components/transform.h"
+#include "core/ecs/entity.h"
+#include "debug/runtime/assert.h"
+#include "math/geometry/rect.h"
+#include "math/raycast.h"
+#include "math/vector2.h"
+#include "physics/bounding_aabb.h"
+#include "physics/broadphase.h"
+
+namespace ptgn {
+
+namespace impl {
+
+void SortAndSweep::Build(const std::vector<KDObject>& objects) {
+	objects_.clear();
+	order_.clear();
+	indices_.clear();
+	removed_count_ = 0;
+	max_extent_	   = 0.0f;
+
+	for (const auto& object : objects) {
+		auto [it, inserted] = indices_.try_emplace(object.entity);
+		if (!inserted) {
+			objects_[it->second].aabb = object.aabb;
+			continue;
+		}
+		it->second = static_cast<std::uint32_t>(objects_.size());
+		order_.emplace_back(it->second);
+		objects_.push_back({ object.entity, object.aabb, it->second, stamp_, false });
+	}
+
+	axis_ = SelectAxis();
+	SortOrder();
+
+	changed_ = false;
+	++stats_.rebuilds;
+}
+
+void SortAndSweep::UpdateBoundingAABB(const Entity& e, const BoundingAABB& aabb) {
+	auto it{ indices_.find(e) };
+	if (it == indices_.end()) {
+		Insert(e, aabb);
+		return;
+	}
+
+	auto& object{ objects_[it->second] };
+	object.stamp = stamp_;
+
+	if (object.aabb == aabb) {
+		return;
+	}
+
+	object.aabb = aabb;
+	max_extent_ = std::max(max_extent_, aabb.max[axis_] - aabb.min[axis_]);
+	Resort(it->second);
+	changed_ = true;
+}
+
+void SortAndSweep::Insert(const Entity& e, const BoundingAABB& aabb) {
+	if (indices_.contains(e)) {
+		UpdateBoundingAABB(e, aabb);
+		return;
+	}
+
+	auto index{ static_cast<std::uint32_t>(objects_.size()) };
+	objects_.push_back({ e, aabb, static_cast<std::uint32_t>(order_.size()), stamp_, false });
+	order_.emplace_back(index);
+	indices_.emplace(e, index);
+
+	max_extent_ = std::max(max_extent_, aabb.max[axis_] - aabb.min[axis_]);
+	Resort(index);
+	changed_ = true;
+}
+
+void SortAndSweep::Remove(const Entity& e) {
+	auto it{ indices_.find(e) };
+	if (it == indices_.end()) {
+		return;
+	}
+	objects_[it->second].removed = true;
+	++removed_count_;
+	indices_.erase(it);
+}
+
+void SortAndSweep::EndFrameUpdate() {
+	if (removed_count_ == 0 && !changed_) {
+		return;
+	}
+
+	if (removed_count_ > 0) {
+		// Storing the surviving objects in sweep order also makes the sweeps cache friendly.
+		compacted_.clear();
+		for (auto index : order_) {
+			if (!objects_[index].removed) {
+				compacted_.emplace_back(objects_[index]);
+			}
+		}
+		objects_.swap(compacted_);
+		order_.resize(objects_.size());
+		for (std::uint32_t i{ 0 }; i < objects_.size(); ++i) {
+			order_[i] = i;
+			objects_[i].rank = i;
+			indices_[objects_[i].entity] = i;
+		}
+		removed_count_ = 0;
+	}
+
+	// Moves only ever grow max_extent_, so tighten it again.
+	max_extent_ = 0.0f;
+	for (const auto& object : objects_) {
+		max_extent_ = std::max(max_extent_, object.aabb.max[axis_] - object.aabb.min[axis_]);
+	}
+
+	changed_ = false;
+
+	if (std::size_t axis{ SelectAxis() }; axis != axis_) {
+		axis_ = axis;
+		SortOrder();
+		++stats_.rebuilds;
+	} else {
+		++stats_.refits;
+	}
+}
+
+void SortAndSweep::Update(const std::vector<KDObject>& objects) {
+	++stamp_;
+
+	for (const auto& object : objects) {
+		UpdateBoundingAABB(object.entity, object.aabb);
+	}
+
+	// Every entity in the structure was provided, so nothing needs to be removed.
+	if (objects.size() != indices_.size()) {
+		stale_.clear();
+		for (const auto& [e, index] : indices_) {
+			if (objects_[index].stamp != stamp_) {
+				stale_.emplace_back(e);
+			}
+		}
+		for (const auto& e : stale_) {
+			Remove(e);
+		}
+	}
+
+	EndFrameUpdate();
+}
+
+const BroadphaseStats& SortAndSweep::GetStats() const {
+	return stats_;
+}
+
+void SortAndSweep::ResetStats() {
+	stats_ = {};
+}
+
+template <typename VisitFunc>
+void SortAndSweep::ForEachOverlapping(const BoundingAABB& region, VisitFunc&& visit) const {
+	auto first{ std::ranges::lower_bound(
+		order_, region.min[axis_] - max_extent_, {},
+		[&](std::uint32_t index) { return GetMin(index); }
+	) };
+	for (auto it{ first }; it != order_.end(); ++it) {
+		const auto& object{ objects_[*it] };
+		if (object.aabb.min[axis_] > region.max[axis_]) {
+			break;
+		}
+		if (!object.removed && object.aabb.Overlaps(region)) {
+			visit(object);
+		}
+	}
+}
+
+void SortAndSweep::FindPairs(std::vector<BroadphasePair>& pairs) const {
+	pairs.clear();
+	for (std::size_t i{ 0 }; i < order_.size(); ++i) {
+		const auto& a{ objects_[order_[i]] };
+		if (a.removed) {
+			continue;
+		}
+		// Only objects which start before a ends along the sweep axis can overlap it.
+		for (std::size_t j{ i + 1 }; j < order_.size(); ++j) {
+			const auto& b{ objects_[order_[j]] };
+			if (b.aabb.min[axis_] > a.aabb.max[axis_]) {
+				break;
+			}
+			if (!b.removed && a.aabb.Overlaps(b.aabb)) {
+				pairs.push_back({ a.entity, b.entity });
+			}
+		}
+	}
+}
+
+std::vector<Entity> SortAndSweep::Query(const BoundingAABB& region) const {
+	std::vector<Entity> result;
+	ForEachOverlapping(region, [&](const Object& object) {
+		result.emplace_back(object.entity);
+	});
+	return result;
+}
+
+std::vector<Entity> SortAndSweep::Query(const V2_float& point) const {
+	return Query(BoundingAABB{ point, point });
+}
+
+void SortAndSweep::Raycast(
+	const Entity& entity, const V2_float& dir, const BoundingAABB& aabb, std::vector<Entity>& hits
+) const {
+	Rect rect{ aabb.min, aabb.max };
+	// Every object the sweep can hit overlaps the region swept by aabb.
+	ForEachOverlapping(aabb.ExpandByVelocity(dir), [&](const Object& object) {
+		if (object.entity == entity) {
+			return;
+		}
+		auto raycast{ RaycastRectRect(
+			dir, Transform{}, rect, Transform{}, Rect{ object.aabb.min, object.aabb.max }
+		) };
+		if (raycast.Occurred()) {
+			hits.emplace_back(object.entity);
+		}
+	});
+}
+
+Entity SortAndSweep::RaycastFirst(
+	const Entity& entity, const V2_float& dir, const BoundingAABB& aabb
+) const {
+	Entity closest_hit;
+	float closest_t{ 1.0f };
+	Rect rect{ aabb.min, aabb.max };
+	ForEachOverlapping(aabb.ExpandByVelocity(dir), [&](const Object& object) {
+		if (object.entity == entity) {
+			return;
+		}
+		auto raycast{ RaycastRectRect(
+			dir, Transform{}, rect, Transform{}, Rect{ object.aabb.min, object.aabb.max }
+		) };
+		if (raycast.Occurred() && raycast.t < closest_t) {
+			closest_t	= raycast.t;
+			closest_hit = object.entity;
+		}
+	});
+	return closest_hit;
+}
+
+float SortAndSweep::GetMin(std::uint32_t index) const {
+	return objects_[index].aabb.min[axis_];
+}
+
+void SortAndSweep::Resort(std::uint32_t index) {
+	std::size_t rank{ objects_[index].rank };
+	float value{ GetMin(index) };
+
+	// Neighbors which the object passes shift by one rank in the opposite direction.
+	const auto shift = [&](std::size_t from) {
+		order_[rank] = order_[from];
+		objects_[order_[rank]].rank = static_cast<std::uint32_t>(rank);
+		rank = from;
+	};
+
+	while (rank > 0 && GetMin(order_[rank - 1]) > value) {
+		shift(rank - 1);
+	}
+	while (rank + 1 < order_.size() && GetMin(order_[rank + 1]) < value) {
+		shift(rank + 1);
+	}
+
+	order_[rank] = index;
+	objects_[index].rank = static_cast<std::uint32_t>(rank);
+}
+
+void SortAndSweep::SortOrder() {
+	std::ranges::sort(order_, {}, [&](std::uint32_t index) { return GetMin(index); });
+	max_extent_ = 0.0f;
+	for (std::uint32_t rank{ 0 }; rank < order_.size(); ++rank) {
+		auto& object{ objects_[order_[rank]] };
+		object.rank = rank;
+		max_extent_ = std::max(max_extent_, object.aabb.max[axis_] - object.aabb.min[axis_]);
+	}
+}
+
+std::size_t SortAndSweep::SelectAxis() const {
+	if (objects_.empty()) {
+		return axis_;
+	}
+
+	V2_float sum;
+	V2_float sum_squared;
+	for (const auto& object : objects_) {
+		V2_float center{ object.aabb.GetCenter() };
+		sum			+= center;
+		sum_squared += center * center;
+	}
+
+	auto count{ static_cast<float>(objects_.size()) };
+	V2_float mean{ sum / count };
+	V2_float variance{ sum_squared / count - mean * mean };
+
+	// Only switch once the other axis is clearly better, since every switch requires a full sort.
+	constexpr float hysteresis{ 2.0f };
+
+	std::size_t other{ 1 - axis_ };
+	if (variance[other] > hysteresis * variance[axis_]) {
+		return other;
+	}
+	return axis_;
+}
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "core/ecs/entity.h"
+#include "math/vector2.h"
+#include "physics/bounding_aabb.h"
+#include "physics/broadphase.h"
+
+namespace ptgn {
+
+namespace impl {
+
+// Objects are kept sorted by the minimum of their bounding AABB along a single axis, so
+// overlapping pairs are found by sweeping along the sorted intervals. Moved objects are shifted
+// into place by insertion, which is close to O(1) when objects move coherently between frames.
+// The sweep axis is switched to the one with the largest spread of objects when it changes.
+// Unlike the KDTree, changes are applied immediately. Removed objects are only compacted away at
+// EndFrameUpdate().
+class SortAndSweep : public Broadphase {
+public:
+	SortAndSweep() = default;
+
+	// Clears and inserts every object, choosing the sweep axis from scratch.
+	void Build(const std::vector<KDObject>& objects) override;
+
+	// Inserts the entity if it is not in the structure yet.
+	void UpdateBoundingAABB(const Entity& e, const BoundingAABB& aabb) override;
+
+	void Insert(const Entity& e, const BoundingAABB& aabb) override;
+
+	void Remove(const Entity& e) override;
+
+	// Compacts removed objects and reselects the sweep axis. A change of sweep axis counts as a
+	// rebuild, any other change as a refit.
+	void EndFrameUpdate() override;
+
+	void Update(const std::vector<KDObject>& objects) override;
+
+	[[nodiscard]] const BroadphaseStats& GetStats() const override;
+
+	void ResetStats() override;
+
+	void FindPairs(std::vector<BroadphasePair>& pairs) const override;
+
+	std::vector<Entity> Query(const BoundingAABB& region) const override;
+
+	std::vector<Entity> Query(const V2_float& point) const override;
+
+	using Broadphase::Raycast;
+
+	void Raycast(
+		const Entity& entity, const V2_float& dir, const BoundingAABB& aabb,
+		std::vector<Entity>& hits
+	) const override;
+
+	Entity RaycastFirst(const Entity& entity, const V2_float& dir, const BoundingAABB& aabb)
+		const override;
+
+private:
+	struct Object {
+		Entity entity;
+		BoundingAABB aabb;
+		// Position of the object inside order_.
+		std::uint32_t rank{ 0 };
+		// Value of stamp_ during the last Update() which contained the object.
+		std::uint32_t stamp{ 0 };
+		// Object is skipped by queries and discarded at EndFrameUpdate().
+		bool removed{ false };
+	};
+
+	[[nodiscard]] float GetMin(std::uint32_t index) const;
+
+	// Shifts the object through order_ until order_ is sorted again.
+	void Resort(std::uint32_t index);
+
+	// Fully sorts order_ along axis_.
+	void SortOrder();
+
+	// @return Axis along which object centers are spread out the most.
+	[[nodiscard]] std::size_t SelectAxis() const;
+
+	// Visits every object whose bounding AABB overlaps region.
+	template <typename VisitFunc>
+	void ForEachOverlapping(const BoundingAABB& region, VisitFunc&& visit) const;
+
+	std::vector<Object> objects_;
+
+	// Indices into objects_ sorted by the minimum of their bounding AABB along axis_.
+	std::vector<std::uint32_t> order_;
+
+	std::unordered_map<Entity, std::uint32_t> indices_;
+
+	// Objects surviving compaction. Kept to reuse its capacity.
+	std::vector<Object> compacted_;
+
+	// Entities which were not part of the latest Update(). Kept to reuse its capacity.
+	std::vector<Entity> stale_;
+
+	std::size_t axis_{ 0 };
+
+	// Upper bound on the extent of any object along axis_. Every interval overlapping a region
+	// starts within max_extent_ of the region minimum.
+	float max_extent_{ 0.0f };
+
+	std::size_t removed_count_{ 0 };
+
+	std::uint32_t stamp_{ 0 };
+
+	// Objects were moved or inserted since the last EndFrameUpdate().
+	bool changed_{ false };
+
+	BroadphaseStats stats_;
+};
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
@@ -0,0 +1,371 @@
+#include "physics/spatial_hash_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "core/ecs/components/transform.h"
+#include "core/ecs/entity.h"
+#include "debug/runtime/assert.h"
+#include "math/geometry/rect.h"
+#include "math/raycast.h"
+#include "math/vector2.h"
+#include "physics/bounding_aabb.h"
+#include "physics/broadphase.h"
+
+namespace ptgn {
+
+namespace impl {
+
+std::int64_t SpatialHashGrid::CellRange::GetCount() const {
+	return static_cast<std::int64_t>(max.x - min.x + 1) *
+		   static_cast<std::int64_t>(max.y - min.y + 1);
+}
+
+SpatialHashGrid::SpatialHashGrid(float cell_size) :
+	cell_size_{ cell_size }, inverse_cell_size_{ 1.0f / cell_size } {
+	PTGN_ASSERT(cell_size_ > 0.0f, "Spatial hash grid cell size must be positive");
+}
+
+void SpatialHashGrid::Build(const std::vector<KDObject>& objects) {
+	objects_.clear();
+	free_.clear();
+	indices_.clear();
+	cells_.clear();
+	oversized_.clear();
+	empty_cells_ = 0;
+
+	for (const auto& object : objects) {
+		Insert(object.entity, object.aabb);
+	}
+
+	changed_ = false;
+	++stats_.rebuilds;
+}
+
+void SpatialHashGrid::UpdateBoundingAABB(const Entity& e, const BoundingAABB& aabb) {
+	auto it{ indices_.find(e) };
+	if (it == indices_.end()) {
+		Insert(e, aabb);
+		return;
+	}
+
+	std::uint32_t index{ it->second };
+	auto& object{ objects_[index] };
+	object.aabb	 = aabb;
+	object.stamp = stamp_;
+
+	// Objects which remain within the same cells do not need to touch the grid.
+	if (GetCellRange(aabb) == object.cells) {
+		return;
+	}
+
+	RemoveFromCells(index);
+	AddToCells(index);
+	changed_ = true;
+}
+
+void SpatialHashGrid::Insert(const Entity& e, const BoundingAABB& aabb) {
+	if (indices_.contains(e)) {
+		UpdateBoundingAABB(e, aabb);
+		return;
+	}
+
+	std::uint32_t index{ 0 };
+	if (free_.empty()) {
+		index = static_cast<std::uint32_t>(objects_.size());
+		objects_.emplace_back();
+	} else {
+		index = free_.back();
+		free_.pop_back();
+	}
+
+	auto& object{ objects_[index] };
+	object.entity = e;
+	object.aabb	  = aabb;
+	object.alive  = true;
+	object.stamp  = stamp_;
+
+	indices_.emplace(e, index);
+	AddToCells(index);
+	changed_ = true;
+}
+
+void SpatialHashGrid::Remove(const Entity& e) {
+	auto it{ indices_.find(e) };
+	if (it == indices_.end()) {
+		return;
+	}
+	RemoveFromCells(it->second);
+	objects_[it->second] = Object{};
+	free_.emplace_back(it->second);
+	indices_.erase(it);
+	changed_ = true;
+}
+
+void SpatialHashGrid::EndFrameUpdate() {
+	if (!changed_) {
+		return;
+	}
+	changed_ = false;
+	++stats_.refits;
+
+	// Objects roaming the world leave behind empty cells, which are dropped once they make up
+	// most of the grid.
+	if (empty_cells_ > cells_.size() / 2) {
+		std::erase_if(cells_, [](const auto& pair) { return pair.second.empty(); });
+		empty_cells_ = 0;
+	}
+}
+
+void SpatialHashGrid::Update(const std::vector<KDObject>& objects) {
+	++stamp_;
+
+	for (const auto& object : objects) {
+		UpdateBoundingAABB(object.entity, object.aabb);
+	}
+
+	// Every entity in the grid was provided, so nothing needs to be removed.
+	if (objects.size() != indices_.size()) {
+		stale_.clear();
+		for (const auto& [e, index] : indices_) {
+			if (objects_[index].stamp != stamp_) {
+				stale_.emplace_back(e);
+			}
+		}
+		for (const auto& e : stale_) {
+			Remove(e);
+		}
+	}
+
+	EndFrameUpdate();
+}
+
+const BroadphaseStats& SpatialHashGrid::GetStats() const {
+	return stats_;
+}
+
+void SpatialHashGrid::ResetStats() {
+	stats_ = {};
+}
+
+template <typename VisitFunc>
+void SpatialHashGrid::ForEachOverlapping(const BoundingAABB& region, VisitFunc&& visit) const {
+	const auto visit_cell = [&](const V2_int& cell, const std::vector<std::uint32_t>& indices) {
+		for (auto index : indices) {
+			const auto& object{ objects_[index] };
+			if (!object.aabb.Overlaps(region)) {
+				continue;
+			}
+			// Objects which share several cells with the region are only visited from the cell
+			// containing the minimum corner of their overlap.
+			V2_float corner{ std::max(region.min.x, object.aabb.min.x),
+							 std::max(region.min.y, object.aabb.min.y) };
+			if (GetCell(corner) == cell) {
+				visit(object);
+			}
+		}
+	};
+
+	CellRange range{ GetCellRange(region) };
+
+	if (range.GetCount() > static_cast<std::int64_t>(cells_.size())) {
+		// Region covers more cells than are occupied, so walk the occupied cells instead.
+		for (const auto& [key, indices] : cells_) {
+			V2_int cell{ GetCellFromKey(key) };
+			if (cell.x >= range.min.x && cell.x <= range.max.x && cell.y >= range.min.y &&
+				cell.y <= range.max.y) {
+				visit_cell(cell, indices);
+			}
+		}
+	} else {
+		for (int y{ range.min.y }; y <= range.max.y; ++y) {
+			for (int x{ range.min.x }; x <= range.max.x; ++x) {
+				if (auto it{ cells_.find(GetKey(x, y)) }; it != cells_.end()) {
+					visit_cell(V2_int{ x, y }, it->second);
+				}
+			}
+		}
+	}
+
+	for (auto index : oversized_) {
+		const auto& object{ objects_[index] };
+		if (object.aabb.Overlaps(region)) {
+			visit(object);
+		}
+	}
+}
+
+void SpatialHashGrid::FindPairs(std::vector<BroadphasePair>& pairs) const {
+	pairs.clear();
+
+	for (const auto& [key, indices] : cells_) {
+		V2_int cell{ GetCellFromKey(key) };
+		for (std::size_t i{ 0 }; i < indices.size(); ++i) {
+			const auto& a{ objects_[indices[i]] };
+			for (std::size_t j{ i + 1 }; j < indices.size(); ++j) {
+				const auto& b{ objects_[indices[j]] };
+				if (!a.aabb.Overlaps(b.aabb)) {
+					continue;
+				}
+				// Pairs which share several cells are only reported from the cell containing the
+				// minimum corner of their overlap.
+				V2_float corner{ std::max(a.aabb.min.x, b.aabb.min.x),
+								 std::max(a.aabb.min.y, b.aabb.min.y) };
+				if (GetCell(corner) == cell) {
+					pairs.push_back({ a.entity, b.entity });
+				}
+			}
+		}
+	}
+
+	for (auto index : oversized_) {
+		const auto& a{ objects_[index] };
+		for (const auto& b : objects_) {
+			// Pairs of two oversized objects are reported from the first one in objects_.
+			if (!b.alive || &b == &a || (b.oversized && &b < &a)) {
+				continue;
+			}
+			if (a.aabb.Overlaps(b.aabb)) {
+				pairs.push_back({ a.entity, b.entity });
+			}
+		}
+	}
+}
+
+std::vector<Entity> SpatialHashGrid::Query(const BoundingAABB& region) const {
+	std::vector<Entity> result;
+	ForEachOverlapping(region, [&](const Object& object) {
+		result.emplace_back(object.entity);
+	});
+	return result;
+}
+
+std::vector<Entity> SpatialHashGrid::Query(const V2_float& point) const {
+	std::vector<Entity> result;
+	V2_int cell{ GetCell(point) };
+	if (auto it{ cells_.find(GetKey(cell.x, cell.y)) }; it != cells_.end()) {
+		for (auto index : it->second) {
+			if (objects_[index].aabb.Overlaps(point)) {
+				result.emplace_back(objects_[index].entity);
+			}
+		}
+	}
+	for (auto index : oversized_) {
+		if (objects_[index].aabb.Overlaps(point)) {
+			result.emplace_back(objects_[index].entity);
+		}
+	}
+	return result;
+}
+
+void SpatialHashGrid::Raycast(
+	const Entity& entity, const V2_float& dir, const BoundingAABB& aabb, std::vector<Entity>& hits
+) const {
+	Rect rect{ aabb.min, aabb.max };
+	// Every object the sweep can hit overlaps the region swept by aabb.
+	ForEachOverlapping(aabb.ExpandByVelocity(dir), [&](const Object& object) {
+		if (object.entity == entity) {
+			return;
+		}
+		auto raycast{ RaycastRectRect(
+			dir, Transform{}, rect, Transform{}, Rect{ object.aabb.min, object.aabb.max }
+		) };
+		if (raycast.Occurred()) {
+			hits.emplace_back(object.entity);
+		}
+	});
+}
+
+Entity SpatialHashGrid::RaycastFirst(
+	const Entity& entity, const V2_float& dir, const BoundingAABB& aabb
+) const {
+	Entity closest_hit;
+	float closest_t{ 1.0f };
+	Rect rect{ aabb.min, aabb.max };
+	ForEachOverlapping(aabb.ExpandByVelocity(dir), [&](const Object& object) {
+		if (object.entity == entity) {
+			return;
+		}
+		auto raycast{ RaycastRectRect(
+			dir, Transform{}, rect, Transform{}, Rect{ object.aabb.min, object.aabb.max }
+		) };
+		if (raycast.Occurred() && raycast.t < closest_t) {
+			closest_t	= raycast.t;
+			closest_hit = object.entity;
+		}
+	});
+	return closest_hit;
+}
+
+V2_int SpatialHashGrid::GetCell(const V2_float& point) const {
+	return V2_int{ static_cast<int>(std::floor(point.x * inverse_cell_size_)),
+				   static_cast<int>(std::floor(point.y * inverse_cell_size_)) };
+}
+
+SpatialHashGrid::CellRange SpatialHashGrid::GetCellRange(const BoundingAABB& aabb) const {
+	return CellRange{ GetCell(aabb.min), GetCell(aabb.max) };
+}
+
+std::uint64_t SpatialHashGrid::GetKey(int x, int y) {
+	return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) |
+		   static_cast<std::uint64_t>(static_cast<std::uint32_t>(y));
+}
+
+V2_int SpatialHashGrid::GetCellFromKey(std::uint64_t key) {
+	return V2_int{ static_cast<std::int32_t>(key >> 32),
+				   static_cast<std::int32_t>(key & 0xFFFFFFFF) };
+}
+
+void SpatialHashGrid::AddToCells(std::uint32_t index) {
+	auto& object{ objects_[index] };
+	object.cells	 = GetCellRange(object.aabb);
+	object.oversized = object.cells.GetCount() > max_object_cells_;
+
+	if (object.oversized) {
+		oversized_.emplace_back(index);
+		return;
+	}
+
+	for (int y{ object.cells.min.y }; y <= object.cells.max.y; ++y) {
+		for (int x{ object.cells.min.x }; x <= object.cells.max.x; ++x) {
+			auto [it, inserted] = cells_.try_emplace(GetKey(x, y));
+			if (!inserted && it->second.empty()) {
+				--empty_cells_;
+			}
+			it->second.emplace_back(index);
+		}
+	}
+}
+
+void SpatialHashGrid::RemoveFromCells(std::uint32_t index) {
+	const auto& object{ objects_[index] };
+
+	const auto swap_remove = [index](std::vector<std::uint32_t>& indices) {
+		auto it{ std::ranges::find(indices, index) };
+		PTGN_ASSERT(it != indices.end(), "Spatial hash grid object missing from its cell");
+		*it = indices.back();
+		indices.pop_back();
+	};
+
+	if (object.oversized) {
+		swap_remove(oversized_);
+		return;
+	}
+
+	for (int y{ object.cells.min.y }; y <= object.cells.max.y; ++y) {
+		for (int x{ object.cells.min.x }; x <= object.cells.max.x; ++x) {
+			auto it{ cells_.find(GetKey(x, y)) };
+			PTGN_ASSERT(it != cells_.end(), "Spatial hash grid object missing from its cell");
+			swap_remove(it->second);
+			if (it->second.empty()) {
+				++empty_cells_;
+			}
+		}
+	}
+}
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
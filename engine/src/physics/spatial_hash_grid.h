@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "core/ecs/entity.h"
+#include "math/vector2.h"
+#include "physics/bounding_aabb.h"
+#include "physics/broadphase.h"
+
+namespace ptgn {
+
+namespace impl {
+
+// Uniform grid of square cells stored in a hash map, so the world does not need to be bounded.
+// Every object is listed in each cell its bounding AABB touches. Objects which move within the
+// same cells only update their bounding AABB. Best suited to large numbers of objects of similar
+// size, where the cell size is chosen close to the typical object size.
+// Unlike the KDTree, changes are applied to the grid immediately.
+class SpatialHashGrid : public Broadphase {
+public:
+	// @param cell_size Side length of each grid cell.
+	explicit SpatialHashGrid(float cell_size = 64.0f);
+
+	// Clears the grid and inserts every object.
+	void Build(const std::vector<KDObject>& objects) override;
+
+	// Inserts the entity if it is not in the grid yet.
+	void UpdateBoundingAABB(const Entity& e, const BoundingAABB& aabb) override;
+
+	void Insert(const Entity& e, const BoundingAABB& aabb) override;
+
+	void Remove(const Entity& e) override;
+
+	// Counts a refit if any object changed cells since the previous call.
+	void EndFrameUpdate() override;
+
+	void Update(const std::vector<KDObject>& objects) override;
+
+	[[nodiscard]] const BroadphaseStats& GetStats() const override;
+
+	void ResetStats() override;
+
+	void FindPairs(std::vector<BroadphasePair>& pairs) const override;
+
+	std::vector<Entity> Query(const BoundingAABB& region) const override;
+
+	std::vector<Entity> Query(const V2_float& point) const override;
+
+	using Broadphase::Raycast;
+
+	void Raycast(
+		const Entity& entity, const V2_float& dir, const BoundingAABB& aabb,
+		std::vector<Entity>& hits
+	) const override;
+
+	Entity RaycastFirst(const Entity& entity, const V2_float& dir, const BoundingAABB& aabb)
+		const override;
+
+private:
+	// Objects which touch more cells than this are kept in a separate list and tested linearly,
+	// so that a few very large colliders (i.e. level boundaries) do not fill the grid.
+	constexpr static std::int64_t max_object_cells_{ 64 };
+
+	// Inclusive range of cell coordinates.
+	struct CellRange {
+		V2_int min;
+		V2_int max;
+
+		[[nodiscard]] std::int64_t GetCount() const;
+
+		bool operator==(const CellRange&) const = default;
+	};
+
+	struct Object {
+		Entity entity;
+		BoundingAABB aabb;
+		CellRange cells;
+		// Object is in oversized_ instead of the grid cells.
+		bool oversized{ false };
+		// Slot is in use. Unused slots are listed in free_.
+		bool alive{ false };
+		// Value of stamp_ during the last Update() which contained the object.
+		std::uint32_t stamp{ 0 };
+	};
+
+	[[nodiscard]] V2_int GetCell(const V2_float& point) const;
+
+	[[nodiscard]] CellRange GetCellRange(const BoundingAABB& aabb) const;
+
+	// Packs cell coordinates into a single hash map key.
+	[[nodiscard]] static std::uint64_t GetKey(int x, int y);
+
+	[[nodiscard]] static V2_int GetCellFromKey(std::uint64_t key);
+
+	void AddToCells(std::uint32_t index);
+
+	void RemoveFromCells(std::uint32_t index);
+
+	// Visits every object whose bounding AABB overlaps region exactly once.
+	template <typename VisitFunc>
+	void ForEachOverlapping(const BoundingAABB& region, VisitFunc&& visit) const;
+
+	// Cell size and its inverse.
+	float cell_size_{ 64.0f };
+	float inverse_cell_size_{ 1.0f / 64.0f };
+
+	std::vector<Object> objects_;
+
+	// Indices of unused slots in objects_.
+	std::vector<std::uint32_t> free_;
+
+	std::unordered_map<Entity, std::uint32_t> indices_;
+
+	// Object indices of every object touching a cell. Emptied cells keep their capacity until
+	// enough of them accumulate.
+	std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> cells_;
+	std::size_t empty_cells_{ 0 };
+
+	std::vector<std::uint32_t> oversized_;
+
+	// Entities which were not part of the latest Update(). Kept to reuse its capacity.
+	std::vector<Entity> stale_;
+
+	std::uint32_t stamp_{ 0 };
+
+	// An object changed cells since the last EndFrameUpdate().
+	bool changed_{ false };
+
+	BroadphaseStats stats_;
+};
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
@@ -1,9 +1,15 @@
 #include "renderer/api/vertex.h"
 
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 
 #include "core/ecs/components/draw.h"
 #include "debug/runtime/assert.h"
+#include "math/tolerance.h"
 #include "math/vector2.h"
 #include "renderer/api/color.h"
 #include "renderer/api/flip.h"
@@ -69,4 +75,91 @@ void Vertex::SetTextureIndex(std::array<Vertex, 4>& vertices, float texture_inde
 	}
 }
 
+// Rounds to the nearest 16 bit float. Values outside of the 16 bit range become infinite.
+static glsl::half ToHalf(float value) {
+	auto bits{ std::bit_cast<std::uint32_t>(value) };
+
+	std::uint32_t sign{ (bits >> 16) & 0x8000 };
+	std::int32_t exponent{ static_cast<std::int32_t>((bits >> 23) & 0xFF) - 127 + 15 };
+	std::uint32_t mantissa{ bits & 0x7FFFFF };
+
+	if (exponent >= 31) {
+		return static_cast<glsl::half>(sign | 0x7C00);
+	}
+
+	if (exponent <= 0) {
+		// Subnormal 16 bit float, or zero if too small.
+		if (exponent < -10) {
+			return static_cast<glsl::half>(sign);
+		}
+		mantissa |= 0x800000;
+		auto shift{ static_cast<std::uint32_t>(14 - exponent) };
+		std::uint32_t result{ mantissa >> shift };
+		if ((mantissa >> (shift - 1)) & 1) {
+			++result;
+		}
+		return static_cast<glsl::half>(sign | result);
+	}
+
+	std::uint32_t result{ sign | (static_cast<std::uint32_t>(exponent) << 10) | (mantissa >> 13) };
+	// A carry out of the mantissa correctly increments the exponent.
+	if (mantissa & 0x1000) {
+		++result;
+	}
+	return static_cast<glsl::half>(result);
+}
+
+template <typename T>
+static T ToNormalized(float value) {
+	constexpr float max{ static_cast<float>(std::numeric_limits<T>::max()) };
+	return static_cast<T>(std::lround(std::clamp(value, 0.0f, 1.0f) * max));
+}
+
+PackedVertex PackedVertex::Pack(const Vertex& vertex) {
+	PackedVertex packed;
+	packed.position = vertex.position;
+	for (std::size_t i{ 0 }; i < packed.color.size(); ++i) {
+		packed.color[i] = ToNormalized<std::uint8_t>(vertex.color[i]);
+	}
+	for (std::size_t i{ 0 }; i < packed.tex_coord.size(); ++i) {
+		packed.tex_coord[i] = ToNormalized<std::uint16_t>(vertex.tex_coord[i]);
+	}
+	for (std::size_t i{ 0 }; i < packed.data.size(); ++i) {
+		packed.data[i] = ToHalf(vertex.data[i]);
+	}
+	return packed;
+}
+
+bool QuadInstance::CanInstance(
+	const std::array<V2_float, 4>& quad_points, const std::array<V2_float, 4>& texture_coordinates
+) {
+	constexpr float epsilon{ 0.001f };
+
+	const auto& p{ quad_points };
+	const auto& t{ texture_coordinates };
+
+	return NearlyEqual(p[0].x + p[2].x, p[1].x + p[3].x, epsilon) &&
+		   NearlyEqual(p[0].y + p[2].y, p[1].y + p[3].y, epsilon) && t[1].x == t[2].x &&
+		   t[1].y == t[0].y && t[3].x == t[0].x && t[3].y == t[2].y;
+}
+
+QuadInstance QuadInstance::Get(
+	const std::array<V2_float, 4>& quad_points, const Color& color, const Depth& depth,
+	const std::array<float, 4>& data, const std::array<V2_float, 4>& texture_coordinates
+) {
+	PTGN_ASSERT(CanInstance(quad_points, texture_coordinates));
+
+	auto axis_x{ quad_points[1] - quad_points[0] };
+	auto axis_y{ quad_points[3] - quad_points[0] };
+
+	QuadInstance instance;
+	instance.position	= { quad_points[0].x, quad_points[0].y, static_cast<float>(depth) };
+	instance.axes		= { axis_x.x, axis_x.y, axis_y.x, axis_y.y };
+	instance.tex_coords = { texture_coordinates[0].x, texture_coordinates[0].y,
+							texture_coordinates[2].x, texture_coordinates[2].y };
+	instance.data		= data;
+	instance.color		= { color.r, color.g, color.b, color.a };
+	return instance;
+}
+
 } // namespace ptgn::impl
\ No newline at end of file
@@ -11,6 +11,16 @@ namespace ptgn {
 struct Color;
 struct Depth;
 
+// Layout of the vertices uploaded by the batch renderer.
+enum class VertexFormat {
+	// 32 bit floats for every attribute.
+	Standard,
+	// Normalized RGBA8 color, 16 bit normalized texture coordinates (clamped to [0, 1]) and 16
+	// bit floating point shape data. Less than half the size of the standard format, at the cost
+	// of precision. Positions remain 32 bit floats.
+	Packed
+};
+
 namespace impl {
 
 struct Vertex : public VertexLayout<Vertex, glsl::vec3, glsl::vec4, glsl::vec2, glsl::vec4> {
@@ -35,6 +45,45 @@ struct Vertex : public VertexLayout<Vertex, glsl::vec3, glsl::vec4, glsl::vec2,
 	static void SetTextureIndex(std::array<Vertex, 4>& vertices, float texture_index);
 };
 
+// Vertex of the packed vertex format. Shaders read it through the same inputs as a Vertex.
+struct PackedVertex :
+	public VertexLayout<PackedVertex, glsl::vec3, glsl::u8vec4, glsl::u16vec2, glsl::hvec4> {
+	glsl::vec3 position{};
+	glsl::u8vec4 color{};
+	glsl::u16vec2 tex_coord{};
+	glsl::hvec4 data{};
+
+	[[nodiscard]] static PackedVertex Pack(const Vertex& vertex);
+};
+
+// Compact per-instance attributes of a quad, expanded into its four vertices by the instanced
+// shaders. A quad instance is a quarter of the size of the equivalent four vertices.
+struct QuadInstance :
+	public VertexLayout<
+		QuadInstance, glsl::vec3, glsl::vec4, glsl::vec4, glsl::vec4, glsl::u8vec4> {
+	// First quad point and depth.
+	glsl::vec3 position{};
+	// Edges from the first quad point to the second (xy) and fourth (zw) quad points.
+	glsl::vec4 axes{};
+	// Texture coordinates of the first (xy) and third (zw) quad points.
+	glsl::vec4 tex_coords{};
+	// Same as Vertex::data.
+	glsl::vec4 data{};
+	glsl::u8vec4 color{};
+
+	// @return True if the quad is a parallelogram whose texture coordinates span an axis aligned
+	// rectangle, which is required for it to be drawn as an instance.
+	[[nodiscard]] static bool CanInstance(
+		const std::array<V2_float, 4>& quad_points,
+		const std::array<V2_float, 4>& texture_coordinates
+	);
+
+	[[nodiscard]] static QuadInstance Get(
+		const std::array<V2_float, 4>& quad_points, const Color& color, const Depth& depth,
+		const std::array<float, 4>& data, const std::array<V2_float, 4>& texture_coordinates
+	);
+};
+
 } // namespace impl
 
 } // namespace ptgn
\ No newline at end of file
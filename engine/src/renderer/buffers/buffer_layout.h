@@ -13,12 +13,13 @@ namespace ptgn::impl {
 struct BufferElement {
 	constexpr BufferElement(
 		std::uint16_t buffer_size, std::uint16_t buffer_count, impl::GLType buffer_type,
-		bool buffer_is_integer
+		bool buffer_is_integer, bool buffer_normalized = false
 	) :
 		size{ buffer_size },
 		count{ buffer_count },
 		type{ buffer_type },
-		is_integer{ buffer_is_integer } {}
+		is_integer{ buffer_is_integer },
+		normalized{ buffer_normalized } {}
 
 	std::uint16_t size{ 0 };  // Number of elements x Size of element.
 	std::uint16_t count{ 0 }; // Number of elements
@@ -53,12 +54,18 @@ struct BufferLayout {
 			   std::is_same_v<V, std::uint32_t>;
 	}
 
+	template <VertexDataType T>
+	[[nodiscard]] constexpr static bool IsNormalized() {
+		using V = typename T::value_type;
+		return std::is_same_v<V, std::uint8_t> || std::is_same_v<V, std::uint16_t>;
+	}
+
 	std::int32_t stride_{ 0 };
 
 	std::array<impl::BufferElement, sizeof...(Ts)> elements_{ impl::BufferElement{
 		static_cast<std::uint16_t>(sizeof(Ts)),
 		static_cast<std::uint16_t>(std::tuple_size<Ts>::value),
-		impl::GetType<typename Ts::value_type>(), IsInteger<Ts>() }... };
+		impl::GetType<typename Ts::value_type>(), IsInteger<Ts>(), IsNormalized<Ts>() }... };
 
 	constexpr void CalculateOffsets() {
 		std::size_t offset{ 0 };
@@ -200,7 +200,7 @@ void FrameBuffer::SetDrawBuffer(FrameBufferAttachment attachment) {
 		std::vector<GLenum> attachments{ static_cast<GLenum>(attachment) };
 		GLCall(DrawBuffers(static_cast<GLsizei>(attachments.size()), attachments.data()));
 	} else {
-		glDrawBuffer(GL_NONE);
+		GLCall(glDrawBuffer(GL_NONE));
 	}
 }
 
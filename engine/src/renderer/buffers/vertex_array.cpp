@@ -20,15 +20,17 @@ VertexArray::VertexArray(VertexArray&& other) noexcept :
 	id_{ std::exchange(other.id_, 0) },
 	mode_{ other.mode_ },
 	vertex_buffer_{ std::exchange(other.vertex_buffer_, {}) },
-	index_buffer_{ std::exchange(other.index_buffer_, {}) } {}
+	index_buffer_{ std::exchange(other.index_buffer_, {}) },
+	instance_buffer_{ std::exchange(other.instance_buffer_, {}) } {}
 
 VertexArray& VertexArray::operator=(VertexArray&& other) noexcept {
 	if (this != &other) {
 		DeleteVertexArray();
-		id_			   = std::exchange(other.id_, 0);
-		mode_		   = other.mode_;
-		vertex_buffer_ = std::exchange(other.vertex_buffer_, {});
-		index_buffer_  = std::exchange(other.index_buffer_, {});
+		id_				 = std::exchange(other.id_, 0);
+		mode_			 = other.mode_;
+		vertex_buffer_	 = std::exchange(other.vertex_buffer_, {});
+		index_buffer_	 = std::exchange(other.index_buffer_, {});
+		instance_buffer_ = std::exchange(other.instance_buffer_, {});
 	}
 	return *this;
 }
@@ -117,8 +119,15 @@ void VertexArray::SetIndexBuffer(IndexBuffer&& index_buffer) {
 	index_buffer_.Bind();
 }
 
+void VertexArray::SetInstanceBuffer(VertexBuffer&& instance_buffer) {
+	PTGN_ASSERT(IsBound(), "Vertex array must be bound before setting instance buffer");
+	PTGN_ASSERT(instance_buffer.IsValid(), "Cannot set instance buffer which is uninitialized");
+	instance_buffer_ = std::move(instance_buffer);
+	instance_buffer_.Bind();
+}
+
 void VertexArray::SetBufferElement(
-	std::uint32_t i, const BufferElement& element, std::int32_t stride
+	std::uint32_t i, const BufferElement& element, std::int32_t stride, std::uint32_t divisor
 ) const {
 	GLCall(EnableVertexAttribArray(i));
 	if (element.is_integer) {
@@ -126,13 +135,17 @@ void VertexArray::SetBufferElement(
 			i, element.count, static_cast<GLenum>(element.type), stride,
 			reinterpret_cast<const void*>(element.offset)
 		));
-		return;
+	} else {
+		GLCall(VertexAttribPointer(
+			i, element.count, static_cast<GLenum>(element.type),
+			element.normalized ? static_cast<GLboolean>(GL_TRUE)
+							   : static_cast<GLboolean>(GL_FALSE),
+			stride, reinterpret_cast<const void*>(element.offset)
+		));
+	}
+	if (divisor != 0) {
+		GLCall(VertexAttribDivisor(i, divisor));
 	}
-	GLCall(VertexAttribPointer(
-		i, element.count, static_cast<GLenum>(element.type),
-		element.normalized ? static_cast<GLboolean>(GL_TRUE) : static_cast<GLboolean>(GL_FALSE),
-		stride, reinterpret_cast<const void*>(element.offset)
-	));
 }
 
 bool VertexArray::HasVertexBuffer() const {
@@ -143,6 +156,10 @@ bool VertexArray::HasIndexBuffer() const {
 	return index_buffer_.IsValid();
 }
 
+bool VertexArray::HasInstanceBuffer() const {
+	return instance_buffer_.IsValid();
+}
+
 const VertexBuffer& VertexArray::GetVertexBuffer() const {
 	return vertex_buffer_;
 }
@@ -159,6 +176,14 @@ IndexBuffer& VertexArray::GetIndexBuffer() {
 	return index_buffer_;
 }
 
+const VertexBuffer& VertexArray::GetInstanceBuffer() const {
+	return instance_buffer_;
+}
+
+VertexBuffer& VertexArray::GetInstanceBuffer() {
+	return instance_buffer_;
+}
+
 PrimitiveMode VertexArray::GetPrimitiveMode() const {
 	return mode_;
 }
@@ -27,6 +27,20 @@ public:
 		SetVertexBufferLayout(vertex_buffer_layout);
 	}
 
+	// Vertex array whose vertices are drawn once for each element of the instance buffer. The
+	// attributes of the instance buffer follow those of the vertex buffer.
+	template <typename... Ts, typename... Us>
+	VertexArray(
+		PrimitiveMode mode, VertexBuffer&& vertex_buffer,
+		const BufferLayout<Ts...>& vertex_buffer_layout, IndexBuffer&& index_buffer,
+		VertexBuffer&& instance_buffer, const BufferLayout<Us...>& instance_buffer_layout
+	) :
+		VertexArray{ mode, std::move(vertex_buffer), vertex_buffer_layout,
+					 std::move(index_buffer) } {
+		SetInstanceBuffer(std::move(instance_buffer));
+		SetBufferLayout(instance_buffer_layout, sizeof...(Ts), 1);
+	}
+
 	VertexArray(const VertexArray&)			   = delete;
 	VertexArray& operator=(const VertexArray&) = delete;
 	VertexArray(VertexArray&& other) noexcept;
@@ -40,36 +54,24 @@ public:
 	void SetPrimitiveMode(PrimitiveMode mode);
 	void SetVertexBuffer(VertexBuffer&& new_vertex_buffer);
 	void SetIndexBuffer(IndexBuffer&& new_index_buffer);
+	void SetInstanceBuffer(VertexBuffer&& new_instance_buffer);
 
 	template <VertexDataType... Ts>
 		requires NonEmptyPack<Ts...>
 	void SetVertexBufferLayout(const BufferLayout<Ts...>& layout) {
-		PTGN_ASSERT(
-			!layout.IsEmpty(),
-			"Cannot add a vertex buffer with an empty (unset) layout to a vertex array"
-		);
-
-		const auto& elements{ layout.GetElements() };
-		PTGN_ASSERT(
-			elements.size() < GetMaxAttributes(),
-			"Vertex buffer layout cannot exceed maximum number of vertex array attributes"
-		);
-
-		auto stride{ layout.GetStride() };
-		PTGN_ASSERT(stride > 0, "Failed to calculate buffer layout stride");
-
-		for (std::uint32_t i{ 0 }; i < elements.size(); ++i) {
-			SetBufferElement(i, elements[i], stride);
-		}
+		SetBufferLayout(layout, 0, 0);
 	}
 
 	[[nodiscard]] bool HasVertexBuffer() const;
 	[[nodiscard]] bool HasIndexBuffer() const;
+	[[nodiscard]] bool HasInstanceBuffer() const;
 
 	[[nodiscard]] const VertexBuffer& GetVertexBuffer() const;
 	[[nodiscard]] VertexBuffer& GetVertexBuffer();
 	[[nodiscard]] const IndexBuffer& GetIndexBuffer() const;
 	[[nodiscard]] IndexBuffer& GetIndexBuffer();
+	[[nodiscard]] const VertexBuffer& GetInstanceBuffer() const;
+	[[nodiscard]] VertexBuffer& GetInstanceBuffer();
 
 	[[nodiscard]] PrimitiveMode GetPrimitiveMode() const;
 
@@ -96,13 +98,43 @@ private:
 	void GenerateVertexArray();
 	void DeleteVertexArray() noexcept;
 
-	void SetBufferElement(std::uint32_t index, const BufferElement& element, std::int32_t stride)
-		const;
+	// Sets up the attributes of the currently bound vertex buffer.
+	// @param first_attribute Attribute index of the first layout element.
+	// @param divisor Number of instances drawn before the attributes advance, 0 for every vertex.
+	template <VertexDataType... Ts>
+		requires NonEmptyPack<Ts...>
+	void SetBufferLayout(
+		const BufferLayout<Ts...>& layout, std::uint32_t first_attribute, std::uint32_t divisor
+	) {
+		PTGN_ASSERT(
+			!layout.IsEmpty(),
+			"Cannot add a vertex buffer with an empty (unset) layout to a vertex array"
+		);
+
+		const auto& elements{ layout.GetElements() };
+		PTGN_ASSERT(
+			first_attribute + elements.size() < GetMaxAttributes(),
+			"Vertex buffer layout cannot exceed maximum number of vertex array attributes"
+		);
+
+		auto stride{ layout.GetStride() };
+		PTGN_ASSERT(stride > 0, "Failed to calculate buffer layout stride");
+
+		for (std::uint32_t i{ 0 }; i < elements.size(); ++i) {
+			SetBufferElement(first_attribute + i, elements[i], stride, divisor);
+		}
+	}
+
+	void SetBufferElement(
+		std::uint32_t index, const BufferElement& element, std::int32_t stride,
+		std::uint32_t divisor
+	) const;
 
 	std::uint32_t id_{ 0 };
 	PrimitiveMode mode_{ PrimitiveMode::Triangles };
 	VertexBuffer vertex_buffer_;
 	IndexBuffer index_buffer_;
+	VertexBuffer instance_buffer_;
 };
 
 } // namespace ptgn::impl
\ No newline at end of file
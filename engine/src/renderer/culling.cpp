@@ -0,0 +1,243 @@
+#include "renderer/culling.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "core/ecs/components/draw.h"
+#include "core/ecs/components/drawable.h"
+#include "core/ecs/components/sprite.h"
+#include "core/ecs/components/transform.h"
+#include "core/ecs/entity.h"
+#include "core/utils/type_info.h"
+#include "debug/runtime/assert.h"
+#include "math/geometry/shape.h"
+#include "math/hash.h"
+#include "math/math_utils.h"
+#include "math/vector2.h"
+#include "physics/bounding_aabb.h"
+#include "renderer/materials/texture.h"
+#include "renderer/text/glyph_atlas.h"
+#include "renderer/text/text.h"
+#include "world/scene/camera.h"
+
+namespace ptgn::impl {
+
+// @return True if the drawable only draws its sprite or shape component.
+static bool DrawsSpriteOrShape(std::size_t hash) {
+	static constexpr std::array hashes{ Hash(type_name<Sprite>()),	 Hash(type_name<Rect>()),
+										Hash(type_name<Circle>()),	 Hash(type_name<Ellipse>()),
+										Hash(type_name<Polygon>()),	 Hash(type_name<Triangle>()),
+										Hash(type_name<Line>()),	 Hash(type_name<RoundedRect>()),
+										Hash(type_name<Arc>()),		 Hash(type_name<Capsule>()) };
+	return std::ranges::find(hashes, hash) != hashes.end();
+}
+
+// @return Bounds of the drawable in world space, or std::nullopt if they are not known.
+static std::optional<BoundingAABB> GetDrawBounds(const Entity& entity) {
+	if (entity.GetNonPrimaryCamera() != nullptr) {
+		return std::nullopt;
+	}
+
+	auto hash{ entity.Get<IDrawable>().hash };
+
+	std::optional<Shape> shape;
+	if (hash == Hash(type_name<Text>())) {
+		// HD text is rescaled relative to the render target while drawing.
+		if (Text{ entity }.IsHD()) {
+			return std::nullopt;
+		}
+		if (const auto* layout{ entity.TryGet<TextLayout>() }; layout != nullptr) {
+			if (!layout->size.BothAboveZero()) {
+				return std::nullopt;
+			}
+			shape = Rect{ V2_float{ layout->size } };
+		} else if (entity.Has<Texture>() && entity.Get<Texture>().IsValid()) {
+			shape = Rect{ V2_float{ entity.Get<Texture>().GetSize() } };
+		} else {
+			return std::nullopt;
+		}
+	} else if (DrawsSpriteOrShape(hash)) {
+		shape = GetSpriteOrShape(entity);
+	}
+
+	if (!shape) {
+		return std::nullopt;
+	}
+
+	auto transform{ OffsetByOrigin(*shape, GetDrawTransform(entity), entity) };
+	auto bounds{ GetBoundingAABB(ColliderShape{ *shape }, transform) };
+
+	// Outlines and lines extend past the shape by up to their line width.
+	auto scale{ Abs(transform.GetScale()) };
+	float line_width{ Abs(entity.GetOrDefault<LineWidth>().GetValue()) };
+	return bounds.Expand(line_width * std::max(scale.x, scale.y));
+}
+
+void DisplayListCuller::Add(const Entity& entity) {
+	if (!enabled_) {
+		return;
+	}
+	if (manager_ == nullptr) {
+		manager_ = &entity.GetManager();
+	}
+	++entity_count_;
+	auto [it, inserted] = records_.try_emplace(entity);
+	auto& record{ it->second };
+	++record.count;
+	if (inserted) {
+		// New entities are drawn until their bounds are computed.
+		record.unbounded_index = unbounded_.size();
+		unbounded_.emplace_back(entity);
+		pending_.emplace_back(entity);
+	}
+}
+
+void DisplayListCuller::Remove(const Entity& entity) {
+	if (!enabled_) {
+		return;
+	}
+	auto it{ records_.find(entity) };
+	if (it == records_.end()) {
+		return;
+	}
+	const auto& record{ it->second };
+	entity_count_ -= record.count;
+	if (record.bounded) {
+		grid_.Remove(entity);
+	} else {
+		RemoveUnbounded(record);
+	}
+	records_.erase(it);
+}
+
+void DisplayListCuller::Clear() {
+	grid_.Build({});
+	records_.clear();
+	unbounded_.clear();
+	pending_.clear();
+	entity_count_ = 0;
+}
+
+std::optional<BoundingAABB> DisplayListCuller::UpdateBounds(const Entity& entity, Record& record) {
+	// Entities without a transform have no world transform cache entry, so their movement is not
+	// observed.
+	std::optional<BoundingAABB> bounds;
+	if (entity.Has<Transform>()) {
+		bounds = GetDrawBounds(entity);
+	}
+	if (bounds) {
+		if (!record.bounded) {
+			RemoveUnbounded(record);
+			record.bounded = true;
+		}
+		grid_.UpdateBoundingAABB(entity, *bounds);
+	} else if (record.bounded) {
+		grid_.Remove(entity);
+		record.bounded		   = false;
+		record.unbounded_index = unbounded_.size();
+		unbounded_.emplace_back(entity);
+	}
+	return bounds;
+}
+
+void DisplayListCuller::RemoveUnbounded(const Record& record) {
+	PTGN_ASSERT(record.unbounded_index < unbounded_.size());
+	if (record.unbounded_index + 1 != unbounded_.size()) {
+		const auto& last{ unbounded_.back() };
+		records_.at(last).unbounded_index = record.unbounded_index;
+		unbounded_[record.unbounded_index] = last;
+	}
+	unbounded_.pop_back();
+}
+
+void DisplayListCuller::Rebuild(const std::vector<Entity>& display_list) {
+	Clear();
+	for (const auto& entity : display_list) {
+		Add(entity);
+	}
+}
+
+void DisplayListCuller::Cull(
+	const std::vector<Entity>& display_list, const Camera& camera, std::vector<Entity>& visible
+) {
+	culled_count_ = 0;
+
+	if (!enabled_) {
+		visible.insert(visible.end(), display_list.begin(), display_list.end());
+		return;
+	}
+
+	if (entity_count_ != display_list.size()) {
+		Rebuild(display_list);
+	}
+
+	for (const auto& entity : pending_) {
+		if (auto it{ records_.find(entity) }; it != records_.end()) {
+			UpdateBounds(entity, it->second);
+		}
+	}
+	pending_.clear();
+
+	if (manager_ != nullptr) {
+		const auto& cache{ WorldTransformCacheState::Of(*manager_) };
+		if (cache.generation != 0 && cache.generation == generation_ + 1) {
+			for (const auto& entity : cache.changed) {
+				if (auto it{ records_.find(entity) }; it != records_.end()) {
+					UpdateBounds(entity, it->second);
+				}
+			}
+		} else if (cache.generation == 0 || cache.generation != generation_) {
+			// Cache updates were missed, for instance while the render target was hidden, or the
+			// cache is not in use, so every bounded entity may have moved.
+			for (auto& [entity, record] : records_) {
+				if (record.bounded) {
+					UpdateBounds(entity, record);
+				}
+			}
+		}
+		generation_ = cache.generation;
+	}
+
+	auto first_visible{ visible.size() };
+
+	visible.insert(visible.end(), unbounded_.begin(), unbounded_.end());
+
+	grid_.EndFrameUpdate();
+
+	BoundingAABB view{ BoundingAABB::Empty() };
+	for (const auto& vertex : camera.GetWorldVertices()) {
+		view = view.Merge(BoundingAABB{ vertex, vertex });
+	}
+
+	// Drawables in view may have changed size without moving, so their bounds are refreshed.
+	for (const auto& entity : grid_.Query(view)) {
+		auto bounds{ UpdateBounds(entity, records_.at(entity)) };
+		if (!bounds || bounds->Overlaps(view)) {
+			visible.emplace_back(entity);
+		}
+	}
+
+	culled_count_ = display_list.size() - (visible.size() - first_visible);
+}
+
+void DisplayListCuller::SetEnabled(bool enabled) {
+	if (enabled && !enabled_) {
+		// Display list changes and transforms which changed while culling was disabled were not
+		// observed, so the display list is reindexed by the next Cull().
+		Clear();
+	}
+	enabled_ = enabled;
+}
+
+bool DisplayListCuller::IsEnabled() const {
+	return enabled_;
+}
+
+std::size_t DisplayListCuller::GetCulledCount() const {
+	return culled_count_;
+}
+
+} // namespace ptgn::impl
\ No newline at end of file
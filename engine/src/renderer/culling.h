@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "core/ecs/entity.h"
+#include "physics/bounding_aabb.h"
+#include "physics/spatial_hash_grid.h"
+
+namespace ptgn {
+
+class Camera;
+class Manager;
+
+namespace impl {
+
+// Persistent spatial index of the drawables in a display list, used to drop drawables which lie
+// outside of the camera view before they are sorted and drawn. The culler is notified when
+// entities are added to or removed from the display list, and only recomputes the bounds of new
+// drawables, of drawables whose world transform was recomputed by the latest world transform
+// cache update and of drawables currently in view. Only the grid cells overlapping the view are
+// visited, so a frame costs time proportional to what is visible and what moved, rather than to
+// the size of the display list.
+// Drawables without known bounds (particles, lights, graphics, entities without a transform,
+// etc.) and drawables relative to a non-primary camera are never culled. An off-screen drawable
+// whose size changes without moving keeps its old bounds until it moves or comes into view, and
+// may therefore not be drawn when it grows into view. For this reason culling is disabled by
+// default.
+class DisplayListCuller {
+public:
+	// Notifies the culler that the entity was added to the display list.
+	void Add(const Entity& entity);
+
+	// Notifies the culler that every occurrence of the entity was removed from the display list.
+	void Remove(const Entity& entity);
+
+	// Notifies the culler that the display list was cleared.
+	void Clear();
+
+	// Appends the entities of the display list which may be visible to the camera to visible.
+	// The order of the appended entities is unspecified. If the size of the display list does not
+	// match the notified additions and removals, such as after modifying the display list
+	// directly, every entity of the display list is reindexed.
+	void Cull(
+		const std::vector<Entity>& display_list, const Camera& camera,
+		std::vector<Entity>& visible
+	);
+
+	void SetEnabled(bool enabled);
+
+	[[nodiscard]] bool IsEnabled() const;
+
+	// @return Number of display list entities skipped by the most recent Cull().
+	[[nodiscard]] std::size_t GetCulledCount() const;
+
+private:
+	struct Record {
+		// Number of occurrences of the entity in the display list.
+		std::size_t count{ 0 };
+		// Index of the entity in unbounded_ if it has no bounds.
+		std::size_t unbounded_index{ 0 };
+		// Entity has bounds and is stored in the grid.
+		bool bounded{ false };
+	};
+
+	// Recomputes the bounds of the entity and moves it between the grid and unbounded_.
+	// @return Bounds of the entity, or std::nullopt if they are not known.
+	std::optional<BoundingAABB> UpdateBounds(const Entity& entity, Record& record);
+
+	void RemoveUnbounded(const Record& record);
+
+	// Reindexes every entity of the display list.
+	void Rebuild(const std::vector<Entity>& display_list);
+
+	SpatialHashGrid grid_{ 256.0f };
+
+	std::unordered_map<Entity, Record> records_;
+
+	// Entities which are never culled.
+	std::vector<Entity> unbounded_;
+
+	// Entities added since the latest Cull() whose bounds have not been computed yet.
+	std::vector<Entity> pending_;
+
+	// Manager of the display list entities, whose world transform cache reports moved entities.
+	const Manager* manager_{ nullptr };
+
+	// World transform cache generation whose moved entities were last applied.
+	std::uint64_t generation_{ 0 };
+
+	// Total number of occurrences of the recorded entities in the display list.
+	std::size_t entity_count_{ 0 };
+
+	std::size_t culled_count_{ 0 };
+
+	bool enabled_{ false };
+};
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
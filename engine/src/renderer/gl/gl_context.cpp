@@ -14,6 +14,7 @@
 #include "debug/core/log.h"
 #include "debug/runtime/assert.h"
 #include "renderer/gl/gl_loader.h"
+#include "renderer/gl/gl_null.h"
 #include "SDL_error.h"
 #include "SDL_video.h"
 
@@ -21,6 +22,8 @@
 
 namespace ptgn::impl {
 
+bool GLContext::null_{ false };
+
 GLVersion::GLVersion() {
 	int r = SDL_GL_GetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, &major);
 	PTGN_ASSERT(r == 0, SDL_GetError());
@@ -96,7 +99,7 @@ void GLContext::LoadGLFunctions() {
 }
 
 bool GLContext::IsInitialized() const {
-	return context_ != nullptr;
+	return context_ != nullptr || null_;
 }
 
 void GLContext::Init() {
@@ -128,13 +131,46 @@ void GLContext::Init() {
 	LoadGLFunctions();
 }
 
+void GLContext::InitNull() {
+	if (IsInitialized()) {
+		return;
+	}
+
+	null_ = true;
+	null_gl::Reset();
+	ResetNullStats();
+
+	PTGN_INFO("Initialized null OpenGL backend");
+}
+
 void GLContext::Shutdown() {
+	if (null_) {
+		null_ = false;
+		null_gl::Reset();
+		PTGN_INFO("Destroyed null OpenGL backend");
+		return;
+	}
 	SDL_GL_DeleteContext(context_);
 	context_ = nullptr;
 	PTGN_INFO("Destroyed OpenGL context");
 }
 
+bool GLContext::IsNull() {
+	return null_;
+}
+
+const NullGLStats& GLContext::GetNullStats() {
+	return null_gl::GetStats();
+}
+
+void GLContext::ResetNullStats() {
+	null_gl::GetStats() = {};
+}
+
 void GLContext::ClearErrors() {
+	if (null_) {
+		return;
+	}
 	while (game.running_ && game.gl_context_->IsInitialized() &&
 		   game.sdl_instance_->IsInitialized() && glGetError() != static_cast<GLenum>(GLError::None)
 	) { /* glGetError clears the error queue */
@@ -143,6 +179,9 @@ void GLContext::ClearErrors() {
 
 std::vector<GLError> GLContext::GetErrors() {
 	std::vector<GLError> errors;
+	if (null_) {
+		return errors;
+	}
 	while (game.running_ && game.gl_context_->IsInitialized() && game.sdl_instance_->IsInitialized()
 	) {
 		GLenum error{ glGetError() };
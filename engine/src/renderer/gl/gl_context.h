@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <iosfwd>
 #include <string_view>
 #include <vector>
@@ -25,6 +26,26 @@ struct GLVersion {
 	int minor{ 0 };
 };
 
+// Calls recorded by the null OpenGL backend since the last ResetNullStats().
+struct NullGLStats {
+	std::uint64_t draw_calls{ 0 };
+	// Instances drawn across all draw calls. Non-instanced draw calls count as one instance.
+	std::uint64_t instances{ 0 };
+	std::uint64_t clears{ 0 };
+	std::uint64_t shader_binds{ 0 };
+	std::uint64_t texture_binds{ 0 };
+	std::uint64_t buffer_binds{ 0 };
+	std::uint64_t vertex_array_binds{ 0 };
+	std::uint64_t frame_buffer_binds{ 0 };
+	std::uint64_t buffer_uploads{ 0 };
+	std::uint64_t buffer_upload_bytes{ 0 };
+	std::uint64_t texture_uploads{ 0 };
+	std::uint64_t texture_upload_pixels{ 0 };
+	std::uint64_t uniform_updates{ 0 };
+	// Blend, depth, stencil, viewport, capability and other fixed function state changes.
+	std::uint64_t state_changes{ 0 };
+};
+
 // Must be constructed after SDL_Window has been created.
 class GLContext {
 public:
@@ -38,8 +59,20 @@ public:
 	[[nodiscard]] bool IsInitialized() const;
 
 	void Init();
+
+	// Initializes the null OpenGL backend instead of creating a context. Every GLCall is then
+	// recorded in the null backend stats rather than executed, so no window or driver is needed.
+	void InitNull();
+
 	void Shutdown();
 
+	// @return True if GL calls are routed to the null backend.
+	[[nodiscard]] static bool IsNull();
+
+	[[nodiscard]] static const NullGLStats& GetNullStats();
+
+	static void ResetNullStats();
+
 	static void ClearErrors();
 
 	[[nodiscard]] static std::vector<GLError> GetErrors();
@@ -55,6 +88,8 @@ private:
 	static void LoadGLFunctions();
 
 	void* context_{ nullptr };
+
+	static bool null_;
 };
 
 } // namespace ptgn::impl
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "debug/runtime/debug_system.h"
 #include "debug/runtime/stats.h"
 #include "renderer/gl/gl_context.h"
+#include "renderer/gl/gl_null.h"
 
 #ifdef PTGN_DEBUG
 // Uncomment for debugging purposes
@@ -30,6 +31,10 @@ namespace ptgn::impl {
 #define GLCall(x)                                                     \
 	std::invoke([&, fn = PTGN_FUNCTION_NAME()]() {                    \
 		++game.debug.stats.gl_calls;                                  \
+		if (ptgn::impl::GLContext::IsNull()) {                        \
+			ptgn::impl::null_gl::x;                                   \
+			return;                                                   \
+		}                                                             \
 		ptgn::impl::GLContext::ClearErrors();                         \
 		x;                                                            \
 		auto errors{ ptgn::impl::GLContext::GetErrors() };            \
@@ -43,6 +48,9 @@ namespace ptgn::impl {
 #define GLCallReturn(x)                                               \
 	std::invoke([&, fn = PTGN_FUNCTION_NAME()]() {                    \
 		++game.debug.stats.gl_calls;                                  \
+		if (ptgn::impl::GLContext::IsNull()) {                        \
+			return ptgn::impl::null_gl::x;                            \
+		}                                                             \
 		ptgn::impl::GLContext::ClearErrors();                         \
 		auto value{ x };                                              \
 		auto errors{ ptgn::impl::GLContext::GetErrors() };            \
@@ -57,8 +65,9 @@ namespace ptgn::impl {
 
 #else
 
-#define GLCall(x)		x
-#define GLCallReturn(x) x
+// In headless mode calls are routed to the null backend function of the same name.
+#define GLCall(x)		(ptgn::impl::GLContext::IsNull() ? ptgn::impl::null_gl::x : x)
+#define GLCallReturn(x) (ptgn::impl::GLContext::IsNull() ? ptgn::impl::null_gl::x : x)
 
 #endif
 
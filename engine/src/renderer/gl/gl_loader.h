@@ -84,6 +84,8 @@ typedef void(GL_APIENTRYP PFNGLCLEARBUFFERUIVPROC)(
 #define EnableVertexAttribArray glEnableVertexAttribArray
 #define VertexAttribIPointer	glVertexAttribIPointer
 #define VertexAttribPointer		glVertexAttribPointer
+#define VertexAttribDivisor		glVertexAttribDivisor
+#define DrawElementsInstanced	glDrawElementsInstanced
 #define CreateProgram			glCreateProgram
 #define DeleteProgram			glDeleteProgram
 #define ValidateProgram			glValidateProgram
@@ -118,8 +120,10 @@ typedef void(GL_APIENTRYP PFNGLCLEARBUFFERUIVPROC)(
 #ifndef PTGN_PLATFORM_MACOS
 
 // Adds ##EXTPROC at the end (emscripten only).
-#define GL_LIST_3                   \
-	GLE(TexStorage2D, TEXSTORAGE2D) \
+#define GL_LIST_3                                     \
+	GLE(TexStorage2D, TEXSTORAGE2D)                   \
+	GLE(VertexAttribDivisor, VERTEXATTRIBDIVISOR)     \
+	GLE(DrawElementsInstanced, DRAWELEMENTSINSTANCED) \
 	/* end */
 
 // Adds ##OESPROC at the end (emscripten only).
@@ -0,0 +1,465 @@
+#include "renderer/gl/gl_null.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "renderer/gl/gl_context.h"
+#include "renderer/gl/gl_loader.h"
+
+namespace ptgn::impl::null_gl {
+
+static constexpr GLint max_texture_units{ 16 };
+static constexpr GLint max_vertex_attributes{ 16 };
+
+struct State {
+	// Shared by every Gen and Create call so that ids are never zero and never reused.
+	GLuint next_id{ 1 };
+
+	GLuint vertex_array{ 0 };
+	GLuint array_buffer{ 0 };
+	GLuint uniform_buffer{ 0 };
+	GLuint draw_frame_buffer{ 0 };
+	GLuint read_frame_buffer{ 0 };
+	GLuint render_buffer{ 0 };
+	GLuint program{ 0 };
+	GLenum active_texture{ GL_TEXTURE0 };
+
+	std::array<GLint, 4> viewport{};
+
+	// Element array buffer binding is part of the vertex array state.
+	std::unordered_map<GLuint, GLuint> element_buffers;
+
+	// Texture bound to each texture unit, keyed by GL_TEXTURE0 + unit.
+	std::unordered_map<GLenum, GLuint> textures;
+
+	std::unordered_map<GLuint, GLint> buffer_sizes;
+
+	std::unordered_map<GLuint, std::unordered_map<GLenum, GLint>> texture_parameters;
+
+	std::unordered_set<GLenum> capabilities;
+};
+
+static State state;
+
+static NullGLStats stats;
+
+static GLuint GenerateId() {
+	return state.next_id++;
+}
+
+static void GenerateIds(GLsizei n, GLuint* ids) {
+	for (GLsizei i{ 0 }; i < n; ++i) {
+		ids[i] = GenerateId();
+	}
+}
+
+static GLuint& GetBoundBuffer(GLenum target) {
+	switch (target) {
+		case GL_ELEMENT_ARRAY_BUFFER: return state.element_buffers[state.vertex_array];
+		case GL_UNIFORM_BUFFER:		  return state.uniform_buffer;
+		default:					  return state.array_buffer;
+	}
+}
+
+static GLuint GetBoundTexture() {
+	auto it{ state.textures.find(state.active_texture) };
+	return it == state.textures.end() ? 0 : it->second;
+}
+
+static void Bind(GLuint& binding, GLuint id, std::uint64_t& counter) {
+	binding = id;
+	++counter;
+}
+
+void Reset() {
+	state = {};
+}
+
+NullGLStats& GetStats() {
+	return stats;
+}
+
+void glEnable(GLenum cap) {
+	state.capabilities.insert(cap);
+	++stats.state_changes;
+}
+
+void glDisable(GLenum cap) {
+	state.capabilities.erase(cap);
+	++stats.state_changes;
+}
+
+void glGetBooleanv(GLenum pname, GLboolean* data) {
+	*data = static_cast<GLboolean>(state.capabilities.contains(pname) ? GL_TRUE : GL_FALSE);
+}
+
+void glGetIntegerv(GLenum pname, GLint* data) {
+	switch (pname) {
+		case GL_VERTEX_ARRAY_BINDING: *data = static_cast<GLint>(state.vertex_array); break;
+		case GL_ARRAY_BUFFER_BINDING: *data = static_cast<GLint>(state.array_buffer); break;
+		case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+			*data = static_cast<GLint>(GetBoundBuffer(GL_ELEMENT_ARRAY_BUFFER));
+			break;
+		case GL_UNIFORM_BUFFER_BINDING: *data = static_cast<GLint>(state.uniform_buffer); break;
+		case GL_DRAW_FRAMEBUFFER_BINDING:
+			*data = static_cast<GLint>(state.draw_frame_buffer);
+			break;
+		case GL_READ_FRAMEBUFFER_BINDING:
+			*data = static_cast<GLint>(state.read_frame_buffer);
+			break;
+		case GL_RENDERBUFFER_BINDING:  *data = static_cast<GLint>(state.render_buffer); break;
+		case GL_TEXTURE_BINDING_2D:	   *data = static_cast<GLint>(GetBoundTexture()); break;
+		case GL_ACTIVE_TEXTURE:		   *data = static_cast<GLint>(state.active_texture); break;
+		case GL_CURRENT_PROGRAM:	   *data = static_cast<GLint>(state.program); break;
+		case GL_MAX_TEXTURE_IMAGE_UNITS: *data = max_texture_units; break;
+		case GL_MAX_VERTEX_ATTRIBS:	   *data = max_vertex_attributes; break;
+		case GL_VIEWPORT:
+			for (std::size_t i{ 0 }; i < state.viewport.size(); ++i) {
+				data[i] = state.viewport[i];
+			}
+			break;
+		default: *data = 0; break;
+	}
+}
+
+void glViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+	state.viewport = { x, y, width, height };
+	++stats.state_changes;
+}
+
+void glPolygonMode(GLenum, GLenum) {
+	++stats.state_changes;
+}
+
+void glDepthFunc(GLenum) {
+	++stats.state_changes;
+}
+
+void glDepthMask(GLboolean) {
+	++stats.state_changes;
+}
+
+void glColorMask(GLboolean, GLboolean, GLboolean, GLboolean) {
+	++stats.state_changes;
+}
+
+void glStencilMask(GLuint) {
+	++stats.state_changes;
+}
+
+void glStencilOp(GLenum, GLenum, GLenum) {
+	++stats.state_changes;
+}
+
+void glStencilFunc(GLenum, GLint, GLuint) {
+	++stats.state_changes;
+}
+
+void glClear(GLbitfield) {
+	++stats.clears;
+}
+
+void glClearColor(GLfloat, GLfloat, GLfloat, GLfloat) {
+	++stats.state_changes;
+}
+
+void glClearDepth(double) {
+	++stats.state_changes;
+}
+
+void ClearBufferfv(GLenum, GLint, const GLfloat*) {
+	++stats.clears;
+}
+
+void ClearBufferuiv(GLenum, GLint, const GLuint*) {
+	++stats.clears;
+}
+
+void BlendEquationSeparate(GLenum, GLenum) {
+	++stats.state_changes;
+}
+
+void BlendFuncSeparate(GLenum, GLenum, GLenum, GLenum) {
+	++stats.state_changes;
+}
+
+void glDrawElements(GLenum, GLsizei, GLenum, const void*) {
+	++stats.draw_calls;
+	++stats.instances;
+}
+
+void glDrawArrays(GLenum, GLint, GLsizei) {
+	++stats.draw_calls;
+	++stats.instances;
+}
+
+void DrawElementsInstanced(GLenum, GLsizei, GLenum, const void*, GLsizei instance_count) {
+	++stats.draw_calls;
+	stats.instances += static_cast<std::uint64_t>(instance_count);
+}
+
+void glGenTextures(GLsizei n, GLuint* textures) {
+	GenerateIds(n, textures);
+}
+
+void glDeleteTextures(GLsizei n, const GLuint* textures) {
+	for (GLsizei i{ 0 }; i < n; ++i) {
+		state.texture_parameters.erase(textures[i]);
+		for (auto& [unit, texture] : state.textures) {
+			if (texture == textures[i]) {
+				texture = 0;
+			}
+		}
+	}
+}
+
+void glBindTexture(GLenum, GLuint texture) {
+	Bind(state.textures[state.active_texture], texture, stats.texture_binds);
+}
+
+void ActiveTexture(GLenum texture) {
+	state.active_texture = texture;
+	++stats.state_changes;
+}
+
+void glTexImage2D(
+	GLenum, GLint, GLint, GLsizei width, GLsizei height, GLint, GLenum, GLenum, const void*
+) {
+	++stats.texture_uploads;
+	stats.texture_upload_pixels += static_cast<std::uint64_t>(width) *
+								   static_cast<std::uint64_t>(height);
+}
+
+void glTexSubImage2D(
+	GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height, GLenum, GLenum, const void*
+) {
+	++stats.texture_uploads;
+	stats.texture_upload_pixels += static_cast<std::uint64_t>(width) *
+								   static_cast<std::uint64_t>(height);
+}
+
+void glTexParameteri(GLenum, GLenum pname, GLint param) {
+	state.texture_parameters[GetBoundTexture()][pname] = param;
+	++stats.state_changes;
+}
+
+void glTexParameterfv(GLenum, GLenum, const GLfloat*) {
+	++stats.state_changes;
+}
+
+void glGetTexParameteriv(GLenum, GLenum pname, GLint* params) {
+	auto& parameters{ state.texture_parameters[GetBoundTexture()] };
+	auto it{ parameters.find(pname) };
+	*params = it == parameters.end() ? 0 : it->second;
+}
+
+void GenerateMipmap(GLenum) {}
+
+// Pixels are left untouched since nothing is ever rendered.
+void glReadPixels(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void*) {}
+
+void GenBuffers(GLsizei n, GLuint* buffers) {
+	GenerateIds(n, buffers);
+}
+
+void DeleteBuffers(GLsizei n, const GLuint* buffers) {
+	for (GLsizei i{ 0 }; i < n; ++i) {
+		state.buffer_sizes.erase(buffers[i]);
+	}
+}
+
+void BindBuffer(GLenum target, GLuint buffer) {
+	Bind(GetBoundBuffer(target), buffer, stats.buffer_binds);
+}
+
+void BufferData(GLenum target, GLsizeiptr size, const void*, GLenum) {
+	state.buffer_sizes[GetBoundBuffer(target)] = static_cast<GLint>(size);
+	++stats.buffer_uploads;
+	stats.buffer_upload_bytes += static_cast<std::uint64_t>(size);
+}
+
+void BufferSubData(GLenum, GLintptr, GLsizeiptr size, const void*) {
+	++stats.buffer_uploads;
+	stats.buffer_upload_bytes += static_cast<std::uint64_t>(size);
+}
+
+void GetBufferParameteriv(GLenum target, GLenum pname, GLint* params) {
+	*params = 0;
+	if (pname == GL_BUFFER_SIZE) {
+		if (auto it{ state.buffer_sizes.find(GetBoundBuffer(target)) };
+			it != state.buffer_sizes.end()) {
+			*params = it->second;
+		}
+	}
+}
+
+void GenVertexArrays(GLsizei n, GLuint* arrays) {
+	GenerateIds(n, arrays);
+}
+
+void DeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+	for (GLsizei i{ 0 }; i < n; ++i) {
+		state.element_buffers.erase(arrays[i]);
+	}
+}
+
+void BindVertexArray(GLuint array) {
+	Bind(state.vertex_array, array, stats.vertex_array_binds);
+}
+
+void EnableVertexAttribArray(GLuint) {}
+
+void VertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+
+void VertexAttribIPointer(GLuint, GLint, GLenum, GLsizei, const void*) {}
+
+void VertexAttribDivisor(GLuint, GLuint) {}
+
+void GenFramebuffers(GLsizei n, GLuint* frame_buffers) {
+	GenerateIds(n, frame_buffers);
+}
+
+void DeleteFramebuffers(GLsizei, const GLuint*) {}
+
+void BindFramebuffer(GLenum target, GLuint frame_buffer) {
+	if (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER) {
+		state.draw_frame_buffer = frame_buffer;
+	}
+	if (target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER) {
+		state.read_frame_buffer = frame_buffer;
+	}
+	++stats.frame_buffer_binds;
+}
+
+GLenum CheckFramebufferStatus(GLenum) {
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void FramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) {}
+
+void FramebufferRenderbuffer(GLenum, GLenum, GLenum, GLuint) {}
+
+void DrawBuffers(GLsizei, const GLenum*) {
+	++stats.state_changes;
+}
+
+void glDrawBuffer(GLenum) {
+	++stats.state_changes;
+}
+
+void GenRenderbuffers(GLsizei n, GLuint* render_buffers) {
+	GenerateIds(n, render_buffers);
+}
+
+void DeleteRenderbuffers(GLsizei, const GLuint*) {}
+
+void BindRenderbuffer(GLenum, GLuint render_buffer) {
+	state.render_buffer = render_buffer;
+}
+
+void RenderbufferStorage(GLenum, GLenum, GLsizei, GLsizei) {}
+
+GLuint CreateShader(GLenum) {
+	return GenerateId();
+}
+
+void DeleteShader(GLuint) {}
+
+void ShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) {}
+
+void CompileShader(GLuint) {}
+
+// Every shader compiles and every program links, with an empty info log.
+void GetShaderiv(GLuint, GLenum pname, GLint* params) {
+	*params = pname == GL_INFO_LOG_LENGTH ? 0 : GL_TRUE;
+}
+
+void GetShaderInfoLog(GLuint, GLsizei, GLsizei* length, GLchar*) {
+	if (length != nullptr) {
+		*length = 0;
+	}
+}
+
+GLuint CreateProgram() {
+	return GenerateId();
+}
+
+void DeleteProgram(GLuint program) {
+	if (state.program == program) {
+		state.program = 0;
+	}
+}
+
+void AttachShader(GLuint, GLuint) {}
+
+void LinkProgram(GLuint) {}
+
+void ValidateProgram(GLuint) {}
+
+void UseProgram(GLuint program) {
+	Bind(state.program, program, stats.shader_binds);
+}
+
+void GetProgramiv(GLuint, GLenum pname, GLint* params) {
+	*params = pname == GL_INFO_LOG_LENGTH ? 0 : GL_TRUE;
+}
+
+void GetProgramInfoLog(GLuint, GLsizei, GLsizei* length, GLchar*) {
+	if (length != nullptr) {
+		*length = 0;
+	}
+}
+
+// Uniform locations are only ever passed back into the Uniform calls below.
+GLint GetUniformLocation(GLuint, const GLchar*) {
+	return 0;
+}
+
+void Uniform1f(GLint, GLfloat) {
+	++stats.uniform_updates;
+}
+
+void Uniform2f(GLint, GLfloat, GLfloat) {
+	++stats.uniform_updates;
+}
+
+void Uniform3f(GLint, GLfloat, GLfloat, GLfloat) {
+	++stats.uniform_updates;
+}
+
+void Uniform4f(GLint, GLfloat, GLfloat, GLfloat, GLfloat) {
+	++stats.uniform_updates;
+}
+
+void Uniform1i(GLint, GLint) {
+	++stats.uniform_updates;
+}
+
+void Uniform2i(GLint, GLint, GLint) {
+	++stats.uniform_updates;
+}
+
+void Uniform3i(GLint, GLint, GLint, GLint) {
+	++stats.uniform_updates;
+}
+
+void Uniform4i(GLint, GLint, GLint, GLint, GLint) {
+	++stats.uniform_updates;
+}
+
+void Uniform1iv(GLint, GLsizei, const GLint*) {
+	++stats.uniform_updates;
+}
+
+void Uniform1fv(GLint, GLsizei, const GLfloat*) {
+	++stats.uniform_updates;
+}
+
+void UniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) {
+	++stats.uniform_updates;
+}
+
+} // namespace ptgn::impl::null_gl
\ No newline at end of file
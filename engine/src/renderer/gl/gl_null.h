@@ -0,0 +1,143 @@
+#pragma once
+
+#include "renderer/gl/gl_context.h"
+#include "renderer/gl/gl_loader.h"
+
+// IMPORTANT: This file is not meant to be included outside the protegon library
+// so keep it in .cpp files only!
+
+// Null OpenGL backend used when the game runs headless. GLCall dispatches to the function of the
+// same name in this namespace, which records the call in the null backend stats instead of
+// executing it. Object ids, bindings, buffer sizes and texture parameters are tracked so that
+// the renderer can query them back as it would from a real context.
+namespace ptgn::impl::null_gl {
+
+// Clears all emulated objects and state, but not the stats.
+void Reset();
+
+[[nodiscard]] NullGLStats& GetStats();
+
+// Capabilities, blending and clearing.
+
+void glEnable(GLenum cap);
+void glDisable(GLenum cap);
+void glGetBooleanv(GLenum pname, GLboolean* data);
+void glGetIntegerv(GLenum pname, GLint* data);
+void glViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+void glPolygonMode(GLenum face, GLenum mode);
+void glDepthFunc(GLenum func);
+void glDepthMask(GLboolean flag);
+void glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+void glStencilMask(GLuint mask);
+void glStencilOp(GLenum fail, GLenum zfail, GLenum zpass);
+void glStencilFunc(GLenum func, GLint ref, GLuint mask);
+void glClear(GLbitfield mask);
+void glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+void glClearDepth(double depth);
+void ClearBufferfv(GLenum buffer, GLint draw_buffer, const GLfloat* value);
+void ClearBufferuiv(GLenum buffer, GLint draw_buffer, const GLuint* value);
+void BlendEquationSeparate(GLenum mode_rgb, GLenum mode_alpha);
+void BlendFuncSeparate(
+	GLenum src_rgb, GLenum dst_rgb, GLenum src_alpha, GLenum dst_alpha
+);
+
+// Draw calls.
+
+void glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices);
+void glDrawArrays(GLenum mode, GLint first, GLsizei count);
+void DrawElementsInstanced(
+	GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instance_count
+);
+
+// Textures.
+
+void glGenTextures(GLsizei n, GLuint* textures);
+void glDeleteTextures(GLsizei n, const GLuint* textures);
+void glBindTexture(GLenum target, GLuint texture);
+void ActiveTexture(GLenum texture);
+void glTexImage2D(
+	GLenum target, GLint level, GLint internal_format, GLsizei width, GLsizei height,
+	GLint border, GLenum format, GLenum type, const void* pixels
+);
+void glTexSubImage2D(
+	GLenum target, GLint level, GLint x_offset, GLint y_offset, GLsizei width, GLsizei height,
+	GLenum format, GLenum type, const void* pixels
+);
+void glTexParameteri(GLenum target, GLenum pname, GLint param);
+void glTexParameterfv(GLenum target, GLenum pname, const GLfloat* params);
+void glGetTexParameteriv(GLenum target, GLenum pname, GLint* params);
+void GenerateMipmap(GLenum target);
+void glReadPixels(
+	GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels
+);
+
+// Buffers and vertex arrays.
+
+void GenBuffers(GLsizei n, GLuint* buffers);
+void DeleteBuffers(GLsizei n, const GLuint* buffers);
+void BindBuffer(GLenum target, GLuint buffer);
+void BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+void GetBufferParameteriv(GLenum target, GLenum pname, GLint* params);
+void GenVertexArrays(GLsizei n, GLuint* arrays);
+void DeleteVertexArrays(GLsizei n, const GLuint* arrays);
+void BindVertexArray(GLuint array);
+void EnableVertexAttribArray(GLuint index);
+void VertexAttribPointer(
+	GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
+	const void* pointer
+);
+void VertexAttribIPointer(
+	GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer
+);
+void VertexAttribDivisor(GLuint index, GLuint divisor);
+
+// Frame buffers and render buffers.
+
+void GenFramebuffers(GLsizei n, GLuint* frame_buffers);
+void DeleteFramebuffers(GLsizei n, const GLuint* frame_buffers);
+void BindFramebuffer(GLenum target, GLuint frame_buffer);
+GLenum CheckFramebufferStatus(GLenum target);
+void FramebufferTexture2D(
+	GLenum target, GLenum attachment, GLenum texture_target, GLuint texture, GLint level
+);
+void FramebufferRenderbuffer(
+	GLenum target, GLenum attachment, GLenum render_buffer_target, GLuint render_buffer
+);
+void DrawBuffers(GLsizei n, const GLenum* buffers);
+void glDrawBuffer(GLenum buffer);
+void GenRenderbuffers(GLsizei n, GLuint* render_buffers);
+void DeleteRenderbuffers(GLsizei n, const GLuint* render_buffers);
+void BindRenderbuffer(GLenum target, GLuint render_buffer);
+void RenderbufferStorage(GLenum target, GLenum internal_format, GLsizei width, GLsizei height);
+
+// Shaders and uniforms.
+
+GLuint CreateShader(GLenum type);
+void DeleteShader(GLuint shader);
+void ShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+void CompileShader(GLuint shader);
+void GetShaderiv(GLuint shader, GLenum pname, GLint* params);
+void GetShaderInfoLog(GLuint shader, GLsizei max_length, GLsizei* length, GLchar* info_log);
+GLuint CreateProgram();
+void DeleteProgram(GLuint program);
+void AttachShader(GLuint program, GLuint shader);
+void LinkProgram(GLuint program);
+void ValidateProgram(GLuint program);
+void UseProgram(GLuint program);
+void GetProgramiv(GLuint program, GLenum pname, GLint* params);
+void GetProgramInfoLog(GLuint program, GLsizei max_length, GLsizei* length, GLchar* info_log);
+GLint GetUniformLocation(GLuint program, const GLchar* name);
+void Uniform1f(GLint location, GLfloat v0);
+void Uniform2f(GLint location, GLfloat v0, GLfloat v1);
+void Uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+void Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+void Uniform1i(GLint location, GLint v0);
+void Uniform2i(GLint location, GLint v0, GLint v1);
+void Uniform3i(GLint location, GLint v0, GLint v1, GLint v2);
+void Uniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3);
+void Uniform1iv(GLint location, GLsizei count, const GLint* value);
+void Uniform1fv(GLint location, GLsizei count, const GLfloat* value);
+void UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+
+} // namespace ptgn::impl::null_gl
\ No newline at end of file
@@ -202,6 +202,39 @@ void GLRenderer::DrawElements(
 #endif
 }
 
+void GLRenderer::DrawInstanced(
+	const VertexArray& vao, std::size_t index_count, std::size_t instance_count,
+	bool bind_vertex_array
+) {
+	PTGN_ASSERT(
+		vao.HasVertexBuffer(),
+		"Cannot draw vertex array with uninitialized or destroyed vertex buffer"
+	);
+	PTGN_ASSERT(
+		vao.HasIndexBuffer(),
+		"Cannot draw vertex array with uninitialized or destroyed index buffer"
+	);
+	PTGN_ASSERT(
+		vao.HasInstanceBuffer(),
+		"Cannot draw instances of vertex array without an instance buffer"
+	);
+	if (bind_vertex_array) {
+		vao.Bind();
+	}
+	PTGN_ASSERT(vao.IsBound(), "Cannot glDrawElementsInstanced unless the VertexArray is bound");
+	GLCall(DrawElementsInstanced(
+		static_cast<GLenum>(vao.GetPrimitiveMode()), static_cast<std::int32_t>(index_count),
+		static_cast<GLenum>(impl::GetType<std::uint32_t>()), nullptr,
+		static_cast<std::int32_t>(instance_count)
+	));
+#ifdef PTGN_DEBUG
+	++game.debug.stats.draw_calls;
+#endif
+#ifdef GL_ANNOUNCE_RENDERER_CALLS
+	PTGN_LOG("GL: Draw elements instanced");
+#endif
+}
+
 void GLRenderer::DrawArrays(
 	const VertexArray& vao, std::size_t vertex_count, bool bind_vertex_array
 ) {
@@ -78,6 +78,13 @@ public:
 		const VertexArray& va, std::size_t vertex_count, bool bind_vertex_array = true
 	);
 
+	// Draws the indexed vertices of va once for each of the first instance_count instances of its
+	// instance buffer.
+	static void DrawInstanced(
+		const VertexArray& va, std::size_t index_count, std::size_t instance_count,
+		bool bind_vertex_array = true
+	);
+
 	// @return The maximum number of texture slots available on the current hardware.
 	[[nodiscard]] static std::uint32_t GetMaxTextureSlots();
 
@@ -37,6 +37,17 @@ using uvec2 = std::array<std::uint32_t, 2>;
 using uvec3 = std::array<std::uint32_t, 3>;
 using uvec4 = std::array<std::uint32_t, 4>;
 
+// Normalized to a vec4 with components in range [0, 1] when read by shaders.
+using u8vec4 = std::array<std::uint8_t, 4>;
+
+// Normalized to a vec2 with components in range [0, 1] when read by shaders.
+using u16vec2 = std::array<std::uint16_t, 2>;
+
+// Bits of a 16 bit floating point number, read by shaders as a float.
+enum class half : std::uint16_t {};
+
+using hvec4 = std::array<half, 4>;
+
 } // namespace glsl
 
 enum class PrimitiveMode : std::uint32_t {
@@ -101,7 +112,8 @@ template <typename T>
 concept VertexDataType = IsAnyOf<
 	T, glsl::float_, glsl::vec2, glsl::vec3, glsl::vec4, glsl::double_, glsl::dvec2, glsl::dvec3,
 	glsl::dvec4, glsl::bool_, glsl::bvec2, glsl::bvec3, glsl::bvec4, glsl::int_, glsl::ivec2,
-	glsl::ivec3, glsl::ivec4, glsl::uint_, glsl::uvec2, glsl::uvec3, glsl::uvec4>;
+	glsl::ivec3, glsl::ivec4, glsl::uint_, glsl::uvec2, glsl::uvec3, glsl::uvec4, glsl::u8vec4,
+	glsl::u16vec2, glsl::hvec4>;
 
 enum class GLType : std::uint32_t {
 	None			= 0,
@@ -113,13 +125,14 @@ enum class GLType : std::uint32_t {
 	UnsignedInt		= 0x1405, // GL_UNSIGNED_INT
 	Float			= 0x1406, // GL_FLOAT
 	Double			= 0x140A, // GL_DOUBLE
+	HalfFloat		= 0x140B, // GL_HALF_FLOAT
 	UnsignedInt24_8 = 0x84FA  // GL_UNSIGNED_INT_24_8
 };
 
 template <typename T>
 concept SupportedGLType = IsAnyOf<
 	T, float, double, std::int32_t, std::uint32_t, std::int16_t, std::uint16_t, std::int8_t,
-	std::uint8_t, bool>;
+	std::uint8_t, bool, glsl::half>;
 
 template <SupportedGLType T>
 [[nodiscard]] constexpr GLType GetType() {
@@ -139,6 +152,8 @@ template <SupportedGLType T>
 		return GLType::Byte;
 	} else if constexpr (std::is_same_v<T, std::uint8_t>) {
 		return GLType::UnsignedByte;
+	} else if constexpr (std::is_same_v<T, glsl::half>) {
+		return GLType::HalfFloat;
 	}
 }
 
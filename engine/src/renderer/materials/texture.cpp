@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -28,6 +29,7 @@
 #include "renderer/gl/gl_loader.h"
 #include "renderer/gl/gl_renderer.h"
 #include "renderer/gl/gl_types.h"
+#include "renderer/materials/texture_atlas.h"
 #include "SDL_error.h"
 #include "SDL_image.h"
 #include "SDL_pixels.h"
@@ -449,6 +451,77 @@ void Texture::SetSubData(
 	));
 }
 
+TextureManager::TextureManager() = default;
+
+TextureManager::TextureManager(TextureManager&& other) noexcept = default;
+
+TextureManager& TextureManager::operator=(TextureManager&& other) noexcept = default;
+
+TextureManager::~TextureManager() = default;
+
+void TextureManager::Load(const TextureHandle& key, const path& filepath) {
+	if (!atlas_) {
+		ParentManager::Load(key, filepath);
+		return;
+	}
+
+	auto [it, inserted] = resources_.try_emplace(key);
+	if (!inserted) {
+		return;
+	}
+
+	// The surface is kept around for packing instead of decoding the file twice.
+	Surface surface{ filepath };
+	it->second.key		= key;
+	it->second.filepath = filepath;
+	it->second.resource = Texture{ surface };
+
+	atlas_->Add(it->second.resource.GetId(), surface);
+}
+
+void TextureManager::Unload(const TextureHandle& key) {
+	// Texture ids are reused by OpenGL, so the atlas must not outlive the texture.
+	if (atlas_ && Has(key)) {
+		atlas_->Remove(Get(key).GetId());
+	}
+	ParentManager::Unload(key);
+}
+
+void TextureManager::Clear() {
+	if (atlas_) {
+		atlas_->Clear();
+	}
+	ParentManager::Clear();
+}
+
+void TextureManager::EnableAtlas(
+	const V2_int& page_size, const V2_int& max_texture_size, int padding
+) {
+	atlas_ = std::make_unique<TextureAtlas>(page_size, max_texture_size, padding);
+}
+
+void TextureManager::DisableAtlas() {
+	atlas_.reset();
+}
+
+bool TextureManager::IsAtlasEnabled() const {
+	return atlas_ != nullptr;
+}
+
+TextureAtlasStats TextureManager::GetAtlasStats() const {
+	if (!atlas_) {
+		return {};
+	}
+	return atlas_->GetStats();
+}
+
+const AtlasRegion* TextureManager::GetAtlasRegion(TextureId texture_id) const {
+	if (!atlas_) {
+		return nullptr;
+	}
+	return atlas_->Find(texture_id);
+}
+
 V2_int TextureManager::GetSize(const TextureHandle& key) const {
 	return Get(key).GetSize();
 }
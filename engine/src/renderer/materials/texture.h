@@ -3,6 +3,7 @@
 #include <array>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <vector>
 
 #include "core/ecs/components/generic.h"
@@ -19,10 +20,13 @@ struct SDL_Surface;
 namespace ptgn {
 
 class Entity;
+struct TextureAtlasStats;
 
 namespace impl {
 
 class Texture;
+class TextureAtlas;
+struct AtlasRegion;
 
 } // namespace impl
 
@@ -297,9 +301,45 @@ private:
 
 class TextureManager : public ResourceManager<TextureManager, TextureHandle, Texture> {
 public:
+	TextureManager();
+	TextureManager(const TextureManager&)			 = delete;
+	TextureManager& operator=(const TextureManager&) = delete;
+	TextureManager(TextureManager&& other) noexcept;
+	TextureManager& operator=(TextureManager&& other) noexcept;
+	~TextureManager() override;
+
+	// If atlasing is enabled, small textures are also packed into a shared atlas page.
+	void Load(const TextureHandle& key, const path& filepath) final;
+
+	void Unload(const TextureHandle& key) final;
+
+	void Clear() final;
+
 	// @return Size of the texture.
 	[[nodiscard]] V2_int GetSize(const TextureHandle& key) const;
 
+	// Textures loaded from files after this call which are at most max_texture_size are also
+	// packed into shared atlas pages. Sprites drawing them are transparently redirected to the
+	// atlas, so that many small textures no longer break batches by exceeding the texture slots.
+	// Textures which were loaded before enabling the atlas are not packed.
+	// @param page_size Size of each atlas page.
+	// @param padding Empty pixels between packed textures.
+	void EnableAtlas(
+		const V2_int& page_size = { 2048, 2048 }, const V2_int& max_texture_size = { 256, 256 },
+		int padding = 1
+	);
+
+	// Destroys all atlas pages. Textures are drawn from their own texture again.
+	void DisableAtlas();
+
+	[[nodiscard]] bool IsAtlasEnabled() const;
+
+	// @return Occupancy of the atlas pages. Empty if atlasing is disabled.
+	[[nodiscard]] TextureAtlasStats GetAtlasStats() const;
+
+	// @return Atlas region of the texture, or nullptr if it is not packed into the atlas.
+	[[nodiscard]] const AtlasRegion* GetAtlasRegion(TextureId texture_id) const;
+
 private:
 	[[nodiscard]] const Texture& Get(const TextureHandle& key) const;
 
@@ -307,6 +347,9 @@ private:
 	friend struct ptgn::TextureHandle;
 
 	[[nodiscard]] static Texture LoadFromFile(const path& filepath);
+
+	// Nullptr while atlasing is disabled.
+	std::unique_ptr<TextureAtlas> atlas_;
 };
 
 } // namespace impl
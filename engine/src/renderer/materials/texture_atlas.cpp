@@ -0,0 +1,241 @@
+#include "renderer/materials/texture_atlas.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "debug/runtime/assert.h"
+#include "math/vector2.h"
+#include "renderer/materials/texture.h"
+
+namespace ptgn {
+
+float TextureAtlasStats::GetOccupancy() const {
+	if (total_area == 0) {
+		return 0.0f;
+	}
+	return static_cast<float>(used_area) / static_cast<float>(total_area);
+}
+
+namespace impl {
+
+void AtlasRegion::Remap(std::array<V2_float, 4>& texture_coordinates) const {
+	for (auto& coordinate : texture_coordinates) {
+		coordinate = min + coordinate * (max - min);
+	}
+}
+
+TextureAtlas::TextureAtlas(const V2_int& page_size, const V2_int& max_texture_size, int padding) :
+	page_size_{ page_size }, max_texture_size_{ max_texture_size }, padding_{ padding } {
+	PTGN_ASSERT(page_size_.BothAboveZero(), "Texture atlas page size must be positive");
+	PTGN_ASSERT(padding_ >= 0, "Texture atlas padding cannot be negative");
+	PTGN_ASSERT(
+		max_texture_size_.x + padding_ <= page_size_.x &&
+			max_texture_size_.y + padding_ <= page_size_.y,
+		"Texture atlas maximum texture size must fit within a page"
+	);
+}
+
+std::optional<AtlasRegion> TextureAtlas::Add(TextureId source, const Surface& surface) {
+	PTGN_ASSERT(source, "Cannot add invalid texture to texture atlas");
+
+	// Replacing a packed texture frees its previous region.
+	Remove(source);
+
+	auto entry{ PackEntry(surface) };
+	if (!entry) {
+		return std::nullopt;
+	}
+	regions_.emplace(source, *entry);
+	return entry->region;
+}
+
+std::optional<AtlasRegion> TextureAtlas::Pack(const Surface& surface) {
+	auto entry{ PackEntry(surface) };
+	if (!entry) {
+		return std::nullopt;
+	}
+	return entry->region;
+}
+
+std::optional<TextureAtlas::Entry> TextureAtlas::PackEntry(const Surface& surface) {
+	if (surface.format != page_format_ || !surface.size.BothAboveZero() ||
+		surface.size.x > max_texture_size_.x || surface.size.y > max_texture_size_.y) {
+		return std::nullopt;
+	}
+
+	V2_int padded_size{ surface.size + V2_int{ padding_ } };
+
+	Page* page{ nullptr };
+	std::optional<Placement> placement;
+
+	for (auto& existing : pages_) {
+		placement = FindPlacement(existing, padded_size);
+		if (placement.has_value()) {
+			page = &existing;
+			break;
+		}
+	}
+
+	if (page == nullptr) {
+		page = &pages_.emplace_back(Page{ Texture{ nullptr, page_size_, page_format_ },
+										  { SkylineNode{ 0, 0, page_size_.x } } });
+		placement = FindPlacement(*page, padded_size);
+		PTGN_ASSERT(placement.has_value(), "Failed to pack texture into empty atlas page");
+	}
+
+	AddSkylineNode(*page, *placement, padded_size);
+
+	TextureId restore_texture_id{ Texture::GetBoundId() };
+	page->texture.Bind();
+	page->texture.SetSubData(surface.data.data(), surface.size, 0, placement->position);
+	Texture::BindId(restore_texture_id);
+
+	V2_float page_size{ page_size_ };
+
+	Entry entry{ AtlasRegion{ page->texture.GetId(), placement->position / page_size,
+							  (placement->position + surface.size) / page_size },
+				 static_cast<std::size_t>(page - pages_.data()),
+				 static_cast<std::int64_t>(surface.size.x) * surface.size.y };
+
+	++page->count;
+	used_area_ += entry.area;
+
+	return entry;
+}
+
+void TextureAtlas::Remove(TextureId source) {
+	auto it{ regions_.find(source) };
+	if (it == regions_.end()) {
+		return;
+	}
+
+	Release(it->second.page, it->second.area);
+
+	regions_.erase(it);
+}
+
+void TextureAtlas::Free(const AtlasRegion& region, const V2_int& size) {
+	auto it{ std::find_if(pages_.begin(), pages_.end(), [&](const Page& page) {
+		return page.texture.GetId() == region.page;
+	}) };
+	PTGN_ASSERT(it != pages_.end(), "Cannot free region which is not part of the texture atlas");
+	Release(
+		static_cast<std::size_t>(it - pages_.begin()), static_cast<std::int64_t>(size.x) * size.y
+	);
+}
+
+void TextureAtlas::Release(std::size_t page_index, std::int64_t area) {
+	PTGN_ASSERT(page_index < pages_.size());
+	auto& page{ pages_[page_index] };
+	PTGN_ASSERT(page.count > 0);
+
+	used_area_ -= area;
+
+	if (--page.count == 0) {
+		page.skyline = { SkylineNode{ 0, 0, page_size_.x } };
+	}
+}
+
+const AtlasRegion* TextureAtlas::Find(TextureId source) const {
+	if (auto it{ regions_.find(source) }; it != regions_.end()) {
+		return &it->second.region;
+	}
+	return nullptr;
+}
+
+TextureAtlasStats TextureAtlas::GetStats() const {
+	TextureAtlasStats stats;
+	stats.pages		 = pages_.size();
+	stats.textures	 = regions_.size();
+	stats.used_area	 = used_area_;
+	stats.total_area = static_cast<std::int64_t>(page_size_.x) * page_size_.y *
+					   static_cast<std::int64_t>(pages_.size());
+	return stats;
+}
+
+void TextureAtlas::Clear() {
+	pages_.clear();
+	regions_.clear();
+	used_area_ = 0;
+}
+
+std::optional<TextureAtlas::Placement> TextureAtlas::FindPlacement(
+	const Page& page, const V2_int& size
+) const {
+	std::optional<Placement> best;
+	int best_top{ page_size_.y + 1 };
+	int best_width{ page_size_.x + 1 };
+
+	for (std::size_t i{ 0 }; i < page.skyline.size(); ++i) {
+		int x{ page.skyline[i].x };
+		if (x + size.x > page_size_.x) {
+			break;
+		}
+
+		// The texture rests on the highest node spanned by its width.
+		int y{ 0 };
+		int remaining{ size.x };
+		for (std::size_t j{ i }; remaining > 0; ++j) {
+			PTGN_ASSERT(j < page.skyline.size());
+			y		   = std::max(y, page.skyline[j].y);
+			remaining -= page.skyline[j].width;
+		}
+
+		int top{ y + size.y };
+		if (top > page_size_.y) {
+			continue;
+		}
+
+		if (top < best_top || (top == best_top && page.skyline[i].width < best_width)) {
+			best_top   = top;
+			best_width = page.skyline[i].width;
+			best	   = Placement{ i, V2_int{ x, y } };
+		}
+	}
+
+	return best;
+}
+
+void TextureAtlas::AddSkylineNode(Page& page, const Placement& placement, const V2_int& size) {
+	auto& skyline{ page.skyline };
+
+	auto index{ static_cast<std::ptrdiff_t>(placement.node) };
+	skyline.insert(
+		skyline.begin() + index,
+		SkylineNode{ placement.position.x, placement.position.y + size.y, size.x }
+	);
+
+	// Trim the nodes now covered by the new node.
+	int right{ placement.position.x + size.x };
+	for (std::size_t i{ placement.node + 1 }; i < skyline.size();) {
+		auto& node{ skyline[i] };
+		if (node.x >= right) {
+			break;
+		}
+		int overlap{ right - node.x };
+		if (overlap >= node.width) {
+			skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i));
+			continue;
+		}
+		node.x	   += overlap;
+		node.width -= overlap;
+		break;
+	}
+
+	// Merge neighboring nodes of equal height.
+	for (std::size_t i{ 0 }; i + 1 < skyline.size();) {
+		if (skyline[i].y == skyline[i + 1].y) {
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+		} else {
+			++i;
+		}
+	}
+}
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
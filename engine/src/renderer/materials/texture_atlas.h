@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "math/vector2.h"
+#include "renderer/materials/texture.h"
+
+namespace ptgn {
+
+struct TextureAtlasStats {
+	std::size_t pages{ 0 };
+	std::size_t textures{ 0 };
+	// Pixels covered by packed textures, excluding padding.
+	std::int64_t used_area{ 0 };
+	// Pixels of all atlas pages.
+	std::int64_t total_area{ 0 };
+
+	// @return Fraction of the atlas pages covered by packed textures, from 0 to 1.
+	[[nodiscard]] float GetOccupancy() const;
+};
+
+namespace impl {
+
+// Location of a packed texture inside an atlas page.
+struct AtlasRegion {
+	TextureId page{ 0 };
+	// Texture coordinates of the region within the page.
+	V2_float min;
+	V2_float max;
+
+	// Maps texture coordinates relative to the original texture into the page.
+	void Remap(std::array<V2_float, 4>& texture_coordinates) const;
+};
+
+// Packs small textures into shared pages using a bottom left skyline packer, so that sprites with
+// different source textures can be drawn without exceeding the texture slots of a batch.
+// A skyline cannot reuse the space of individual removed textures, so the space of a page is only
+// reclaimed once every texture packed into it has been removed, or the atlas is cleared.
+class TextureAtlas {
+public:
+	// @param page_size Size of each atlas page.
+	// @param max_texture_size Textures larger than this along either axis are not packed.
+	// @param padding Empty pixels between packed textures, to prevent filtering across them.
+	TextureAtlas(const V2_int& page_size, const V2_int& max_texture_size, int padding);
+
+	// Copies the surface into an atlas page.
+	// @param source Id of the texture which the surface was uploaded to.
+	// @return Region of the packed texture, or std::nullopt if the surface is too large or not of
+	// the page format.
+	std::optional<AtlasRegion> Add(TextureId source, const Surface& surface);
+
+	// Copies the surface into an atlas page without recording it under a source texture. The
+	// caller keeps track of the returned region.
+	// @return Region of the packed surface, or std::nullopt if the surface is too large or not of
+	// the page format.
+	std::optional<AtlasRegion> Pack(const Surface& surface);
+
+	// Frees the region of the source texture. Pages left without any packed textures are reset so
+	// that their space can be reused.
+	void Remove(TextureId source);
+
+	// Frees a region returned by Pack.
+	// @param size Size of the surface which was packed into the region.
+	void Free(const AtlasRegion& region, const V2_int& size);
+
+	// @return Nullptr if the source texture is not packed.
+	[[nodiscard]] const AtlasRegion* Find(TextureId source) const;
+
+	[[nodiscard]] TextureAtlasStats GetStats() const;
+
+	// Removes all textures and destroys all pages.
+	void Clear();
+
+private:
+	constexpr static TextureFormat page_format_{ TextureFormat::RGBA8888 };
+
+	// Horizontal segment of the highest occupied row of a page.
+	struct SkylineNode {
+		int x{ 0 };
+		int y{ 0 };
+		int width{ 0 };
+	};
+
+	struct Page {
+		Texture texture;
+		// Sorted by x and covering the full page width.
+		std::vector<SkylineNode> skyline;
+		// Number of surfaces packed into the page which have not been removed.
+		std::size_t count{ 0 };
+	};
+
+	struct Entry {
+		AtlasRegion region;
+		std::size_t page{ 0 };
+		std::int64_t area{ 0 };
+	};
+
+	struct Placement {
+		std::size_t node{ 0 };
+		V2_int position;
+	};
+
+	// @return Bottom left most position along the skyline where size fits.
+	[[nodiscard]] std::optional<Placement> FindPlacement(const Page& page, const V2_int& size)
+		const;
+
+	static void AddSkylineNode(Page& page, const Placement& placement, const V2_int& size);
+
+	// @return Region of the packed surface and the index of its page.
+	std::optional<Entry> PackEntry(const Surface& surface);
+
+	// Frees the area of a packed surface, resetting its page once the page is empty.
+	void Release(std::size_t page_index, std::int64_t area);
+
+	V2_int page_size_;
+	V2_int max_texture_size_;
+	int padding_{ 1 };
+
+	std::vector<Page> pages_;
+
+	std::unordered_map<TextureId, Entry> regions_;
+
+	std::int64_t used_area_{ 0 };
+};
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
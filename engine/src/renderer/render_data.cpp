@@ -11,7 +11,9 @@
 #include <numeric>
 #include <optional>
 #include <span>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -29,6 +31,8 @@
 #include "core/ecs/entity.h"
 #include "core/scripting/script.h"
 #include "core/utils/concepts.h"
+#include "core/utils/frame_profiler.h"
+#include "core/utils/thread_pool.h"
 #include "core/utils/time.h"
 #include "core/utils/timer.h"
 #include "debug/core/log.h"
@@ -61,7 +65,10 @@
 #include "renderer/materials/texture.h"
 #include "renderer/render_target.h"
 #include "renderer/renderer.h"
+#include "renderer/static_batch.h"
 #include "renderer/stencil_mask.h"
+#include "renderer/text/font.h"
+#include "renderer/text/glyph_atlas.h"
 #include "world/scene/camera.h"
 #include "world/scene/scene.h"
 
@@ -227,6 +234,10 @@ Viewport::Viewport(const V2_int& position, const V2_int& size) :
 
 namespace impl {
 
+// Command buffer of the recording pool thread which is currently invoking drawables. Null outside
+// of parallel recording.
+static thread_local CommandBuffer* recording_buffer{ nullptr };
+
 RenderState::RenderState(
 	const ShaderPass& shader_pass, BlendMode blend_mode, const Camera& camera, const PostFX& post_fx
 ) :
@@ -236,6 +247,16 @@ bool RenderState::IsSet() const {
 	return shader_pass.has_value();
 }
 
+std::size_t RenderState::GetHash() const {
+	std::size_t value{ shader_pass.has_value() ? shader_pass->GetHash() : 0 };
+	value = value * 31 + static_cast<std::size_t>(blend_mode);
+	value = value * 31 + camera.GetHash();
+	for (const auto& entity : post_fx.post_fx_) {
+		value = value * 31 + entity.GetHash();
+	}
+	return value;
+}
+
 void ViewportResizeScript::OnWindowResized() {
 	auto& render_data{ game.renderer.render_data_ };
 	auto window_size{ game.window.GetSize() };
@@ -245,11 +266,21 @@ void ViewportResizeScript::OnWindowResized() {
 	render_data.RecomputeDisplaySize(window_size);
 }
 
-ShaderPass::ShaderPass(const Shader& shader, const UniformCallback& uniform_callback) :
-	shader_{ &shader }, uniform_callback_{ uniform_callback } {}
+ShaderPass::ShaderPass(
+	const Shader& shader, const UniformCallback& uniform_callback,
+	InstanceCallback instance_callback
+) :
+	shader_{ &shader },
+	uniform_callback_{ uniform_callback },
+	instance_callback_{ instance_callback } {}
 
-ShaderPass::ShaderPass(std::string_view shader_name, const UniformCallback& uniform_callback) :
-	shader_{ &game.shader.Get(shader_name) }, uniform_callback_{ uniform_callback } {}
+ShaderPass::ShaderPass(
+	std::string_view shader_name, const UniformCallback& uniform_callback,
+	InstanceCallback instance_callback
+) :
+	shader_{ &game.shader.Get(shader_name) },
+	uniform_callback_{ uniform_callback },
+	instance_callback_{ instance_callback } {}
 
 ShaderPass::ShaderPass(const char* shader_name) : shader_{ &game.shader.Get(shader_name) } {}
 
@@ -266,6 +297,22 @@ void ShaderPass::Invoke(Entity entity) const {
 	}
 }
 
+bool ShaderPass::IsInstanced() const {
+	return instance_callback_ != nullptr;
+}
+
+QuadInstance ShaderPass::GetInstance(Entity entity) const {
+	PTGN_ASSERT(IsInstanced(), "Shader pass has no instance callback");
+	return instance_callback_(entity);
+}
+
+std::size_t ShaderPass::GetHash() const {
+	std::size_t value{ std::hash<const Shader*>{}(shader_) };
+	value = value * 31 + std::hash<UniformCallback>{}(uniform_callback_);
+	value = value * 31 + std::hash<InstanceCallback>{}(instance_callback_);
+	return value;
+}
+
 DrawContext::DrawContext(const V2_int& size, TextureFormat texture_format) :
 	frame_buffer{ Texture{ nullptr, size, texture_format } }, timer{ true } {}
 
@@ -450,7 +497,7 @@ static std::optional<QuadInfo> GetQuadInfo(RenderData& ctx, DrawShapeCommand& cm
 		if (radius <= 0.0f) {
 			cmd.render_state.shader_pass = std::nullopt;
 			cmd.shape					 = Rect{ shape.GetSize() };
-			ctx.DrawCommand(cmd);
+			ctx.DrawShape(cmd);
 			return std::nullopt;
 		}
 
@@ -487,29 +534,26 @@ static void DrawShape(RenderData& ctx, DrawShapeCommand cmd, const T& shape) {
 
 		const auto& [points, data] = *info;
 
-		auto quad_vertices{
-			Vertex::GetQuad(points, cmd.tint, cmd.depth, data, GetDefaultTextureCoordinates())
-		};
-
 		ctx.SetState(cmd.render_state);
-		ctx.AddVertices(quad_vertices, quad_indices);
+		ctx.AddQuad(points, cmd.tint, cmd.depth, data, GetDefaultTextureCoordinates());
 	} else if constexpr (std::is_same_v<T, Circle>) {
 		cmd.shape = Ellipse{ V2_float{ shape.GetRadius() } };
-		ctx.DrawCommand(cmd);
+		ctx.DrawShape(cmd);
 	} else if constexpr (std::is_same_v<T, Rect>) {
 		if (auto size{ shape.GetSize(cmd.transform) }; !size.BothAboveZero()) {
 			return;
 		}
 
 		auto points = shape.GetWorldVertices(cmd.transform, cmd.origin);
-		auto vertices =
-			Vertex::GetQuad(points, cmd.tint, cmd.depth, { 0.0f }, GetDefaultTextureCoordinates());
 
 		ctx.SetState(cmd.render_state);
 
 		if (cmd.line_width == -1.0f) {
-			ctx.AddVertices(vertices, quad_indices);
+			ctx.AddQuad(points, cmd.tint, cmd.depth, { 0.0f }, GetDefaultTextureCoordinates());
 		} else {
+			auto vertices = Vertex::GetQuad(
+				points, cmd.tint, cmd.depth, { 0.0f }, GetDefaultTextureCoordinates()
+			);
 			ctx.AddLinesImpl(vertices, quad_indices, points, cmd.line_width, {});
 		}
 
@@ -532,11 +576,11 @@ static void DrawShape(RenderData& ctx, DrawShapeCommand cmd, const T& shape) {
 				return;
 			} else if (shape.vertices.size() == 1) {
 				cmd.shape = V2_float{ shape.vertices.front() };
-				ctx.DrawCommand(cmd);
+				ctx.DrawShape(cmd);
 				return;
 			} else if (shape.vertices.size() == 2) {
 				cmd.shape = Line{ shape.vertices[0], shape.vertices[1] };
-				ctx.DrawCommand(cmd);
+				ctx.DrawShape(cmd);
 				return;
 			}
 		}
@@ -557,55 +601,536 @@ static void DrawShape(RenderData& ctx, DrawShapeCommand cmd, const T& shape) {
 	}
 }
 
-void RenderData::DrawCommand(const impl::DrawCommand& cmd) {
-	std::visit(
-		[&](const auto& command) {
-			using T = std::decay_t<decltype(command)>;
-
-			if constexpr (std::is_same_v<T, DrawShapeCommand>) {
-				std::visit(
-					[&](const auto& shape) { impl::DrawShape(*this, command, shape); },
-					command.shape
-				);
-			} else if constexpr (std::is_same_v<T, DrawTextureCommand>) {
-				DrawTexture(command);
-			} else if constexpr (std::is_same_v<T, DrawShaderCommand>) {
-				DrawShader(command);
-			} else if constexpr (std::is_same_v<T, DrawLinesCommand>) {
-				DrawLines(command);
-			} else if constexpr (std::is_same_v<T, EnableStencilMask>) {
-				Flush();
-				StencilMask::Enable();
-			} else if constexpr (std::is_same_v<T, DisableStencilMask>) {
-				Flush();
-				StencilMask::Disable();
-			} else if constexpr (std::is_same_v<T, DrawInsideStencilMask>) {
-				Flush();
-				StencilMask::DrawInside();
-			} else if constexpr (std::is_same_v<T, DrawOutsideStencilMask>) {
-				Flush();
-				StencilMask::DrawOutside();
-			} else {
-				PTGN_ERROR("Unknown draw command type");
-			}
-		},
-		cmd
+void CommandBuffer::Add(const DrawShapeCommand& command, TextureId target, bool debug) {
+	auto render_state{ InternRenderState(command.render_state) };
+	Push(
+		CommandType::Shape, static_cast<std::uint32_t>(shapes_.size()), target, debug,
+		command.depth, GetStateBits(render_state, 0)
+	);
+
+	auto& shape{ shapes_.emplace_back() };
+	shape.transform	   = command.transform;
+	shape.depth		   = command.depth;
+	shape.tint		   = command.tint;
+	shape.line_width   = command.line_width;
+	shape.origin	   = command.origin;
+	shape.render_state = render_state;
+
+	if (const auto* polygon{ std::get_if<Polygon>(&command.shape) }; polygon != nullptr) {
+		shape.shape	 = Polygon{};
+		shape.points = AddPoints(polygon->vertices);
+	} else {
+		shape.shape = command.shape;
+	}
+}
+
+void CommandBuffer::Add(const DrawLinesCommand& command, TextureId target, bool debug) {
+	auto render_state{ InternRenderState(command.render_state) };
+	Push(
+		CommandType::Lines, static_cast<std::uint32_t>(lines_.size()), target, debug,
+		command.depth, GetStateBits(render_state, 0)
+	);
+
+	auto& lines{ lines_.emplace_back() };
+	lines.points				= AddPoints(command.points);
+	lines.connect_last_to_first = command.connect_last_to_first;
+	lines.transform				= command.transform;
+	lines.depth					= command.depth;
+	lines.tint					= command.tint;
+	lines.line_width			= command.line_width;
+	lines.render_state			= render_state;
+}
+
+void CommandBuffer::Add(const DrawTextureCommand& command, TextureId target, bool debug) {
+	if (auto size{ command.rect.GetSize(command.transform) }; !size.BothAboveZero()) {
+		return;
+	}
+
+	auto render_state{ InternRenderState(command.render_state) };
+	Push(
+		CommandType::Texture, static_cast<std::uint32_t>(textures_.size()), target, debug,
+		command.depth, GetStateBits(render_state, command.texture_id)
 	);
+
+	auto& texture{ textures_.emplace_back() };
+	texture.texture_id			= command.texture_id;
+	texture.texture_size		= command.texture_size;
+	texture.texture_format		= command.texture_format;
+	texture.points				= command.rect.GetWorldVertices(command.transform, command.origin);
+	texture.texture_coordinates = command.texture_coordinates;
+	texture.depth				= command.depth;
+	texture.tint				= command.tint;
+	texture.render_state		= render_state;
+
+	if (!command.pre_fx.pre_fx_.empty()) {
+		texture.pre_fx = static_cast<std::uint32_t>(pre_fx_.size());
+		pre_fx_.emplace_back(command.pre_fx);
+	}
 }
 
-void RenderData::Submit(const impl::DrawCommand& command, bool debug) {
+void CommandBuffer::Add(const DrawShaderCommand& command, TextureId target, bool debug) {
+	auto render_state{ InternRenderState(command.render_state) };
+	Push(
+		CommandType::Shader, static_cast<std::uint32_t>(shaders_.size()), target, debug,
+		command.depth, GetStateBits(render_state, 0)
+	);
+
+	auto& shader{ shaders_.emplace_back() };
+	shader.intermediate_blend_mode		   = command.intermediate_blend_mode;
+	shader.target_blend_mode			   = command.target_blend_mode;
+	shader.clear_between_consecutive_calls = command.clear_between_consecutive_calls;
+	shader.texture_format				   = command.texture_format;
+	shader.texture_or_size				   = command.texture_or_size;
+	shader.target_clear_color			   = command.target_clear_color;
+	shader.depth						   = command.depth;
+	shader.entity						   = command.entity;
+	shader.render_state					   = render_state;
+}
+
+void CommandBuffer::Add(const DrawStaticBatchCommand& command, TextureId target, bool debug) {
+	auto render_state{ InternRenderState(command.render_state) };
+	Push(
+		CommandType::StaticBatch, static_cast<std::uint32_t>(static_batches_.size()), target,
+		debug, command.depth, GetStateBits(render_state, 0)
+	);
+	static_batches_.push_back({ command.batch, command.depth, render_state });
+}
+
+void CommandBuffer::Add(CommandType type, TextureId target, bool debug) {
 	PTGN_ASSERT(
-		drawing_to_.texture_id, "Cannot submit render command to unspecified render target"
+		type != CommandType::Shape && type != CommandType::Lines &&
+			type != CommandType::Texture && type != CommandType::Shader &&
+			type != CommandType::StaticBatch,
+		"Draw command type requires command data"
 	);
+	// Stencil mask commands change how every following command is drawn, so they are placed in a
+	// segment of their own.
+	BeginSegment();
+	Push(type, 0, target, debug, Depth{}, 0);
+	BeginSegment();
+}
+
+void CommandBuffer::BeginDrawable() {
+	order_ = 0;
+	previous_state_.reset();
+}
+
+void CommandBuffer::Append(const CommandBuffer& other) {
+	PTGN_ASSERT(&other != this, "Cannot append a command buffer to itself");
+
+	// Arena indices of other are offset by the number of commands already in each arena.
+	const auto offset = [](const auto& arena) {
+		return static_cast<std::uint32_t>(arena.size());
+	};
+
+	std::uint32_t shape_offset{ offset(shapes_) };
+	std::uint32_t line_offset{ offset(lines_) };
+	std::uint32_t texture_offset{ offset(textures_) };
+	std::uint32_t shader_offset{ offset(shaders_) };
+	std::uint32_t static_batch_offset{ offset(static_batches_) };
+	std::uint32_t pre_fx_offset{ offset(pre_fx_) };
+	std::uint32_t point_offset{ offset(points_) };
+
+	// Render states of other are interned into the render states of this buffer.
+	std::vector<std::uint32_t> render_states;
+	render_states.reserve(other.render_states_.size());
+	for (const auto& render_state : other.render_states_) {
+		render_states.emplace_back(InternRenderState(render_state));
+	}
+
+	shapes_.insert(shapes_.end(), other.shapes_.begin(), other.shapes_.end());
+	lines_.insert(lines_.end(), other.lines_.begin(), other.lines_.end());
+	textures_.insert(textures_.end(), other.textures_.begin(), other.textures_.end());
+	shaders_.insert(shaders_.end(), other.shaders_.begin(), other.shaders_.end());
+	static_batches_.insert(
+		static_batches_.end(), other.static_batches_.begin(), other.static_batches_.end()
+	);
+	pre_fx_.insert(pre_fx_.end(), other.pre_fx_.begin(), other.pre_fx_.end());
+	points_.insert(points_.end(), other.points_.begin(), other.points_.end());
+
+	const auto remap = [&](auto& arena, std::uint32_t first) {
+		for (std::size_t i{ first }; i < arena.size(); ++i) {
+			arena[i].render_state = render_states[arena[i].render_state];
+		}
+	};
+
+	remap(shapes_, shape_offset);
+	remap(lines_, line_offset);
+	remap(textures_, texture_offset);
+	remap(shaders_, shader_offset);
+	remap(static_batches_, static_batch_offset);
+
+	for (std::size_t i{ shape_offset }; i < shapes_.size(); ++i) {
+		shapes_[i].points.offset += point_offset;
+	}
+	for (std::size_t i{ line_offset }; i < lines_.size(); ++i) {
+		lines_[i].points.offset += point_offset;
+	}
+	for (std::size_t i{ texture_offset }; i < textures_.size(); ++i) {
+		if (textures_[i].pre_fx != TextureCommand::no_pre_fx) {
+			textures_[i].pre_fx += pre_fx_offset;
+		}
+	}
+
+	// The first segment of other continues the current segment of this buffer. Entries of an
+	// unsorted buffer are in submission order. If other was sorted, equal keys remain in
+	// submission order.
+	std::uint32_t segment_offset{ segment_ };
+	for (const auto& entry : other.entries_) {
+		std::uint32_t index{ entry.index };
+		std::uint32_t render_state{ 0 };
+		TextureId texture{ 0 };
+		switch (entry.type) {
+			case CommandType::Shape:
+				index += shape_offset;
+				render_state = shapes_[index].render_state;
+				break;
+			case CommandType::Lines:
+				index += line_offset;
+				render_state = lines_[index].render_state;
+				break;
+			case CommandType::Texture:
+				index += texture_offset;
+				render_state = textures_[index].render_state;
+				texture		 = textures_[index].texture_id;
+				break;
+			case CommandType::Shader:
+				index += shader_offset;
+				render_state = shaders_[index].render_state;
+				break;
+			case CommandType::StaticBatch:
+				index += static_batch_offset;
+				render_state = static_batches_[index].render_state;
+				break;
+			default: break;
+		}
+
+		std::uint64_t key{ entry.key & (debug_bit_ | depth_mask_ | order_mask_) };
+
+		auto segment{ ((entry.key & segment_mask_) >> segment_shift_) + segment_offset };
+		PTGN_ASSERT(
+			segment < (std::uint64_t{ 1 } << segment_bits_),
+			"Too many draw command segments submitted in one frame"
+		);
+		key |= segment << segment_shift_;
+
+		if ((entry.key & debug_bit_) == 0) {
+			auto slot{ static_cast<std::size_t>((entry.key & target_mask_) >> target_shift_) };
+			PTGN_ASSERT(slot < other.targets_.size());
+			key |= GetTargetBits(other.targets_[slot]);
+		}
+
+		if (entry.type < CommandType::EnableStencilMask) {
+			key |= GetStateBits(render_state, texture);
+		}
+
+		if (sorted_ && !entries_.empty() && entries_.back().key > key) {
+			sorted_ = false;
+		}
+
+		entries_.push_back({ key, index, entry.type });
+	}
+
+	segment_ += other.segment_;
+}
+
+DrawShapeCommand CommandBuffer::GetShape(std::uint32_t index) const {
+	PTGN_ASSERT(index < shapes_.size());
+	const auto& shape{ shapes_[index] };
+
+	DrawShapeCommand command;
+	command.transform	 = shape.transform;
+	command.depth		 = shape.depth;
+	command.tint		 = shape.tint;
+	command.line_width	 = shape.line_width;
+	command.origin		 = shape.origin;
+	command.render_state = GetRenderState(shape.render_state);
+
+	if (std::holds_alternative<Polygon>(shape.shape)) {
+		command.shape = Polygon{ GetPoints(shape.points) };
+	} else {
+		command.shape = shape.shape;
+	}
+
+	return command;
+}
+
+const LinesCommand& CommandBuffer::GetLines(std::uint32_t index) const {
+	PTGN_ASSERT(index < lines_.size());
+	return lines_[index];
+}
+
+const TextureCommand& CommandBuffer::GetTexture(std::uint32_t index) const {
+	PTGN_ASSERT(index < textures_.size());
+	return textures_[index];
+}
+
+DrawShaderCommand CommandBuffer::GetShader(std::uint32_t index) const {
+	PTGN_ASSERT(index < shaders_.size());
+	const auto& shader{ shaders_[index] };
+
+	DrawShaderCommand command;
+	command.intermediate_blend_mode			= shader.intermediate_blend_mode;
+	command.target_blend_mode				= shader.target_blend_mode;
+	command.clear_between_consecutive_calls = shader.clear_between_consecutive_calls;
+	command.texture_format					= shader.texture_format;
+	command.texture_or_size					= shader.texture_or_size;
+	command.target_clear_color				= shader.target_clear_color;
+	command.depth							= shader.depth;
+	command.entity							= shader.entity;
+	command.render_state					= GetRenderState(shader.render_state);
+	return command;
+}
+
+DrawStaticBatchCommand CommandBuffer::GetStaticBatch(std::uint32_t index) const {
+	PTGN_ASSERT(index < static_batches_.size());
+	const auto& static_batch{ static_batches_[index] };
+	return { static_batch.batch, static_batch.depth, GetRenderState(static_batch.render_state) };
+}
+
+const RenderState& CommandBuffer::GetRenderState(std::uint32_t render_state) const {
+	PTGN_ASSERT(render_state < render_states_.size());
+	return render_states_[render_state];
+}
+
+std::span<const V2_float> CommandBuffer::GetPoints(const PointRange& range) const {
+	PTGN_ASSERT(range.offset + range.count <= points_.size());
+	return { points_.data() + range.offset, range.count };
+}
+
+const PreFX* CommandBuffer::GetPreFX(const TextureCommand& command) const {
+	if (command.pre_fx == TextureCommand::no_pre_fx) {
+		return nullptr;
+	}
+	PTGN_ASSERT(command.pre_fx < pre_fx_.size());
+	return &pre_fx_[command.pre_fx];
+}
+
+void CommandBuffer::Clear() {
+	entries_.clear();
+	targets_.clear();
+	shapes_.clear();
+	lines_.clear();
+	textures_.clear();
+	shaders_.clear();
+	static_batches_.clear();
+	render_states_.clear();
+	render_state_lookup_.clear();
+	texture_ids_.clear();
+	pre_fx_.clear();
+	points_.clear();
+	segment_ = 0;
+	order_	 = 0;
+	previous_state_.reset();
+	sorted_ = true;
+}
+
+std::uint32_t CommandBuffer::InternRenderState(const RenderState& render_state) {
+	auto hash{ render_state.GetHash() };
+	auto [first, last] = render_state_lookup_.equal_range(hash);
+	for (auto it{ first }; it != last; ++it) {
+		if (render_states_[it->second] == render_state) {
+			return it->second;
+		}
+	}
+	auto index{ static_cast<std::uint32_t>(render_states_.size()) };
+	render_states_.emplace_back(render_state);
+	render_state_lookup_.emplace(hash, index);
+	return index;
+}
+
+std::uint64_t CommandBuffer::GetStateBits(std::uint32_t render_state, TextureId texture) {
+	// Ids are assigned in order of first use. Ids which do not fit share the largest id.
+	constexpr std::uint64_t max_render_state{ (std::uint64_t{ 1 } << render_state_bits_) - 1 };
+	constexpr std::uint64_t max_texture{ (std::uint64_t{ 1 } << texture_bits_) - 1 };
+
+	auto [it, inserted] =
+		texture_ids_.try_emplace(texture, static_cast<std::uint32_t>(texture_ids_.size()));
+
+	return (std::min<std::uint64_t>(render_state, max_render_state) << render_state_shift_) |
+		   std::min<std::uint64_t>(it->second, max_texture);
+}
+
+std::uint64_t CommandBuffer::GetTargetBits(TextureId target) {
+	auto it{ std::ranges::find(targets_, target) };
+	auto slot{ static_cast<std::uint64_t>(it - targets_.begin()) };
+	if (it == targets_.end()) {
+		PTGN_ASSERT(
+			slot < (std::uint64_t{ 1 } << target_bits_),
+			"Too many render targets drawn in one frame"
+		);
+		targets_.emplace_back(target);
+	}
+	return slot << target_shift_;
+}
+
+PointRange CommandBuffer::AddPoints(std::span<const V2_float> points) {
+	PointRange range{ static_cast<std::uint32_t>(points_.size()),
+					  static_cast<std::uint32_t>(points.size()) };
+	points_.insert(points_.end(), points.begin(), points.end());
+	return range;
+}
+
+void CommandBuffer::Push(
+	CommandType type, std::uint32_t index, TextureId target, bool debug, Depth depth,
+	std::uint64_t state
+) {
+	// The order within the drawable only advances when the state changes, so that consecutive
+	// commands of equal state remain adjacent and commands of other drawables may join them.
+	if (previous_state_.has_value() && *previous_state_ != state) {
+		if (order_ == (std::uint32_t{ 1 } << order_bits_) - 1) {
+			BeginSegment();
+		} else {
+			++order_;
+		}
+	}
+	previous_state_ = state;
+
+	constexpr std::int32_t min_depth{ std::numeric_limits<std::int16_t>::min() };
+	constexpr std::int32_t max_depth{ std::numeric_limits<std::int16_t>::max() };
+	auto depth_bits{ static_cast<std::uint64_t>(
+		std::clamp(static_cast<std::int32_t>(depth), min_depth, max_depth) - min_depth
+	) };
+
+	std::uint64_t key{ state };
+	key |= depth_bits << depth_shift_;
+	key |= static_cast<std::uint64_t>(order_) << order_shift_;
+	key |= static_cast<std::uint64_t>(segment_) << segment_shift_;
+
 	if (debug) {
-		debug_queue_.emplace_back(command);
+		// Debug commands are drawn on top of whichever target is flushed with debug drawing.
+		key |= debug_bit_;
 	} else {
-		draw_queues_[drawing_to_.texture_id].emplace_back(command);
+		key |= GetTargetBits(target);
+	}
+
+	if (sorted_ && !entries_.empty() && entries_.back().key > key) {
+		sorted_ = false;
+	}
+
+	entries_.push_back({ key, index, type });
+}
+
+void CommandBuffer::BeginSegment() {
+	++segment_;
+	PTGN_ASSERT(
+		segment_ < (std::uint32_t{ 1 } << segment_bits_),
+		"Too many stencil mask commands submitted in one frame"
+	);
+	order_ = 0;
+	previous_state_.reset();
+}
+
+bool CommandBuffer::GetTargetSlot(TextureId target, std::uint64_t& out_prefix) const {
+	auto it{ std::ranges::find(targets_, target) };
+	if (it == targets_.end()) {
+		return false;
+	}
+	out_prefix = static_cast<std::uint64_t>(it - targets_.begin()) << target_shift_;
+	return true;
+}
+
+void CommandBuffer::Sort() {
+	if (sorted_) {
+		return;
+	}
+	sorted_ = true;
+
+	// Entries are appended in submission order and every pass is stable, so entries with equal
+	// keys keep their submission order. Key bytes which are equal across all entries are skipped.
+	std::uint64_t differing{ 0 };
+	for (const auto& entry : entries_) {
+		differing |= entry.key ^ entries_.front().key;
+	}
+
+	sort_buffer_.resize(entries_.size());
+
+	for (std::uint32_t shift{ 0 }; shift < 64; shift += 8) {
+		if (((differing >> shift) & 0xFF) == 0) {
+			continue;
+		}
+
+		std::array<std::size_t, 257> offsets{};
+		for (const auto& entry : entries_) {
+			++offsets[((entry.key >> shift) & 0xFF) + 1];
+		}
+		std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+		for (const auto& entry : entries_) {
+			sort_buffer_[offsets[(entry.key >> shift) & 0xFF]++] = entry;
+		}
+		entries_.swap(sort_buffer_);
+	}
+}
+
+void RenderData::DrawCommand(CommandType type, std::uint32_t index) {
+	switch (type) {
+		case CommandType::Shape:	   DrawShape(commands_.GetShape(index)); break;
+		case CommandType::Lines:	   DrawLines(commands_.GetLines(index)); break;
+		case CommandType::Texture:	   DrawTexture(commands_.GetTexture(index)); break;
+		case CommandType::Shader:	   DrawShader(commands_.GetShader(index)); break;
+		case CommandType::StaticBatch: DrawStaticBatch(commands_.GetStaticBatch(index)); break;
+		case CommandType::EnableStencilMask:
+			Flush();
+			StencilMask::Enable();
+			break;
+		case CommandType::DisableStencilMask:
+			Flush();
+			StencilMask::Disable();
+			break;
+		case CommandType::DrawInsideStencilMask:
+			Flush();
+			StencilMask::DrawInside();
+			break;
+		case CommandType::DrawOutsideStencilMask:
+			Flush();
+			StencilMask::DrawOutside();
+			break;
+		default:					   PTGN_ERROR("Unknown draw command type");
 	}
 }
 
-void RenderData::DrawLines(const DrawLinesCommand& cmd) {
-	std::size_t count = cmd.points.size();
+void RenderData::DrawShape(const DrawShapeCommand& cmd) {
+	std::visit([&](const auto& shape) { impl::DrawShape(*this, cmd, shape); }, cmd.shape);
+}
+
+TextureId RenderData::GetSubmitTarget() const {
+	PTGN_ASSERT(
+		drawing_to_.texture_id, "Cannot submit render command to unspecified render target"
+	);
+	return drawing_to_.texture_id;
+}
+
+CommandBuffer& RenderData::GetRecordingBuffer() {
+	return recording_buffer != nullptr ? *recording_buffer : commands_;
+}
+
+void RenderData::Submit(const DrawShapeCommand& command, bool debug) {
+	GetRecordingBuffer().Add(command, GetSubmitTarget(), debug);
+}
+
+void RenderData::Submit(const DrawLinesCommand& command, bool debug) {
+	GetRecordingBuffer().Add(command, GetSubmitTarget(), debug);
+}
+
+void RenderData::Submit(const DrawTextureCommand& command, bool debug) {
+	GetRecordingBuffer().Add(command, GetSubmitTarget(), debug);
+}
+
+void RenderData::Submit(const DrawShaderCommand& command, bool debug) {
+	GetRecordingBuffer().Add(command, GetSubmitTarget(), debug);
+}
+
+void RenderData::Submit(const DrawStaticBatchCommand& command, bool debug) {
+	GetRecordingBuffer().Add(command, GetSubmitTarget(), debug);
+}
+
+void RenderData::Submit(CommandType type, bool debug) {
+	GetRecordingBuffer().Add(type, GetSubmitTarget(), debug);
+}
+
+void RenderData::DrawLines(const LinesCommand& cmd) {
+	auto points{ commands_.GetPoints(cmd.points) };
+	std::size_t count = points.size();
 
 	PTGN_ASSERT(cmd.line_width >= min_line_width);
 
@@ -618,36 +1143,25 @@ void RenderData::DrawLines(const DrawLinesCommand& cmd) {
 		vertex_modulo -= 1;
 	}
 
-	SetState(cmd.render_state);
+	SetState(commands_.GetRenderState(cmd.render_state));
 
 	for (std::size_t i = 0; i < count; ++i) {
-		Line l{ cmd.points[i], cmd.points[(i + 1) % vertex_modulo] };
-		auto quad_points   = l.GetWorldQuadVertices(cmd.transform, cmd.line_width);
-		auto quad_vertices = Vertex::GetQuad(
-			quad_points, cmd.tint, cmd.depth, { 0.0f }, GetDefaultTextureCoordinates()
-		);
-		AddVertices(quad_vertices, quad_indices);
+		Line l{ points[i], points[(i + 1) % vertex_modulo] };
+		auto quad_points = l.GetWorldQuadVertices(cmd.transform, cmd.line_width);
+		AddQuad(quad_points, cmd.tint, cmd.depth, { 0.0f }, GetDefaultTextureCoordinates());
 	}
 }
 
-void RenderData::DrawTexture(const DrawTextureCommand& cmd) {
+void RenderData::DrawTexture(const TextureCommand& cmd) {
 	auto texture_id{ cmd.texture_id };
 
 	PTGN_ASSERT(texture_id, "Cannot draw textured quad with invalid texture");
 
-	if (auto size{ cmd.rect.GetSize(cmd.transform) }; !size.BothAboveZero()) {
-		return;
-	}
-
-	SetState(cmd.render_state);
+	SetState(commands_.GetRenderState(cmd.render_state));
 
-	auto texture_points{ cmd.rect.GetWorldVertices(cmd.transform, cmd.origin) };
+	const auto& texture_points{ cmd.points };
 
-	auto texture_vertices{ Vertex::GetQuad(
-		texture_points, cmd.tint, cmd.depth, { 0.0f }, cmd.texture_coordinates, false
-	) };
-
-	if (!cmd.pre_fx.pre_fx_.empty()) {
+	if (const auto* pre_fx{ commands_.GetPreFX(cmd) }; pre_fx != nullptr) {
 		PTGN_ASSERT(
 			cmd.texture_size.BothAboveZero(),
 			"Texture must have a valid size for it to have post fx"
@@ -671,7 +1185,7 @@ void RenderData::DrawTexture(const DrawTextureCommand& cmd) {
 		target.view_projection = Matrix4::Orthographic(target.points[0], target.points[2]);
 
 		texture_id = PingPong(
-			cmd.pre_fx.pre_fx_, draw_context_pool.Get(viewport.size, target.texture_format),
+			pre_fx->pre_fx_, draw_context_pool.Get(viewport.size, target.texture_format),
 			texture_id, target, true
 		);
 
@@ -679,6 +1193,11 @@ void RenderData::DrawTexture(const DrawTextureCommand& cmd) {
 		force_flush = true;
 	}
 
+	bool instanced{ GetInstancedShader() != nullptr &&
+					QuadInstance::CanInstance(texture_points, cmd.texture_coordinates) };
+
+	ReserveQuad(instanced);
+
 	float texture_index = 0.0f;
 
 	auto get_texture_index = [&](TextureId id, float& out_texture_index) {
@@ -701,11 +1220,20 @@ void RenderData::DrawTexture(const DrawTextureCommand& cmd) {
 
 	bool existing = get_texture_index(texture_id, texture_index);
 
-	Vertex::SetTextureIndex(texture_vertices, texture_index);
-	AddVertices(texture_vertices, quad_indices);
+	if (instanced) {
+		instances_.emplace_back(QuadInstance::Get(
+			texture_points, cmd.tint, cmd.depth, { texture_index }, cmd.texture_coordinates
+		));
+	} else {
+		auto texture_vertices{ Vertex::GetQuad(
+			texture_points, cmd.tint, cmd.depth, { 0.0f }, cmd.texture_coordinates, false
+		) };
+		Vertex::SetTextureIndex(texture_vertices, texture_index);
+		AddVertices(texture_vertices, quad_indices);
+	}
 
 	if (!existing) {
-		// Must be done after AddVertices and SetState because both of them may Flush the
+		// Must be done after adding the quad and SetState because both of them may Flush the
 		// current batch, which will clear textures.
 		textures_.emplace_back(texture_id);
 	}
@@ -713,7 +1241,41 @@ void RenderData::DrawTexture(const DrawTextureCommand& cmd) {
 	PTGN_ASSERT(textures_.size() < max_texture_slots);
 }
 
+void RenderData::DrawStaticBatch(const DrawStaticBatchCommand& cmd) {
+	if (!cmd.batch.IsAlive() || !cmd.batch.Has<StaticBatchData>()) {
+		return;
+	}
+
+	// Vertices batched before the static batch must be drawn first to preserve draw order.
+	Flush();
+	render_state = cmd.render_state;
+
+	PTGN_ASSERT(
+		render_state.post_fx.post_fx_.empty(), "Static batches do not support post processing"
+	);
+
+	auto target{ drawing_to_ };
+	if (render_state.camera) {
+		target.view_projection = render_state.camera;
+	}
+
+	const auto& shader{ GetCurrentShader() };
+
+	for (const auto& segment : cmd.batch.Get<StaticBatchData>().segments) {
+		DrawVertexArray(
+			shader, segment.vertex_array, segment.index_count, segment.textures,
+			target.frame_buffer, false, color::Transparent, render_state.blend_mode,
+			target.viewport, target.view_projection
+		);
+	}
+}
+
 void RenderData::DrawShader(const DrawShaderCommand& cmd) {
+	if (cmd.render_state.shader_pass.has_value() && cmd.render_state.shader_pass->IsInstanced()) {
+		DrawShaderInstance(cmd);
+		return;
+	}
+
 	bool state_changed{ SetState(cmd.render_state) };
 
 	bool uses_size{ std::holds_alternative<V2_int>(cmd.texture_or_size) };
@@ -788,6 +1350,63 @@ void RenderData::DrawShader(const DrawShaderCommand& cmd) {
 	);
 }
 
+void RenderData::DrawShaderInstance(const DrawShaderCommand& cmd) {
+	PTGN_ASSERT(
+		cmd.render_state.post_fx.post_fx_.empty(), "Instanced shader passes cannot have post fx"
+	);
+	PTGN_ASSERT(
+		std::holds_alternative<V2_int>(cmd.texture_or_size),
+		"Instanced shader passes cannot draw to a texture"
+	);
+
+	bool state_changed{ SetState(cmd.render_state) };
+
+	if (cmd.clear_between_consecutive_calls) {
+		force_flush = true;
+	}
+
+	auto target{ drawing_to_ };
+
+	if (render_state.camera) {
+		target.view_projection = render_state.camera;
+	}
+
+	if (!std::get<V2_int>(cmd.texture_or_size).IsZero()) {
+		target.viewport.size = std::get<V2_int>(cmd.texture_or_size);
+	}
+
+	if (state_changed || !intermediate_target) {
+		intermediate_target = draw_context_pool.Get(target.viewport.size, cmd.texture_format);
+		shader_instance_clear_color_ = cmd.target_clear_color;
+		clear_shader_instances_		 = true;
+	}
+
+	intermediate_target->blend_mode = cmd.target_blend_mode;
+	shader_instance_blend_mode_		= cmd.intermediate_blend_mode;
+
+	if (instances_.size() == batch_capacity) {
+		DrawShaderInstances(target.viewport, target.view_projection);
+	}
+
+	auto instance{ cmd.render_state.shader_pass->GetInstance(cmd.entity) };
+	instance.position[2] = static_cast<float>(cmd.depth);
+	instances_.emplace_back(instance);
+}
+
+void RenderData::DrawShaderInstances(const Viewport& viewport, const Matrix4& view_projection) {
+	PTGN_ASSERT(intermediate_target, "Shader pass instances require an intermediate target");
+	PTGN_ASSERT(render_state.shader_pass.has_value());
+
+	DrawInstances(
+		render_state.shader_pass->GetShader(), instances_, {}, &intermediate_target->frame_buffer,
+		clear_shader_instances_, shader_instance_clear_color_, shader_instance_blend_mode_,
+		viewport, view_projection
+	);
+
+	instances_.clear();
+	clear_shader_instances_ = false;
+}
+
 TextureId RenderData::PingPong(
 	const std::vector<Entity>& container, const std::shared_ptr<DrawContext>& read_context,
 	TextureId id, DrawTarget target, bool flip_vertices
@@ -850,7 +1469,7 @@ TextureId RenderData::PingPong(
 	return write->frame_buffer.GetTexture().GetId();
 }
 
-void RenderData::Init() {
+void RenderData::Init(VertexFormat format) {
 	// GLRenderer::EnableLineSmoothing();
 
 	GLRenderer::DisableDepthTesting();
@@ -869,6 +1488,7 @@ void RenderData::Init() {
 	PTGN_ASSERT(game.shader.Get("circle").IsValid());
 	PTGN_ASSERT(game.shader.Get("screen_default").IsValid());
 	PTGN_ASSERT(game.shader.Get("light").IsValid());
+	PTGN_ASSERT(game.shader.Get("light_instanced").IsValid());
 
 	std::vector<std::int32_t> samplers(max_texture_slots);
 	std::iota(samplers.begin(), samplers.end(), 0);
@@ -878,13 +1498,36 @@ void RenderData::Init() {
 		"u_Texture", samplers.data(), static_cast<std::int32_t>(samplers.size())
 	);
 
-	IndexBuffer quad_ib{ nullptr, index_capacity, static_cast<std::uint32_t>(sizeof(Index)),
-						 BufferUsage::DynamicDraw };
-	VertexBuffer quad_vb{ nullptr, vertex_capacity, static_cast<std::uint32_t>(sizeof(Vertex)),
-						  BufferUsage::DynamicDraw };
+	constexpr std::array<std::string_view, std::tuple_size_v<decltype(instanced_shaders_)>>
+		instanced_shader_names{ "quad", "circle", "capsule", "rounded_rect", "arc" };
+
+	for (std::size_t i{ 0 }; i < instanced_shader_names.size(); ++i) {
+		std::string name{ instanced_shader_names[i] };
+		const auto& instanced_shader{ game.shader.Get(name + "_instanced") };
+		PTGN_ASSERT(instanced_shader.IsValid());
+		instanced_shaders_[i] = { &game.shader.Get(name), &instanced_shader };
+	}
 
-	triangle_vao = VertexArray(
-		PrimitiveMode::Triangles, std::move(quad_vb), Vertex::GetLayout(), std::move(quad_ib)
+	const auto& quad_instanced_shader{ *instanced_shaders_.front().second };
+	quad_instanced_shader.Bind();
+	quad_instanced_shader.SetUniform(
+		"u_Texture", samplers.data(), static_cast<std::int32_t>(samplers.size())
+	);
+
+	SetVertexFormat(format);
+
+	VertexBuffer corner_vb{ quad_corners.data(), static_cast<std::uint32_t>(quad_corners.size()),
+							static_cast<std::uint32_t>(sizeof(glsl::vec2)),
+							BufferUsage::StaticDraw };
+	IndexBuffer corner_ib{ quad_indices.data(), static_cast<std::uint32_t>(quad_indices.size()),
+						   static_cast<std::uint32_t>(sizeof(Index)), BufferUsage::StaticDraw };
+	VertexBuffer instance_vb{ nullptr, batch_capacity,
+							  static_cast<std::uint32_t>(sizeof(QuadInstance)),
+							  BufferUsage::DynamicDraw };
+
+	instanced_vao = VertexArray(
+		PrimitiveMode::Triangles, std::move(corner_vb), BufferLayout<glsl::vec2>{},
+		std::move(corner_ib), std::move(instance_vb), QuadInstance::GetLayout()
 	);
 
 	white_texture = Texture(static_cast<const void*>(&color::White), { 1, 1 });
@@ -917,6 +1560,35 @@ void RenderData::Init() {
 	render_manager.Refresh();
 }
 
+void RenderData::SetVertexFormat(VertexFormat format) {
+	PTGN_ASSERT(
+		GetVertexCount() == 0, "Vertex format cannot be changed while a batch is pending"
+	);
+
+	vertex_format_ = format;
+
+	IndexBuffer quad_ib{ nullptr, index_capacity, static_cast<std::uint32_t>(sizeof(Index)),
+						 BufferUsage::DynamicDraw };
+
+	// Both formats are read through the same shader inputs, so only the vertex layout differs.
+	if (format == VertexFormat::Packed) {
+		VertexBuffer quad_vb{ nullptr, vertex_capacity,
+							  static_cast<std::uint32_t>(sizeof(PackedVertex)),
+							  BufferUsage::DynamicDraw };
+		triangle_vao = VertexArray(
+			PrimitiveMode::Triangles, std::move(quad_vb), PackedVertex::GetLayout(),
+			std::move(quad_ib)
+		);
+	} else {
+		VertexBuffer quad_vb{ nullptr, vertex_capacity,
+							  static_cast<std::uint32_t>(sizeof(Vertex)),
+							  BufferUsage::DynamicDraw };
+		triangle_vao = VertexArray(
+			PrimitiveMode::Triangles, std::move(quad_vb), Vertex::GetLayout(), std::move(quad_ib)
+		);
+	}
+}
+
 const Shader& RenderData::GetCurrentShader() const {
 	const Shader* shader{ nullptr };
 
@@ -977,12 +1649,18 @@ void RenderData::AddLinesImpl(
 void RenderData::AddVertices(
 	std::span<const Vertex> point_vertices, std::span<const Index> point_indices
 ) {
-	if (vertices_.size() + point_vertices.size() > vertex_capacity ||
+	if (!instances_.empty() || GetVertexCount() + point_vertices.size() > vertex_capacity ||
 		indices_.size() + point_indices.size() > index_capacity) {
 		Flush();
 	}
 
-	vertices_.insert(vertices_.end(), point_vertices.begin(), point_vertices.end());
+	if (vertex_format_ == VertexFormat::Packed) {
+		for (const auto& vertex : point_vertices) {
+			packed_vertices_.emplace_back(PackedVertex::Pack(vertex));
+		}
+	} else {
+		vertices_.insert(vertices_.end(), point_vertices.begin(), point_vertices.end());
+	}
 
 	indices_.reserve(indices_.size() + point_indices.size());
 
@@ -993,16 +1671,152 @@ void RenderData::AddVertices(
 	index_offset_ += static_cast<Index>(point_vertices.size());
 }
 
+void RenderData::AddQuad(
+	const std::array<V2_float, 4>& quad_points, const Color& color, const Depth& depth,
+	const std::array<float, 4>& data, const std::array<V2_float, 4>& texture_coordinates
+) {
+	if (GetInstancedShader() != nullptr &&
+		QuadInstance::CanInstance(quad_points, texture_coordinates)) {
+		ReserveQuad(true);
+		instances_.emplace_back(
+			QuadInstance::Get(quad_points, color, depth, data, texture_coordinates)
+		);
+		return;
+	}
+	AddVertices(
+		Vertex::GetQuad(quad_points, color, depth, data, texture_coordinates), quad_indices
+	);
+}
+
+void RenderData::ReserveQuad(bool instanced) {
+	if (instanced) {
+		if (GetVertexCount() != 0 || instances_.size() >= batch_capacity) {
+			Flush();
+		}
+		return;
+	}
+	if (!instances_.empty() || GetVertexCount() + 4 > vertex_capacity ||
+		indices_.size() + quad_indices.size() > index_capacity) {
+		Flush();
+	}
+}
+
+const Shader* RenderData::GetInstancedShader() const {
+	if (!instancing_enabled || !render_state.shader_pass.has_value()) {
+		return nullptr;
+	}
+	const auto& shader_pass{ *render_state.shader_pass };
+	if (shader_pass == ShaderPass{}) {
+		// Default shader pass uses the quad shader, which is always first.
+		return instanced_shaders_.front().second;
+	}
+	const auto* shader{ &shader_pass.GetShader() };
+	for (const auto& [batched, instanced] : instanced_shaders_) {
+		if (batched == shader) {
+			return instanced;
+		}
+	}
+	return nullptr;
+}
+
 void RenderData::DrawCall(
 	const Shader& shader, std::span<const Vertex> vertices, std::span<const Index> indices,
 	const std::vector<TextureId>& textures, const FrameBuffer* frame_buffer,
 	bool clear_frame_buffer, const Color& clear_color, BlendMode blend_mode,
 	const Viewport& viewport, const Matrix4& view_projection
 ) {
-	if (vertices.empty() || indices.empty()) {
+	if (vertex_format_ == VertexFormat::Packed) {
+		packed_scratch_.clear();
+		for (const auto& vertex : vertices) {
+			packed_scratch_.emplace_back(PackedVertex::Pack(vertex));
+		}
+		DrawVertices(
+			shader, packed_scratch_.data(), packed_scratch_.size(), sizeof(PackedVertex), indices,
+			textures, frame_buffer, clear_frame_buffer, clear_color, blend_mode, viewport,
+			view_projection
+		);
 		return;
 	}
+	DrawVertices(
+		shader, vertices.data(), vertices.size(), sizeof(Vertex), indices, textures, frame_buffer,
+		clear_frame_buffer, clear_color, blend_mode, viewport, view_projection
+	);
+}
 
+void RenderData::DrawVertices(
+	const Shader& shader, const void* vertices, std::size_t vertex_count, std::size_t vertex_size,
+	std::span<const Index> indices, const std::vector<TextureId>& textures,
+	const FrameBuffer* frame_buffer, bool clear_frame_buffer, const Color& clear_color,
+	BlendMode blend_mode, const Viewport& viewport, const Matrix4& view_projection
+) {
+	if (vertex_count == 0 || indices.empty()) {
+		return;
+	}
+
+	triangle_vao.Bind();
+
+	triangle_vao.GetVertexBuffer().SetSubData(
+		vertices, 0, static_cast<std::uint32_t>(vertex_count),
+		static_cast<std::uint32_t>(vertex_size), false, true
+	);
+
+	triangle_vao.GetIndexBuffer().SetSubData(
+		indices.data(), 0, static_cast<std::uint32_t>(indices.size()), sizeof(Index), false, true
+	);
+
+	DrawVertexArray(
+		shader, triangle_vao, indices.size(), textures, frame_buffer, clear_frame_buffer,
+		clear_color, blend_mode, viewport, view_projection
+	);
+}
+
+void RenderData::DrawVertexArray(
+	const Shader& shader, const VertexArray& vertex_array, std::size_t index_count,
+	const std::vector<TextureId>& textures, const FrameBuffer* frame_buffer,
+	bool clear_frame_buffer, const Color& clear_color, BlendMode blend_mode,
+	const Viewport& viewport, const Matrix4& view_projection
+) {
+	PrepareDrawCall(
+		shader, vertex_array, textures, frame_buffer, clear_frame_buffer, clear_color, blend_mode,
+		viewport, view_projection
+	);
+
+	GLRenderer::DrawElements(vertex_array, index_count, false);
+}
+
+void RenderData::DrawInstances(
+	const Shader& shader, std::span<const QuadInstance> instances,
+	const std::vector<TextureId>& textures, const FrameBuffer* frame_buffer,
+	bool clear_frame_buffer, const Color& clear_color, BlendMode blend_mode,
+	const Viewport& viewport, const Matrix4& view_projection
+) {
+	if (instances.empty()) {
+		return;
+	}
+
+	instanced_vao.Bind();
+
+	instanced_vao.GetInstanceBuffer().SetSubData(
+		instances.data(), 0, static_cast<std::uint32_t>(instances.size()), sizeof(QuadInstance),
+		false, true
+	);
+
+	PrepareDrawCall(
+		shader, instanced_vao, textures, frame_buffer, clear_frame_buffer, clear_color,
+		blend_mode, viewport, view_projection
+	);
+
+	GLRenderer::DrawInstanced(
+		instanced_vao, quad_indices.size(), instances.size(), false
+	);
+}
+
+void RenderData::PrepareDrawCall(
+	const Shader& shader, const VertexArray& vertex_array,
+	const std::vector<TextureId>& textures, const FrameBuffer* frame_buffer,
+	bool clear_frame_buffer, const Color& clear_color, BlendMode blend_mode,
+	const Viewport& viewport, const Matrix4& view_projection
+) {
 	if (frame_buffer) {
 		frame_buffer->Bind();
 	} else {
@@ -1018,15 +1832,7 @@ void RenderData::DrawCall(
 	GLRenderer::SetViewport(viewport.position, viewport.size);
 	GLRenderer::SetBlendMode(blend_mode);
 
-	triangle_vao.Bind();
-
-	triangle_vao.GetVertexBuffer().SetSubData(
-		vertices.data(), 0, static_cast<std::uint32_t>(vertices.size()), sizeof(Vertex), false, true
-	);
-
-	triangle_vao.GetIndexBuffer().SetSubData(
-		indices.data(), 0, static_cast<std::uint32_t>(indices.size()), sizeof(Index), false, true
-	);
+	vertex_array.Bind();
 
 	shader.Bind();
 	shader.SetUniform("u_ViewProjection", view_projection);
@@ -1039,8 +1845,36 @@ void RenderData::DrawCall(
 		std::uint32_t slot{ i + 1 };
 		Texture::Bind(textures[i], slot);
 	}
+}
 
-	GLRenderer::DrawElements(triangle_vao, indices.size(), false);
+void RenderData::DrawBatch(
+	const FrameBuffer* frame_buffer, bool clear_frame_buffer, BlendMode blend_mode,
+	const Viewport& viewport, const Matrix4& view_projection
+) {
+	if (instances_.empty()) {
+		if (vertex_format_ == VertexFormat::Packed) {
+			DrawVertices(
+				GetCurrentShader(), packed_vertices_.data(), packed_vertices_.size(),
+				sizeof(PackedVertex), indices_, textures_, frame_buffer, clear_frame_buffer,
+				color::Transparent, blend_mode, viewport, view_projection
+			);
+		} else {
+			DrawVertices(
+				GetCurrentShader(), vertices_.data(), vertices_.size(), sizeof(Vertex), indices_,
+				textures_, frame_buffer, clear_frame_buffer, color::Transparent, blend_mode,
+				viewport, view_projection
+			);
+		}
+		return;
+	}
+
+	const auto* shader{ GetInstancedShader() };
+	PTGN_ASSERT(shader, "Instanced batch requires a shader with an instanced variant");
+
+	DrawInstances(
+		*shader, instances_, textures_, frame_buffer, clear_frame_buffer, color::Transparent,
+		blend_mode, viewport, view_projection
+	);
 }
 
 void RenderData::Flush(bool final_flush) {
@@ -1065,12 +1899,9 @@ void RenderData::Flush(bool final_flush) {
 
 		target.frame_buffer = &intermediate_target->frame_buffer;
 
-		const auto& shader{ GetCurrentShader() };
-
 		// Draw unflushed vertices to intermediate target before adding post fx to it.
-		DrawCall(
-			shader, vertices_, indices_, textures_, target.frame_buffer, true, color::Transparent,
-			target.blend_mode, target.viewport, target.view_projection
+		DrawBatch(
+			target.frame_buffer, true, target.blend_mode, target.viewport, target.view_projection
 		);
 
 		// Add post fx to the intermediate target.
@@ -1093,6 +1924,9 @@ void RenderData::Flush(bool final_flush) {
 
 		if (!has_post_fx) {
 			// The light case discussed above.
+			if (!instances_.empty()) {
+				DrawShaderInstances(target.viewport, target.view_projection);
+			}
 			const auto& texture{ intermediate_target->frame_buffer.GetTexture() };
 			target.texture_id	  = texture.GetId();
 			target.texture_format = texture.GetFormat();
@@ -1115,12 +1949,9 @@ void RenderData::Flush(bool final_flush) {
 	} else if (render_state.IsSet()) {
 		// No post fx, and no intermediate target.
 
-		const auto& shader{ GetCurrentShader() };
-
 		// Draw unflushed vertices directly to drawing_to frame buffer.
-		DrawCall(
-			shader, vertices_, indices_, textures_, target.frame_buffer, false, color::Transparent,
-			target.blend_mode, target.viewport, target.view_projection
+		DrawBatch(
+			target.frame_buffer, false, target.blend_mode, target.viewport, target.view_projection
 		);
 	}
 
@@ -1134,13 +1965,21 @@ void RenderData::Flush(bool final_flush) {
 void RenderData::Reset() {
 	intermediate_target = {};
 	vertices_.clear();
+	packed_vertices_.clear();
 	indices_.clear();
+	instances_.clear();
 	textures_.clear();
-	index_offset_ = 0;
-	force_flush	  = false;
+	index_offset_			= 0;
+	force_flush				= false;
+	clear_shader_instances_ = false;
 	draw_context_pool.TrimExpired();
 }
 
+std::size_t RenderData::GetVertexCount() const {
+	// Only the vertices of the current vertex format are used.
+	return vertices_.size() + packed_vertices_.size();
+}
+
 void RenderData::InvokeDrawable(const Entity& entity) {
 	PTGN_ASSERT(entity.Has<IDrawable>(), "Cannot render entity without drawable component");
 
@@ -1152,9 +1991,86 @@ void RenderData::InvokeDrawable(const Entity& entity) {
 
 	const auto& draw_function{ drawable_functions.find(drawable.hash)->second };
 
+	GetRecordingBuffer().BeginDrawable();
+
 	draw_function(entity);
 }
 
+void RenderData::RecordDrawables(const std::vector<Entity>& entities) {
+	if (!recording_pool_ || entities.size() < 2 * min_entities_per_thread_) {
+		for (const auto& entity : entities) {
+			InvokeDrawable(entity);
+		}
+		return;
+	}
+
+	const auto& concurrent{ IDrawable::concurrent() };
+	const auto is_concurrent = [&](const Entity& entity) {
+		return entity.Has<IDrawable>() && concurrent.contains(entity.GetImpl<IDrawable>().hash);
+	};
+
+	recording_buffers_.resize(recording_pool_->GetThreadCount());
+
+	std::size_t begin{ 0 };
+	while (begin < entities.size()) {
+		// Drawables which may modify shared state are invoked on the calling thread.
+		if (!is_concurrent(entities[begin])) {
+			InvokeDrawable(entities[begin]);
+			++begin;
+			continue;
+		}
+
+		std::size_t end{ begin + 1 };
+		while (end < entities.size() && is_concurrent(entities[end])) {
+			++end;
+		}
+		std::span<const Entity> run{ entities.data() + begin, end - begin };
+		begin = end;
+
+		if (run.size() < 2 * min_entities_per_thread_) {
+			for (const auto& entity : run) {
+				InvokeDrawable(entity);
+			}
+			continue;
+		}
+
+		recording_pool_->ParallelFor(
+			run.size(), min_entities_per_thread_,
+			[&](std::size_t first, std::size_t last, std::size_t thread) {
+				PTGN_FRAME_SCOPE("RenderData::RecordDrawables");
+				recording_buffer = &recording_buffers_[thread];
+				for (std::size_t i{ first }; i < last; ++i) {
+					InvokeDrawable(run[i]);
+				}
+				recording_buffer = nullptr;
+			}
+		);
+
+		// Each thread records a single contiguous chunk of the run, so appending the buffers in
+		// thread order keeps the draw order.
+		for (auto& buffer : recording_buffers_) {
+			commands_.Append(buffer);
+			buffer.Clear();
+		}
+	}
+}
+
+void RenderData::SetRecordingThreadCount(std::size_t thread_count) {
+	recording_buffers_.clear();
+	if (thread_count == 1) {
+		recording_pool_.reset();
+		return;
+	}
+	recording_pool_ = std::make_unique<ThreadPool>(thread_count);
+	if (recording_pool_->GetThreadCount() == 1) {
+		recording_pool_.reset();
+	}
+}
+
+std::size_t RenderData::GetRecordingThreadCount() const {
+	return recording_pool_ ? recording_pool_->GetThreadCount() : 1;
+}
+
 void RenderData::InvokeDrawFilter(RenderTarget& render_target, FilterType type) {
 	if (!render_target.Has<IDrawFilter>()) {
 		return;
@@ -1173,27 +2089,15 @@ void RenderData::InvokeDrawFilter(RenderTarget& render_target, FilterType type)
 }
 
 void RenderData::FlushDrawQueue(TextureId id, bool draw_debug) {
-	auto it{ draw_queues_.find(id) };
-
-	if (it != draw_queues_.end()) {
-		std::vector<impl::DrawCommand>& commands{ it->second };
-
-		for (const auto& command : commands) {
-			DrawCommand(command);
-		}
-	}
-
-	if (draw_debug) {
-		for (const auto& command : debug_queue_) {
-			DrawCommand(command);
-		}
-	}
+	commands_.ForEach(id, draw_debug, [&](CommandType type, std::uint32_t index) {
+		DrawCommand(type, index);
+	});
 
 	Flush(true);
 }
 
 void RenderData::DrawDisplayList(
-	RenderTarget& render_target, std::vector<Entity>& display_list,
+	RenderTarget& render_target, const std::vector<Entity>& display_list,
 	const std::function<bool(const Entity&)>& filter, bool draw_debug
 ) {
 	Camera camera{ render_target.GetCamera() };
@@ -1215,18 +2119,34 @@ void RenderData::DrawDisplayList(
 	drawing_to_.tint		 = GetTint(render_target);
 	drawing_to_.frame_buffer = &render_target.GetFrameBuffer();
 
+	// Entities outside of the camera view are dropped before sorting so that neither sorting nor
+	// drawing scales with the size of the display list.
+	visible_entities_.clear();
+	if (render_target.Has<DisplayList>()) {
+		render_target.GetImpl<DisplayList>().culler.Cull(display_list, camera, visible_entities_);
+	} else {
+		visible_entities_ = display_list;
+	}
+
 	// Must be sorted here so that depth and creation order is accounted for.
-	SortByDepth(display_list, true);
+	SortByDepth(visible_entities_, true);
 
 	InvokeDrawFilter(render_target, FilterType::Pre);
 
-	for (const auto& entity : display_list) {
+	drawn_entities_.clear();
+	for (const auto& entity : visible_entities_) {
 		if (filter && filter(entity)) {
 			continue;
 		}
-		InvokeDrawable(entity);
+		// Static batch members are drawn by their batch.
+		if (IsStaticBatchMember(entity)) {
+			continue;
+		}
+		drawn_entities_.emplace_back(entity);
 	}
 
+	RecordDrawables(drawn_entities_);
+
 	InvokeDrawFilter(render_target, FilterType::Post);
 
 	FlushDrawQueue(drawing_to_.texture_id, draw_debug);
@@ -1408,8 +2328,7 @@ void RenderData::DrawScreenTarget() {
 }
 
 void RenderData::Draw(Scene& scene) {
-	// PTGN_LOG(draw_context_pool.contexts_.size());
-	// PTGN_PROFILE_FUNCTION();
+	PTGN_FRAME_SCOPE("RenderData::Draw");
 
 	white_texture.Bind(0);
 
@@ -1436,13 +2355,17 @@ void RenderData::Draw(Scene& scene) {
 		color::Transparent, GetBlendMode(scene.render_target_), viewport, projection
 	);
 
-	draw_queues_.clear();
-	debug_queue_.clear();
+	commands_.Clear();
 
 	Reset();
 
 	render_state	   = {};
 	temporary_textures = std::vector<Texture>{};
+
+	// Glyphs of evicted faces can only be freed once no command samples them.
+	if (auto* glyph_atlas{ game.font.GetGlyphAtlas() }; glyph_atlas != nullptr) {
+		glyph_atlas->ReleaseEvictedFaces();
+	}
 }
 
 } // namespace impl
@@ -1,13 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <span>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -19,6 +22,7 @@
 #include "core/ecs/entity.h"
 #include "core/scripting/script.h"
 #include "core/scripting/script_interfaces.h"
+#include "core/utils/thread_pool.h"
 #include "core/utils/time.h"
 #include "core/utils/timer.h"
 #include "math/geometry/shape.h"
@@ -82,13 +86,25 @@ constexpr std::size_t index_capacity{ batch_capacity * 6 };
 
 using UniformCallback = void (*)(Entity, const Shader&);
 
+// Returns the world space quad which a shader pass covers for the given entity.
+using InstanceCallback = QuadInstance (*)(Entity);
+
 class ShaderPass {
 public:
 	ShaderPass() = default;
 
-	ShaderPass(const Shader& shader, const UniformCallback& uniform_callback = nullptr);
+	// @param instance_callback If set, the shader is expected to use the quad_instanced vertex
+	// shader. Each call of the pass is then drawn as the instance returned by the callback instead
+	// of a full screen quad, so consecutive calls are drawn together in a single draw call.
+	ShaderPass(
+		const Shader& shader, const UniformCallback& uniform_callback = nullptr,
+		InstanceCallback instance_callback = nullptr
+	);
 
-	ShaderPass(std::string_view shader_name, const UniformCallback& uniform_callback = nullptr);
+	ShaderPass(
+		std::string_view shader_name, const UniformCallback& uniform_callback = nullptr,
+		InstanceCallback instance_callback = nullptr
+	);
 
 	ShaderPass(const char* shader_name);
 
@@ -96,11 +112,19 @@ public:
 
 	void Invoke(Entity entity) const;
 
+	// @return True if calls of the shader pass are drawn as instances.
+	[[nodiscard]] bool IsInstanced() const;
+
+	[[nodiscard]] QuadInstance GetInstance(Entity entity) const;
+
+	[[nodiscard]] std::size_t GetHash() const;
+
 	bool operator==(const ShaderPass&) const = default;
 
 private:
 	const Shader* shader_{ nullptr };
 	UniformCallback uniform_callback_{ nullptr };
+	InstanceCallback instance_callback_{ nullptr };
 };
 
 class RenderState {
@@ -116,6 +140,8 @@ public:
 	// specified).
 	[[nodiscard]] bool IsSet() const;
 
+	[[nodiscard]] std::size_t GetHash() const;
+
 	bool operator==(const RenderState&) const = default;
 
 	// std::nullopt = reset RenderState; ShaderPass{} == Quad shader.
@@ -229,35 +255,300 @@ struct DrawShaderCommand {
 	RenderState render_state;
 };
 
-struct EnableStencilMask {};
+struct DrawStaticBatchCommand {
+	// Entity with the StaticBatch drawable.
+	Entity batch;
+	Depth depth;
+	RenderState render_state;
+};
+
+enum class CommandType : std::uint8_t {
+	Shape,
+	Lines,
+	Texture,
+	Shader,
+	StaticBatch,
+	EnableStencilMask,
+	DisableStencilMask,
+	DrawInsideStencilMask,
+	DrawOutsideStencilMask
+};
+
+// Range of the point arena of a command buffer.
+struct PointRange {
+	std::uint32_t offset{ 0 };
+	std::uint32_t count{ 0 };
+};
+
+// Commands as stored inside the command buffer. Render states are replaced by indices into the
+// interned render states of the command buffer and variable length data, such as line points and
+// polygon vertices, by ranges of its point arena, so that stored commands do not own any heap
+// memory.
+struct ShapeCommand {
+	// Polygons are stored without vertices, see points.
+	Shape shape;
+	Transform transform;
+	Depth depth;
+	Tint tint;
+	LineWidth line_width;
+	Origin origin{ default_origin };
+	PointRange points;
+	std::uint32_t render_state{ 0 };
+};
+
+struct LinesCommand {
+	PointRange points;
+	bool connect_last_to_first{ false };
+	Transform transform;
+	Depth depth;
+	Tint tint;
+	LineWidth line_width;
+	std::uint32_t render_state{ 0 };
+};
+
+// The world vertices of the quad are computed when the command is added, so that threads
+// recording into their own command buffers also generate the quad geometry in parallel.
+struct TextureCommand {
+	constexpr static std::uint32_t no_pre_fx{ std::numeric_limits<std::uint32_t>::max() };
 
-struct DisableStencilMask {};
+	TextureId texture_id{ 0 };
+	V2_int texture_size;
+	TextureFormat texture_format{ default_texture_format };
+	std::array<V2_float, 4> points;
+	std::array<V2_float, 4> texture_coordinates{ GetDefaultTextureCoordinates() };
+	Depth depth;
+	Tint tint;
+	std::uint32_t pre_fx{ no_pre_fx };
+	std::uint32_t render_state{ 0 };
+};
 
-struct DrawOutsideStencilMask {};
+struct ShaderCommand {
+	BlendMode intermediate_blend_mode{ default_blend_mode };
+	std::optional<BlendMode> target_blend_mode{ std::nullopt };
+	bool clear_between_consecutive_calls{ true };
+	TextureFormat texture_format{ default_texture_format };
+	TextureOrSize texture_or_size{ V2_int{} };
+	Color target_clear_color{ color::Transparent };
+	Depth depth;
+	Entity entity;
+	std::uint32_t render_state{ 0 };
+};
 
-struct DrawInsideStencilMask {};
+struct StaticBatchCommand {
+	Entity batch;
+	Depth depth;
+	std::uint32_t render_state{ 0 };
+};
+
+// @return Mask of a sort key field of bits width starting at bit shift.
+constexpr std::uint64_t GetSortKeyMask(std::uint32_t bits, std::uint32_t shift) {
+	return ((std::uint64_t{ 1 } << bits) - 1) << shift;
+}
+
+// Draw commands of a frame, stored by type in arenas which keep their capacity between frames.
+// Every command is referenced by a 64 bit sort key of
+// [debug : 1][render target slot : 7][segment : 14][depth : 16][order : 8][render state : 10]
+// [texture : 8]. Entries are appended in submission order and sorted by a stable radix sort, so
+// commands with equal keys keep their submission order.
+//
+// Commands of a render target are drawn by ascending depth. Commands of equal depth are drawn by
+// their order within the drawable that submitted them, which only advances when the render state
+// or texture changes, and otherwise grouped by render state and texture to minimize state changes
+// and batch flushes. Overlapping drawables which must be drawn in a specific order should
+// therefore use different depths. Stencil mask commands start a new segment, which acts as a
+// barrier that no command is sorted across. Depths outside of the 16 bit range share the nearest
+// representable depth. Render state and texture ids beyond their bit width share the largest id,
+// which only reduces grouping.
+class CommandBuffer {
+public:
+	void Add(const DrawShapeCommand& command, TextureId target, bool debug);
+	void Add(const DrawLinesCommand& command, TextureId target, bool debug);
+	void Add(const DrawTextureCommand& command, TextureId target, bool debug);
+	void Add(const DrawShaderCommand& command, TextureId target, bool debug);
+	void Add(const DrawStaticBatchCommand& command, TextureId target, bool debug);
+
+	// For commands without any data, such as stencil mask commands.
+	void Add(CommandType type, TextureId target, bool debug);
+
+	// Marks the start of the commands of a new drawable. Commands of different drawables with
+	// equal depth may be grouped by render state.
+	void BeginDrawable();
+
+	// Adds every command of other after the commands of this buffer, keeping the submission order
+	// of other.
+	void Append(const CommandBuffer& other);
+
+	// Invokes func(type, index) in sort key order for every command submitted to target,
+	// followed by every debug command if draw_debug is true.
+	template <typename Func>
+	void ForEach(TextureId target, bool draw_debug, Func&& func) {
+		Sort();
+		std::uint64_t prefix{ 0 };
+		if (GetTargetSlot(target, prefix)) {
+			Visit(prefix, func);
+		}
+		if (draw_debug) {
+			Visit(debug_bit_, func);
+		}
+	}
+
+	// Shapes, shaders and static batches are returned with their render state and points
+	// restored.
+	[[nodiscard]] DrawShapeCommand GetShape(std::uint32_t index) const;
+	[[nodiscard]] const LinesCommand& GetLines(std::uint32_t index) const;
+	[[nodiscard]] const TextureCommand& GetTexture(std::uint32_t index) const;
+	[[nodiscard]] DrawShaderCommand GetShader(std::uint32_t index) const;
+	[[nodiscard]] DrawStaticBatchCommand GetStaticBatch(std::uint32_t index) const;
+
+	[[nodiscard]] const RenderState& GetRenderState(std::uint32_t render_state) const;
+
+	[[nodiscard]] std::span<const V2_float> GetPoints(const PointRange& range) const;
+
+	// @return Nullptr if the command has no pre fx.
+	[[nodiscard]] const PreFX* GetPreFX(const TextureCommand& command) const;
+
+	// Removes all commands while keeping the capacity of the arenas.
+	void Clear();
+
+private:
+	constexpr static std::uint32_t texture_bits_{ 8 };
+	constexpr static std::uint32_t render_state_bits_{ 10 };
+	constexpr static std::uint32_t order_bits_{ 8 };
+	constexpr static std::uint32_t depth_bits_{ 16 };
+	constexpr static std::uint32_t segment_bits_{ 14 };
+	constexpr static std::uint32_t target_bits_{ 7 };
+
+	constexpr static std::uint32_t render_state_shift_{ texture_bits_ };
+	constexpr static std::uint32_t order_shift_{ render_state_shift_ + render_state_bits_ };
+	constexpr static std::uint32_t depth_shift_{ order_shift_ + order_bits_ };
+	constexpr static std::uint32_t segment_shift_{ depth_shift_ + depth_bits_ };
+	constexpr static std::uint32_t target_shift_{ segment_shift_ + segment_bits_ };
+
+	static_assert(target_shift_ + target_bits_ == 63);
+
+	constexpr static std::uint64_t debug_bit_{ std::uint64_t{ 1 } << 63 };
+	constexpr static std::uint64_t target_mask_{ GetSortKeyMask(target_bits_, target_shift_) };
+	constexpr static std::uint64_t segment_mask_{ GetSortKeyMask(segment_bits_, segment_shift_) };
+	constexpr static std::uint64_t depth_mask_{ GetSortKeyMask(depth_bits_, depth_shift_) };
+	constexpr static std::uint64_t order_mask_{ GetSortKeyMask(order_bits_, order_shift_) };
+	constexpr static std::uint64_t prefix_mask_{ debug_bit_ | target_mask_ };
+
+	struct Entry {
+		std::uint64_t key{ 0 };
+		std::uint32_t index{ 0 };
+		CommandType type{ CommandType::Shape };
+	};
+
+	// @return Index of the render state in render_states_.
+	[[nodiscard]] std::uint32_t InternRenderState(const RenderState& render_state);
+
+	// @return Sort key bits of the render state and texture.
+	[[nodiscard]] std::uint64_t GetStateBits(std::uint32_t render_state, TextureId texture);
+
+	[[nodiscard]] std::uint64_t GetTargetBits(TextureId target);
+
+	[[nodiscard]] PointRange AddPoints(std::span<const V2_float> points);
+
+	void Push(
+		CommandType type, std::uint32_t index, TextureId target, bool debug, Depth depth,
+		std::uint64_t state
+	);
 
-using DrawCommand = std::variant<
-	DrawShapeCommand, DrawLinesCommand, DrawTextureCommand, DrawShaderCommand, EnableStencilMask,
-	DisableStencilMask, DrawInsideStencilMask, DrawOutsideStencilMask>;
+	// Starts a new segment, which no command is sorted across.
+	void BeginSegment();
+
+	// @param out_prefix Set to the key bits shared by all commands of the target.
+	// @return False if no commands were submitted to the target this frame.
+	[[nodiscard]] bool GetTargetSlot(TextureId target, std::uint64_t& out_prefix) const;
+
+	// Sorts entries_ by key if commands were added since the last sort.
+	void Sort();
+
+	template <typename Func>
+	void Visit(std::uint64_t prefix, Func& func) const {
+		auto first{ std::ranges::lower_bound(entries_, prefix, {}, &Entry::key) };
+		for (auto it{ first }; it != entries_.end() && (it->key & prefix_mask_) == prefix; ++it) {
+			func(it->type, it->index);
+		}
+	}
+
+	std::vector<Entry> entries_;
+
+	// Scratch buffer for radix sort passes. Kept to reuse its capacity.
+	std::vector<Entry> sort_buffer_;
+
+	// Render targets which received commands this frame, indexed by slot.
+	std::vector<TextureId> targets_;
+
+	std::vector<ShapeCommand> shapes_;
+	std::vector<LinesCommand> lines_;
+	std::vector<TextureCommand> textures_;
+	std::vector<ShaderCommand> shaders_;
+	std::vector<StaticBatchCommand> static_batches_;
+
+	// Every distinct render state of the frame is stored once and referenced by index.
+	std::vector<RenderState> render_states_;
+	std::unordered_multimap<std::size_t, std::uint32_t> render_state_lookup_;
+
+	// Textures which received commands this frame, indexed by their sort key id.
+	std::unordered_map<TextureId, std::uint32_t> texture_ids_;
+
+	std::vector<PreFX> pre_fx_;
+
+	// Shared arena of line points and polygon vertices.
+	std::vector<V2_float> points_;
+
+	std::uint32_t segment_{ 0 };
+	std::uint32_t order_{ 0 };
+
+	// Sort key state bits of the previous command of the current drawable.
+	std::optional<std::uint64_t> previous_state_;
+
+	bool sorted_{ true };
+};
 
 inline constexpr float min_line_width{ 1.0f };
 inline constexpr std::array<Index, 6> quad_indices{ 0, 1, 2, 2, 3, 0 };
 inline constexpr std::array<Index, 3> triangle_indices{ 0, 1, 2 };
+// Unit quad corners in the same order as quad points, expanded by the instanced shaders.
+inline constexpr std::array<glsl::vec2, 4> quad_corners{
+	glsl::vec2{ 0.0f, 0.0f }, glsl::vec2{ 1.0f, 0.0f }, glsl::vec2{ 1.0f, 1.0f },
+	glsl::vec2{ 0.0f, 1.0f }
+};
 
 class RenderData {
 public:
-	void Submit(const DrawCommand& command, bool debug = false);
+	void Submit(const DrawShapeCommand& command, bool debug = false);
+	void Submit(const DrawLinesCommand& command, bool debug = false);
+	void Submit(const DrawTextureCommand& command, bool debug = false);
+	void Submit(const DrawShaderCommand& command, bool debug = false);
+	void Submit(const DrawStaticBatchCommand& command, bool debug = false);
+	void Submit(CommandType type, bool debug = false);
+
+	// @return Render target which submitted commands are drawn to.
+	[[nodiscard]] TextureId GetSubmitTarget() const;
 
 	void AddTemporaryTexture(Texture&& texture);
 
 	[[nodiscard]] std::size_t GetMaxTextureSlots() const;
 
-	void DrawCommand(const impl::DrawCommand& cmd);
-	void DrawLines(const DrawLinesCommand& cmd);
-	void DrawTexture(const DrawTextureCommand& cmd);
+	// Draws the command stored at index of the command buffer arena of the given type.
+	void DrawCommand(CommandType type, std::uint32_t index);
+	void DrawShape(const DrawShapeCommand& cmd);
+	void DrawLines(const LinesCommand& cmd);
+	void DrawTexture(const TextureCommand& cmd);
 	void DrawShader(const DrawShaderCommand& cmd);
 
+	// Adds the instance of an instanced shader pass to the intermediate target. Consecutive
+	// instances with the same render state share the intermediate target and are drawn together.
+	void DrawShaderInstance(const DrawShaderCommand& cmd);
+
+	// Draws the pending shader pass instances to the intermediate target.
+	void DrawShaderInstances(const Viewport& viewport, const Matrix4& view_projection);
+
+	// Draws the baked segments of a static batch on top of everything submitted before it.
+	void DrawStaticBatch(const DrawStaticBatchCommand& cmd);
+
 	void AddLinesImpl(
 		std::span<Vertex> line_vertices, std::span<const Index> line_indices,
 		std::span<const V2_float> points, float line_width, const Transform& transform
@@ -265,7 +556,37 @@ public:
 
 	void AddVertices(std::span<const Vertex> point_vertices, std::span<const Index> point_indices);
 
-	static void InvokeDrawable(const Entity& entity);
+	// Adds a quad to the batch, as an instance if the current shader has an instanced variant.
+	void AddQuad(
+		const std::array<V2_float, 4>& quad_points, const Color& color, const Depth& depth,
+		const std::array<float, 4>& data, const std::array<V2_float, 4>& texture_coordinates
+	);
+
+	// Flushes the batch if it cannot fit another quad, or if it holds quads of the other kind
+	// (instances or vertices). Flushing clears the batch textures, so this must be called before a
+	// texture index is chosen for the quad.
+	void ReserveQuad(bool instanced);
+
+	// @return Instanced variant of the current shader, or nullptr if there is none or instancing
+	// is disabled.
+	[[nodiscard]] const Shader* GetInstancedShader() const;
+
+	void InvokeDrawable(const Entity& entity);
+
+	// Invokes the drawables of entities in order. With a recording thread pool, long runs of
+	// consecutive concurrent drawables are recorded in parallel into per thread command buffers,
+	// which are then appended to commands_ in draw order. Textured quads are transformed into
+	// world space while recording, whereas shapes are tessellated when the commands are drawn.
+	void RecordDrawables(const std::vector<Entity>& entities);
+
+	// Sets the number of threads which record the draw commands of display lists. 0 uses the
+	// hardware concurrency.
+	void SetRecordingThreadCount(std::size_t thread_count);
+	[[nodiscard]] std::size_t GetRecordingThreadCount() const;
+
+	// @return Command buffer which the calling thread submits draw commands to.
+	[[nodiscard]] CommandBuffer& GetRecordingBuffer();
+
 	static void InvokeDrawFilter(RenderTarget& render_target, FilterType type);
 
 	/*
@@ -322,9 +643,56 @@ public:
 		const Viewport& viewport, const Matrix4& view_projection
 	);
 
+	// Same as DrawCall but uploads vertex_count vertices of vertex_size bytes, which must match the
+	// layout of the current vertex format.
+	void DrawVertices(
+		const Shader& shader, const void* vertices, std::size_t vertex_count,
+		std::size_t vertex_size, std::span<const Index> indices,
+		const std::vector<TextureId>& textures, const FrameBuffer* frame_buffer,
+		bool clear_frame_buffer, const Color& clear_color, BlendMode blend_mode,
+		const Viewport& viewport, const Matrix4& view_projection
+	);
+
+	// Same as DrawCall but draws the first index_count indices of an existing vertex array
+	// instead of uploading new vertex and index data.
+	void DrawVertexArray(
+		const Shader& shader, const VertexArray& vertex_array, std::size_t index_count,
+		const std::vector<TextureId>& textures, const FrameBuffer* frame_buffer,
+		bool clear_frame_buffer, const Color& clear_color, BlendMode blend_mode,
+		const Viewport& viewport, const Matrix4& view_projection
+	);
+
+	// Same as DrawCall but draws one quad for each instance.
+	void DrawInstances(
+		const Shader& shader, std::span<const QuadInstance> instances,
+		const std::vector<TextureId>& textures, const FrameBuffer* frame_buffer,
+		bool clear_frame_buffer, const Color& clear_color, BlendMode blend_mode,
+		const Viewport& viewport, const Matrix4& view_projection
+	);
+
+	// Binds the frame buffer, shader, textures and vertex array of a draw call.
+	void PrepareDrawCall(
+		const Shader& shader, const VertexArray& vertex_array,
+		const std::vector<TextureId>& textures, const FrameBuffer* frame_buffer,
+		bool clear_frame_buffer, const Color& clear_color, BlendMode blend_mode,
+		const Viewport& viewport, const Matrix4& view_projection
+	);
+
+	// Draws the vertices or instances of the current batch using the current render state.
+	void DrawBatch(
+		const FrameBuffer* frame_buffer, bool clear_frame_buffer, BlendMode blend_mode,
+		const Viewport& viewport, const Matrix4& view_projection
+	);
+
 	void Reset();
 
-	void Init();
+	// @return Number of vertices in the current batch, in either vertex format.
+	[[nodiscard]] std::size_t GetVertexCount() const;
+
+	void Init(VertexFormat format = VertexFormat::Standard);
+
+	// Recreates the batch vertex array for vertices of the given format.
+	void SetVertexFormat(VertexFormat format);
 
 	[[nodiscard]] const Shader& GetCurrentShader() const;
 
@@ -344,7 +712,7 @@ public:
 
 	// @param filter If function returns true, the entity is not drawn.
 	void DrawDisplayList(
-		RenderTarget& render_target, std::vector<Entity>& display_list,
+		RenderTarget& render_target, const std::vector<Entity>& display_list,
 		const std::function<bool(const Entity&)>& filter = {}, bool draw_debug = false
 	);
 
@@ -360,8 +728,7 @@ public:
 
 	static const Shader& GetFullscreenShader(TextureFormat texture_format);
 
-	std::vector<impl::DrawCommand> debug_queue_;
-	std::unordered_map<TextureId, std::vector<impl::DrawCommand>> draw_queues_;
+	CommandBuffer commands_;
 
 	std::shared_ptr<DrawContext> intermediate_target;
 
@@ -390,14 +757,47 @@ public:
 	DrawContextPool draw_context_pool{ seconds{ 1 } };
 	Manager render_manager;
 	RenderState render_state;
+	// Vertices of the current batch when the standard vertex format is used.
 	std::vector<Vertex> vertices_;
 	std::vector<Index> indices_;
+	VertexFormat vertex_format_{ VertexFormat::Standard };
+	// Vertices of the current batch when the packed vertex format is used. Vertices are packed as
+	// they are added, so the batch never holds full vertices in this format.
+	std::vector<PackedVertex> packed_vertices_;
+	// Vertices of unbatched draw calls packed for upload. Kept to reuse its capacity.
+	std::vector<PackedVertex> packed_scratch_;
+	// Quads of the current batch when it is drawn instanced. Only one of instances_ and the batch
+	// vertices is used at a time.
+	std::vector<QuadInstance> instances_;
+	// If true, quads drawn with the quad, circle, capsule, rounded rect and arc shaders are
+	// batched as instances.
+	bool instancing_enabled{ true };
+	// If true, point lights without ambient light or post fx are drawn as instanced quads
+	// bounded by their radius instead of as one full screen pass each.
+	bool light_batching_enabled{ true };
+	// How pending shader pass instances are blended to and cleared from the intermediate target.
+	BlendMode shader_instance_blend_mode_{ default_blend_mode };
+	Color shader_instance_clear_color_{ color::Transparent };
+	// Intermediate target must be cleared by the next draw of shader pass instances.
+	bool clear_shader_instances_{ false };
+	// Batched shaders and their instanced variants.
+	std::array<std::pair<const Shader*, const Shader*>, 5> instanced_shaders_{};
 	std::vector<TextureId> textures_;
+	// Display list entities which passed culling, in draw order. Kept to reuse its capacity.
+	std::vector<Entity> visible_entities_;
+	// Visible entities which are drawn by their own drawable. Kept to reuse its capacity.
+	std::vector<Entity> drawn_entities_;
+	// Null if draw commands are recorded on the calling thread only.
+	std::unique_ptr<ThreadPool> recording_pool_;
+	// Draw commands recorded by each thread of the recording pool.
+	std::vector<CommandBuffer> recording_buffers_;
+	constexpr static std::size_t min_entities_per_thread_{ 256 };
 	Index index_offset_{ 0 };
 	// Cached variable.
 	mutable std::size_t max_texture_slots{ 0 };
 	Texture white_texture;
 	VertexArray triangle_vao;
+	VertexArray instanced_vao;
 };
 
 } // namespace impl
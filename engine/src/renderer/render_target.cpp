@@ -139,13 +139,14 @@ void RenderTarget::ClearToColor(const Color& color) const {
 
 void RenderTarget::ClearDisplayList() {
 	PTGN_ASSERT(Has<impl::DisplayList>());
-	auto& display_list{ Get<impl::DisplayList>().entities };
-	for (Entity entity : display_list) {
+	auto& display_list{ Get<impl::DisplayList>() };
+	for (Entity entity : display_list.entities) {
 		if (entity) {
 			entity.Remove<RenderTarget>();
 		}
 	}
-	display_list.clear();
+	display_list.entities.clear();
+	display_list.culler.Clear();
 }
 
 void RenderTarget::AddToDisplayList(Entity entity) {
@@ -158,8 +159,9 @@ void RenderTarget::AddToDisplayList(Entity entity) {
 		"render order of targets is not enforced. Perhaps in the future."
 	);
 	PTGN_ASSERT(Has<impl::DisplayList>());
-	auto& dl{ Get<impl::DisplayList>().entities };
-	dl.emplace_back(entity);
+	auto& dl{ Get<impl::DisplayList>() };
+	dl.entities.emplace_back(entity);
+	dl.culler.Add(entity);
 	entity.Add<RenderTarget>(*this);
 }
 
@@ -168,8 +170,9 @@ void RenderTarget::RemoveFromDisplayList(Entity entity) {
 	PTGN_ASSERT(HasDraw(entity), "Entity remove from render target display list must be drawable");
 	entity.Remove<RenderTarget>();
 	PTGN_ASSERT(Has<impl::DisplayList>());
-	auto& dl{ Get<impl::DisplayList>().entities };
-	std::erase(dl, entity);
+	auto& dl{ Get<impl::DisplayList>() };
+	std::erase(dl.entities, entity);
+	dl.culler.Remove(entity);
 }
 
 const std::vector<Entity>& RenderTarget::GetDisplayList() const {
@@ -182,6 +185,16 @@ std::vector<Entity>& RenderTarget::GetDisplayList() {
 	return Get<impl::DisplayList>().entities;
 }
 
+void RenderTarget::SetCulling(bool enabled) {
+	PTGN_ASSERT(Has<impl::DisplayList>());
+	Get<impl::DisplayList>().culler.SetEnabled(enabled);
+}
+
+bool RenderTarget::IsCulling() const {
+	PTGN_ASSERT(Has<impl::DisplayList>());
+	return Get<impl::DisplayList>().culler.IsEnabled();
+}
+
 Color RenderTarget::GetClearColor() const {
 	return GetOrDefault<impl::ClearColor>();
 }
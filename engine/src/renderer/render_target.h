@@ -16,6 +16,7 @@
 #include "math/vector2.h"
 #include "renderer/api/color.h"
 #include "renderer/buffers/frame_buffer.h"
+#include "renderer/culling.h"
 #include "renderer/materials/texture.h"
 #include "serialization/json/serializable.h"
 
@@ -47,6 +48,7 @@ RenderTarget AddRenderTargetComponents(
 
 struct DisplayList {
 	std::vector<Entity> entities;
+	DisplayListCuller culler;
 };
 
 struct ClearColor : public ColorComponent {
@@ -153,6 +155,14 @@ public:
 
 	[[nodiscard]] std::vector<Entity>& GetDisplayList();
 
+	// If enabled, display list entities which lie outside of the render target camera view are
+	// not drawn. Disabled by default, since off-screen drawables whose size changes without
+	// moving keep their old bounds until they move, which may prevent them from being drawn once
+	// they grow into view.
+	void SetCulling(bool enabled = true);
+
+	[[nodiscard]] bool IsCulling() const;
+
 	// @return The clear color of the render target.
 	[[nodiscard]] Color GetClearColor() const;
 
@@ -33,12 +33,15 @@
 #include "renderer/api/color.h"
 #include "renderer/api/origin.h"
 #include "renderer/buffers/frame_buffer.h"
+#include "renderer/gl/gl_context.h"
 #include "renderer/gl/gl_renderer.h"
 #include "renderer/materials/shader.h"
 #include "renderer/materials/texture.h"
+#include "renderer/materials/texture_atlas.h"
 #include "renderer/render_data.h"
 #include "renderer/render_target.h"
 #include "renderer/text/font.h"
+#include "renderer/text/glyph_atlas.h"
 #include "renderer/text/text.h"
 #include "world/scene/camera.h"
 #include "world/scene/scene.h"
@@ -71,6 +74,14 @@ void Renderer::DrawTexture(
 	cmd.render_state.camera		= camera;
 	cmd.render_state.post_fx	= post_fx;
 
+	// Pre fx are applied to the source texture, so such textures cannot be drawn from the atlas.
+	if (pre_fx.pre_fx_.empty()) {
+		if (const auto* region{ game.texture.GetAtlasRegion(cmd.texture_id) }; region != nullptr) {
+			cmd.texture_id = region->page;
+			region->Remap(cmd.texture_coordinates);
+		}
+	}
+
 	render_data_.Submit(cmd);
 }
 
@@ -162,25 +173,43 @@ void Renderer::DrawShader(
 	render_data_.Submit(cmd);
 }
 
-impl::Texture Renderer::CreateTexture(
-	Transform& out_transform, V2_float& out_text_size, const TextContent& content,
-	const TextColor& color, const FontSize& font_size, const ResourceHandle& font_key,
-	const TextProperties& properties, bool hd_text, const Camera& camera
+void Renderer::DrawStaticBatch(
+	const Entity& batch, const Depth& depth, BlendMode blend_mode, const Camera& camera
 ) {
-	FontSize final_font_size{ font_size };
+	DrawStaticBatchCommand cmd;
 
-	if (hd_text) {
-		const auto& scene{ game.scene.GetCurrent() };
+	cmd.batch					= batch;
+	cmd.depth					= depth;
+	cmd.render_state.blend_mode = blend_mode;
+	cmd.render_state.camera		= camera;
 
-		auto render_target_scale{ scene.GetRenderTargetScaleRelativeTo(camera) };
+	render_data_.Submit(cmd);
+}
 
-		PTGN_ASSERT(render_target_scale.BothAboveZero());
+FontSize Renderer::GetTextFontSize(
+	Transform& out_transform, const FontSize& font_size, bool hd_text, const Camera& camera
+) {
+	if (!hd_text) {
+		return font_size;
+	}
 
-		out_transform.Scale(1.0f / render_target_scale);
+	const auto& scene{ game.scene.GetCurrent() };
 
-		final_font_size =
-			static_cast<std::int32_t>(static_cast<float>(font_size) * render_target_scale.y);
-	}
+	auto render_target_scale{ scene.GetRenderTargetScaleRelativeTo(camera) };
+
+	PTGN_ASSERT(render_target_scale.BothAboveZero());
+
+	out_transform.Scale(1.0f / render_target_scale);
+
+	return static_cast<std::int32_t>(static_cast<float>(font_size) * render_target_scale.y);
+}
+
+impl::Texture Renderer::CreateTexture(
+	Transform& out_transform, V2_float& out_text_size, const TextContent& content,
+	const TextColor& color, const FontSize& font_size, const ResourceHandle& font_key,
+	const TextProperties& properties, bool hd_text, const Camera& camera
+) {
+	FontSize final_font_size{ GetTextFontSize(out_transform, font_size, hd_text, camera) };
 
 	auto texture{ Text::CreateTexture(content, color, final_font_size, font_key, properties) };
 
@@ -198,6 +227,21 @@ void Renderer::DrawText(
 	const Camera& camera, const PreFX& pre_fx, const PostFX& post_fx,
 	const std::array<V2_float, 4>& texture_coordinates
 ) {
+	auto* glyph_atlas{ game.font.GetGlyphAtlas() };
+
+	// Glyph quads cannot be sampled by pre fx or custom texture coordinates.
+	if (glyph_atlas != nullptr && pre_fx.pre_fx_.empty() &&
+		texture_coordinates == GetDefaultTextureCoordinates()) {
+		auto final_font_size{ GetTextFontSize(transform, font_size, hd_text, camera) };
+		glyph_atlas->Layout(
+			text_layout_, content, color, final_font_size, font_key, properties, hd_text
+		);
+		DrawTextLayout(
+			text_layout_, transform, text_size, origin, tint, depth, blend_mode, camera, post_fx
+		);
+		return;
+	}
+
 	auto texture{ CreateTexture(
 		transform, text_size, content, color, font_size, font_key, properties, hd_text, camera
 	) };
@@ -210,6 +254,62 @@ void Renderer::DrawText(
 	render_data_.AddTemporaryTexture(std::move(texture));
 }
 
+void Renderer::DrawTextLayout(
+	const TextLayout& layout, const Transform& transform, V2_float text_size, Origin origin,
+	const Tint& tint, const Depth& depth, BlendMode blend_mode, const Camera& camera,
+	const PostFX& post_fx
+) {
+	V2_float layout_size{ layout.size };
+
+	if (!layout_size.BothAboveZero()) {
+		return;
+	}
+
+	if (!text_size.x) {
+		text_size.x = layout_size.x;
+	}
+	if (!text_size.y) {
+		text_size.y = layout_size.y;
+	}
+
+	// Glyphs are positioned relative to the center of the text, which is offset by the origin.
+	Transform text_transform{ transform };
+	text_transform.Translate(-GetOriginOffset(origin, text_size * Abs(transform.GetScale())));
+
+	V2_float glyph_scale{ text_size / layout_size };
+	V2_float half_size{ text_size * 0.5f };
+
+	auto tint_color{ tint.Normalized() };
+
+	if (layout.background.a != 0) {
+		DrawShape(
+			text_transform, Rect{ text_size }, Color{ layout.background.Normalized() * tint_color },
+			-1.0f, Origin::Center, depth, blend_mode, camera, post_fx
+		);
+	}
+
+	DrawTextureCommand cmd;
+
+	cmd.transform				= text_transform;
+	cmd.texture_format			= TextureFormat::RGBA8888;
+	cmd.origin					= Origin::Center;
+	cmd.depth					= depth;
+	cmd.render_state.blend_mode = blend_mode;
+	cmd.render_state.camera		= camera;
+	cmd.render_state.post_fx	= post_fx;
+
+	for (const auto& quad : layout.quads) {
+		V2_float min{ -half_size + quad.position * glyph_scale };
+
+		cmd.texture_id			= quad.page;
+		cmd.rect				= Rect{ min, min + quad.size * glyph_scale };
+		cmd.texture_coordinates = quad.texture_coordinates;
+		cmd.tint				= Color{ quad.color.Normalized() * tint_color };
+
+		render_data_.Submit(cmd);
+	}
+}
+
 void Renderer::DrawRect(
 	const Transform& transform, const Rect& rect, const Tint& color, const LineWidth& line_width,
 	Origin origin, const Depth& depth, BlendMode blend_mode, const Camera& camera,
@@ -311,19 +411,19 @@ void Renderer::DrawPoint(
 }
 
 void Renderer::EnableStencilMask() {
-	render_data_.Submit(impl::EnableStencilMask{});
+	render_data_.Submit(impl::CommandType::EnableStencilMask);
 }
 
 void Renderer::DisableStencilMask() {
-	render_data_.Submit(impl::DisableStencilMask{});
+	render_data_.Submit(impl::CommandType::DisableStencilMask);
 }
 
 void Renderer::DrawOutsideStencilMask() {
-	render_data_.Submit(impl::DrawOutsideStencilMask{});
+	render_data_.Submit(impl::CommandType::DrawOutsideStencilMask);
 }
 
 void Renderer::DrawInsideStencilMask() {
-	render_data_.Submit(impl::DrawInsideStencilMask{});
+	render_data_.Submit(impl::CommandType::DrawInsideStencilMask);
 }
 
 void Renderer::Init() {
@@ -343,12 +443,16 @@ void Renderer::Reset() {
 
 	FrameBuffer::Unbind(); // Will set bound_frame_buffer_id_ to 0.
 
+	auto vertex_format{ render_data_.vertex_format_ };
+	auto recording_pool{ std::move(render_data_.recording_pool_) };
 	render_data_ = {};
-	render_data_.Init();
+	render_data_.Init(vertex_format);
+	render_data_.recording_pool_ = std::move(recording_pool);
 }
 
 void Renderer::Shutdown() {
 	Reset();
+	render_data_.SetRecordingThreadCount(1);
 }
 
 void Renderer::SetScalingMode(ScalingMode scaling_mode) {
@@ -383,6 +487,46 @@ ScalingMode Renderer::GetScalingMode() const {
 	return render_data_.resolution_mode_;
 }
 
+void Renderer::EnableInstancing() {
+	render_data_.instancing_enabled = true;
+}
+
+void Renderer::DisableInstancing() {
+	render_data_.instancing_enabled = false;
+}
+
+bool Renderer::IsInstancingEnabled() const {
+	return render_data_.instancing_enabled;
+}
+
+void Renderer::EnableLightBatching() {
+	render_data_.light_batching_enabled = true;
+}
+
+void Renderer::DisableLightBatching() {
+	render_data_.light_batching_enabled = false;
+}
+
+bool Renderer::IsLightBatchingEnabled() const {
+	return render_data_.light_batching_enabled;
+}
+
+void Renderer::SetVertexFormat(VertexFormat format) {
+	render_data_.SetVertexFormat(format);
+}
+
+VertexFormat Renderer::GetVertexFormat() const {
+	return render_data_.vertex_format_;
+}
+
+void Renderer::SetRecordingThreadCount(std::size_t thread_count) {
+	render_data_.SetRecordingThreadCount(thread_count);
+}
+
+std::size_t Renderer::GetRecordingThreadCount() const {
+	return render_data_.GetRecordingThreadCount();
+}
+
 void Renderer::PresentScreen() {
 	FrameBuffer::Unbind();
 
@@ -405,7 +549,9 @@ void Renderer::PresentScreen() {
 		"Frame buffer must be unbound (id=0) before swapping SDL2 buffer to the screen"
 	);
 
-	game.window.SwapBuffers();
+	if (!GLContext::IsNull()) {
+		game.window.SwapBuffers();
+	}
 }
 
 void Renderer::ClearScreen() const {
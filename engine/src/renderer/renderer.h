@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -14,9 +15,11 @@
 #include "renderer/api/blend_mode.h"
 #include "renderer/api/color.h"
 #include "renderer/api/origin.h"
+#include "renderer/api/vertex.h"
 #include "renderer/materials/texture.h"
 #include "renderer/render_data.h"
 #include "renderer/text/font.h"
+#include "renderer/text/glyph_atlas.h"
 #include "renderer/text/text.h"
 #include "world/scene/camera.h"
 
@@ -81,6 +84,33 @@ public:
 	// @return The game size scaling mode.
 	[[nodiscard]] ScalingMode GetScalingMode() const;
 
+	// Instancing draws quads, circles, capsules, rounded rects and arcs using the default shaders
+	// as compact per-instance records which are expanded on the GPU. Enabled by default.
+	void EnableInstancing();
+	void DisableInstancing();
+	[[nodiscard]] bool IsInstancingEnabled() const;
+
+	// Light batching draws consecutive point lights as quads bounded by their radius, which are
+	// accumulated in a single draw call instead of one full screen pass per light. Lights with
+	// ambient light or post fx are always drawn as full screen passes. Enabled by default.
+	void EnableLightBatching();
+	void DisableLightBatching();
+	[[nodiscard]] bool IsLightBatchingEnabled() const;
+
+	// Sets the layout of the vertices uploaded by the batch renderer. See VertexFormat. Must not be
+	// called while a batch is being recorded.
+	void SetVertexFormat(VertexFormat format);
+	[[nodiscard]] VertexFormat GetVertexFormat() const;
+
+	// Sets the number of threads which record the draw commands of display lists. Only sprites and
+	// shapes are recorded in parallel, other drawables are always invoked on the calling thread.
+	// Recording threads also compute the world vertices of sprites, while shapes are tessellated
+	// and all vertices are batched and uploaded on the calling thread. The draw order does not
+	// depend on the thread count. 0 uses the hardware concurrency.
+	// Default: 1.
+	void SetRecordingThreadCount(std::size_t thread_count);
+	[[nodiscard]] std::size_t GetRecordingThreadCount() const;
+
 	void DrawTexture(
 		const impl::Texture& texture, const Transform& transform, const V2_float& texture_size = {},
 		Origin origin = default_origin, const Tint& tint = {}, const Depth& depth = {},
@@ -129,6 +159,12 @@ public:
 		std::optional<BlendMode> target_blend_mode = std::nullopt
 	);
 
+	// @param batch Entity with the StaticBatch drawable whose baked segments are drawn.
+	void DrawStaticBatch(
+		const Entity& batch, const Depth& depth = {}, BlendMode blend_mode = default_blend_mode,
+		const Camera& camera = {}
+	);
+
 	// @param text_size {} results in unscaled size of text based on font.
 	void DrawText(
 		const std::string& content, Transform transform, const TextColor& color,
@@ -140,6 +176,16 @@ public:
 		const std::array<V2_float, 4>& texture_coordinates = GetDefaultTextureCoordinates()
 	);
 
+	// Draws the glyph quads of a laid out text, see GlyphAtlas::Layout().
+	// @param text_size {} results in the size of the layout. Otherwise the glyphs are stretched
+	// to fit the text size.
+	void DrawTextLayout(
+		const TextLayout& layout, const Transform& transform, V2_float text_size = {},
+		Origin origin = default_origin, const Tint& tint = {}, const Depth& depth = {},
+		BlendMode blend_mode = default_blend_mode, const Camera& camera = {},
+		const PostFX& post_fx = {}
+	);
+
 	void DrawRect(
 		const Transform& transform, const Rect& rect, const Tint& color,
 		const LineWidth& line_width = {}, Origin origin = default_origin, const Depth& depth = {},
@@ -234,6 +280,11 @@ private:
 	friend class ShaderManager;
 	friend class DebugSystem;
 
+	// @return Font size of the text, scaled relative to the camera if hd_text is true.
+	[[nodiscard]] static FontSize GetTextFontSize(
+		Transform& out_transform, const FontSize& font_size, bool hd_text, const Camera& camera
+	);
+
 	[[nodiscard]] impl::Texture CreateTexture(
 		Transform& out_transform, V2_float& out_text_size, const TextContent& content,
 		const TextColor& color, const FontSize& font_size, const ResourceHandle& font_key,
@@ -264,6 +315,9 @@ private:
 	BoundStates bound_;
 
 	RenderData render_data_;
+
+	// Reused by DrawText() to lay out text from the glyph atlas.
+	TextLayout text_layout_;
 };
 
 } // namespace impl
@@ -0,0 +1,283 @@
+#include "renderer/static_batch.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+#include "core/app/game.h"
+#include "core/app/manager.h"
+#include "core/ecs/components/draw.h"
+#include "core/ecs/components/drawable.h"
+#include "core/ecs/components/effects.h"
+#include "core/ecs/components/sprite.h"
+#include "core/ecs/components/transform.h"
+#include "core/ecs/entity.h"
+#include "core/ecs/entity_hierarchy.h"
+#include "core/utils/type_info.h"
+#include "debug/runtime/assert.h"
+#include "math/geometry/rect.h"
+#include "math/hash.h"
+#include "math/vector2.h"
+#include "renderer/api/vertex.h"
+#include "renderer/buffers/buffer.h"
+#include "renderer/buffers/vertex_array.h"
+#include "renderer/gl/gl_renderer.h"
+#include "renderer/gl/gl_types.h"
+#include "renderer/materials/texture.h"
+#include "renderer/materials/texture_atlas.h"
+#include "renderer/render_data.h"
+#include "renderer/renderer.h"
+
+namespace ptgn {
+
+namespace impl {
+
+bool IsStaticBatchMember(const Entity& entity) {
+	const auto member{ entity.TryGet<StaticBatchMember>() };
+	return member != nullptr && member->batch.IsAlive() && member->batch.Has<StaticBatchData>();
+}
+
+// @return True if the world transform of the entity changed during the latest cache update.
+// Entities without a transform only move with their closest ancestor which has one.
+static bool HasMoved(const Entity& entity) {
+	if (entity.Has<Transform>()) {
+		return HasWorldTransformChanged(entity);
+	}
+	return HasParent(entity) && HasMoved(GetParent(entity));
+}
+
+// @return True if a member was destroyed, hidden, shown or moved since the batch was baked.
+static bool HasMemberChanged(const StaticBatchData& data) {
+	return std::ranges::any_of(data.members, [](const StaticBatchData::Member& member) {
+		return !member.entity.IsAlive() || IsVisible(member.entity) != member.visible ||
+			   HasMoved(member.entity);
+	});
+}
+
+static void AddSegment(
+	StaticBatchData& data, const std::vector<Vertex>& vertices, const std::vector<Index>& indices,
+	const std::vector<TextureId>& textures
+) {
+	if (indices.empty()) {
+		return;
+	}
+	auto& segment{ data.segments.emplace_back() };
+	segment.vertex_array = VertexArray{
+		PrimitiveMode::Triangles,
+		VertexBuffer{ vertices.data(), static_cast<std::uint32_t>(vertices.size()),
+					  static_cast<std::uint32_t>(sizeof(Vertex)), BufferUsage::StaticDraw },
+		Vertex::GetLayout(),
+		IndexBuffer{ indices.data(), static_cast<std::uint32_t>(indices.size()),
+					 static_cast<std::uint32_t>(sizeof(Index)), BufferUsage::StaticDraw }
+	};
+	segment.index_count = static_cast<std::uint32_t>(indices.size());
+	segment.textures	= textures;
+}
+
+// Generates the same quads as drawing each member sprite individually.
+static void Bake(StaticBatchData& data) {
+	data.segments.clear();
+	data.dirty = false;
+
+	std::erase_if(data.members, [](const StaticBatchData::Member& member) {
+		return !member.entity.IsAlive();
+	});
+
+	// Members overlap in the same order as when they are drawn individually.
+	std::ranges::sort(
+		data.members, EntityDepthCompare{},
+		[](const StaticBatchData::Member& member) -> const Entity& { return member.entity; }
+	);
+
+	// First texture slot is reserved for the white texture.
+	std::size_t max_textures{ GLRenderer::GetMaxTextureSlots() - 1 };
+
+	std::vector<Vertex> vertices;
+	std::vector<Index> indices;
+	std::vector<TextureId> textures;
+
+	for (auto& member : data.members) {
+		member.visible = IsVisible(member.entity);
+		if (!member.visible) {
+			continue;
+		}
+
+		Sprite sprite{ member.entity };
+
+		auto texture_id{ sprite.GetTexture().GetId() };
+		auto texture_coordinates{ sprite.GetTextureCoordinates(false) };
+
+		if (const auto* region{ game.texture.GetAtlasRegion(texture_id) }; region != nullptr) {
+			texture_id = region->page;
+			region->Remap(texture_coordinates);
+		}
+
+		Rect rect{ V2_float{ sprite.GetSize() } };
+		auto transform{ GetDrawTransform(member.entity) };
+
+		if (!rect.GetSize(transform).BothAboveZero()) {
+			continue;
+		}
+
+		auto it{ std::ranges::find(textures, texture_id) };
+		if (it == textures.end() && textures.size() == max_textures) {
+			AddSegment(data, vertices, indices, textures);
+			vertices.clear();
+			indices.clear();
+			textures.clear();
+			it = textures.end();
+		}
+		if (it == textures.end()) {
+			textures.emplace_back(texture_id);
+			it = std::prev(textures.end());
+		}
+
+		auto quad{ Vertex::GetQuad(
+			rect.GetWorldVertices(transform, GetDrawOrigin(member.entity)),
+			GetTint(member.entity), GetDepth(member.entity), { 0.0f }, texture_coordinates, false
+		) };
+
+		// Texture index 0 is the white texture.
+		Vertex::SetTextureIndex(quad, static_cast<float>(it - textures.begin() + 1));
+
+		auto offset{ static_cast<Index>(vertices.size()) };
+		vertices.insert(vertices.end(), quad.begin(), quad.end());
+		for (auto index : quad_indices) {
+			indices.emplace_back(offset + index);
+		}
+	}
+
+	AddSegment(data, vertices, indices, textures);
+}
+
+} // namespace impl
+
+StaticBatch::StaticBatch(const Entity& entity) : Entity{ entity } {}
+
+void StaticBatch::Draw(const Entity& entity) {
+	Entity batch{ entity };
+	auto& data{ batch.Get<impl::StaticBatchData>() };
+
+	if (data.dirty || impl::HasMemberChanged(data)) {
+		impl::Bake(data);
+	}
+
+	if (data.segments.empty()) {
+		return;
+	}
+
+	game.renderer.DrawStaticBatch(
+		entity, GetDepth(entity), GetBlendMode(entity), entity.GetOrDefault<Camera>()
+	);
+}
+
+StaticBatch& StaticBatch::AddMember(Entity entity) {
+	if (!CanBatch(entity)) {
+		return *this;
+	}
+
+	if (entity.Has<impl::StaticBatchMember>()) {
+		if (auto batch{ entity.Get<impl::StaticBatchMember>().batch }; batch != *this) {
+			StaticBatch{ batch }.RemoveMember(entity);
+		}
+	}
+
+	auto& data{ Get<impl::StaticBatchData>() };
+	if (std::ranges::find(data.members, entity, &impl::StaticBatchData::Member::entity) ==
+		data.members.end()) {
+		data.members.push_back({ entity, IsVisible(entity) });
+		data.dirty = true;
+	}
+
+	entity.TryAdd<impl::StaticBatchMember>().batch = *this;
+	return *this;
+}
+
+StaticBatch& StaticBatch::RemoveMember(Entity entity) {
+	auto& data{ Get<impl::StaticBatchData>() };
+	if (std::erase_if(data.members, [&](const impl::StaticBatchData::Member& member) {
+			return member.entity == entity;
+		}) > 0) {
+		data.dirty = true;
+	}
+
+	if (entity.IsAlive() && entity.Has<impl::StaticBatchMember>() &&
+		entity.Get<impl::StaticBatchMember>().batch == *this) {
+		entity.Remove<impl::StaticBatchMember>();
+	}
+	return *this;
+}
+
+void StaticBatch::ClearMembers() {
+	auto members{ Get<impl::StaticBatchData>().members };
+	for (const auto& member : members) {
+		RemoveMember(member.entity);
+	}
+}
+
+void StaticBatch::Invalidate() {
+	Get<impl::StaticBatchData>().dirty = true;
+}
+
+bool StaticBatch::CanBatch(const Entity& entity) {
+	if (!entity || !entity.Has<impl::IDrawable>() ||
+		entity.Get<impl::IDrawable>().hash != Hash(type_name<Sprite>())) {
+		return false;
+	}
+	if (entity.Has<PreFX>() && !entity.Get<PreFX>().pre_fx_.empty()) {
+		return false;
+	}
+	return !entity.Has<PostFX>() || entity.Get<PostFX>().post_fx_.empty();
+}
+
+std::size_t StaticBatch::GetMemberCount() const {
+	return Get<impl::StaticBatchData>().members.size();
+}
+
+StaticBatch CreateStaticBatch(Manager& manager, const std::vector<Entity>& entities) {
+	StaticBatch batch{ manager.CreateEntity() };
+	batch.Add<impl::StaticBatchData>();
+	SetDraw<StaticBatch>(batch);
+	Show(batch);
+	std::optional<Depth> depth;
+	for (const auto& entity : entities) {
+		if (!StaticBatch::CanBatch(entity)) {
+			continue;
+		}
+		batch.AddMember(entity);
+		auto member_depth{ GetDepth(entity) };
+		if (!depth || member_depth < *depth) {
+			depth = member_depth;
+		}
+	}
+	if (depth) {
+		SetDepth(batch, *depth);
+	}
+	return batch;
+}
+
+std::vector<StaticBatch> CreateStaticBatches(
+	Manager& manager, const std::vector<Entity>& entities
+) {
+	std::vector<Entity> members;
+	members.reserve(entities.size());
+	std::ranges::copy_if(entities, std::back_inserter(members), &StaticBatch::CanBatch);
+	SortByDepth(members);
+
+	std::vector<StaticBatch> batches;
+	auto first{ members.begin() };
+	while (first != members.end()) {
+		auto depth{ GetDepth(*first) };
+		auto last{ std::find_if(first, members.end(), [&](const Entity& entity) {
+			return GetDepth(entity) != depth;
+		}) };
+		batches.emplace_back(CreateStaticBatch(manager, std::vector<Entity>{ first, last }));
+		first = last;
+	}
+	return batches;
+}
+
+} // namespace ptgn
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "core/ecs/components/drawable.h"
+#include "core/ecs/entity.h"
+#include "renderer/buffers/vertex_array.h"
+#include "renderer/materials/texture.h"
+#include "serialization/json/fwd.h"
+
+namespace ptgn {
+
+class Manager;
+
+namespace impl {
+
+// Sprite which is drawn as part of a static batch instead of individually.
+struct StaticBatchMember {
+	Entity batch;
+
+	// Batches are rebuilt from their members, so membership is never serialized.
+	friend void to_json(
+		[[maybe_unused]] json& j, [[maybe_unused]] const StaticBatchMember& member
+	) {}
+
+	friend void from_json([[maybe_unused]] const json& j, StaticBatchMember& member) {
+		member = {};
+	}
+};
+
+// Baked geometry of the members which share one set of texture slots.
+struct StaticBatchSegment {
+	VertexArray vertex_array;
+	std::uint32_t index_count{ 0 };
+	std::vector<TextureId> textures;
+};
+
+struct StaticBatchData {
+	struct Member {
+		Entity entity;
+		// Visibility of the member when the batch was last baked.
+		bool visible{ false };
+	};
+
+	std::vector<Member> members;
+	std::vector<StaticBatchSegment> segments;
+	bool dirty{ true };
+
+	friend void to_json([[maybe_unused]] json& j, [[maybe_unused]] const StaticBatchData& data) {}
+
+	friend void from_json([[maybe_unused]] const json& j, StaticBatchData& data) {
+		data = {};
+	}
+};
+
+// @return True if the entity is a member of a static batch which still exists.
+[[nodiscard]] bool IsStaticBatchMember(const Entity& entity);
+
+} // namespace impl
+
+// Sprites which never move, such as tiles and backgrounds, baked once into GPU buffers so that
+// the whole batch is drawn with a single draw call per frame (one per group of textures which
+// exceeds the texture slots of a batch). The batch is only rebaked when a member is destroyed, or
+// its world transform or visibility changes. Other changes to members (tint, texture, crop, etc.)
+// require a call to Invalidate().
+// Members are drawn in depth order at the depth of the batch entity, using its camera and blend
+// mode. To keep members of different depths interleaved with other entities, use
+// CreateStaticBatches() instead.
+struct StaticBatch : public Entity {
+	StaticBatch() = default;
+	StaticBatch(const Entity& entity);
+
+	static void Draw(const Entity& entity);
+
+	// Entities which are not sprites or which have pre fx or post fx cannot be batched and are
+	// ignored.
+	StaticBatch& AddMember(Entity entity);
+
+	StaticBatch& RemoveMember(Entity entity);
+
+	// Removes all members, which are drawn individually again.
+	void ClearMembers();
+
+	// Rebakes the batch on the next draw.
+	void Invalidate();
+
+	// @return True if the entity can be drawn as part of a static batch.
+	[[nodiscard]] static bool CanBatch(const Entity& entity);
+
+	[[nodiscard]] std::size_t GetMemberCount() const;
+};
+
+PTGN_DRAWABLE_REGISTER(StaticBatch);
+
+// Creates a static batch of every batchable entity. The batch is given the lowest depth of its
+// members.
+StaticBatch CreateStaticBatch(Manager& manager, const std::vector<Entity>& entities);
+
+// Creates one static batch per depth of the batchable entities, so that each batch is drawn at
+// the depth of its members.
+[[nodiscard]] std::vector<StaticBatch> CreateStaticBatches(
+	Manager& manager, const std::vector<Entity>& entities
+);
+
+} // namespace ptgn
\ No newline at end of file
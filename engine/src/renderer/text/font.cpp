@@ -1,8 +1,11 @@
 #include "renderer/text/font.h"
 
 #include <cstdint>
+#include <filesystem>
+#include <list>
 #include <memory>
 #include <string>
+#include <system_error>
 #include <unordered_map>
 #include <utility>
 
@@ -14,7 +17,9 @@
 #include "core/utils/file.h"
 #include "debug/runtime/assert.h"
 #include "math/vector2.h"
+#include "renderer/materials/texture_atlas.h"
 #include "renderer/text/fonts.h"
+#include "renderer/text/glyph_atlas.h"
 #include "SDL_error.h"
 #include "SDL_rwops.h"
 #include "SDL_ttf.h"
@@ -44,7 +49,106 @@ void TTF_FontDeleter::operator()(TTF_Font* font) const {
 	}
 }
 
-FontManager::FontManager(FontManager&& other) noexcept : ResourceManager{ std::move(other) } {
+std::size_t SizedFontCache::KeyHasher::operator()(const Key& key) const {
+	std::size_t value{ key.font };
+	value = value * 31 + static_cast<std::size_t>(key.size);
+	value = value * 31 + static_cast<std::size_t>(key.index);
+	value = value * 31 + static_cast<std::size_t>(key.style);
+	value = value * 31 + static_cast<std::size_t>(key.outline);
+	return value;
+}
+
+TemporaryFont SizedFontCache::Find(const Key& key) {
+	auto it{ lookup_.find(key) };
+	if (it == lookup_.end()) {
+		++stats_.misses;
+		return nullptr;
+	}
+	++stats_.hits;
+	// Move to the front of the recency list.
+	entries_.splice(entries_.begin(), entries_, it->second);
+	return it->second->font;
+}
+
+bool SizedFontCache::Contains(const Key& key) const {
+	return lookup_.contains(key);
+}
+
+void SizedFontCache::Insert(const Key& key, const TemporaryFont& font, std::size_t bytes) {
+	PTGN_ASSERT(font != nullptr, "Cannot cache nullptr font");
+	if (auto it{ lookup_.find(key) }; it != lookup_.end()) {
+		stats_.bytes -= it->second->bytes;
+		entries_.erase(it->second);
+		lookup_.erase(it);
+	}
+	entries_.emplace_front(Entry{ key, font, bytes });
+	lookup_.emplace(key, entries_.begin());
+	stats_.bytes += bytes;
+	EvictToLimits();
+}
+
+void SizedFontCache::Remove(std::size_t font) {
+	for (auto it{ entries_.begin() }; it != entries_.end();) {
+		if (it->key.font != font) {
+			++it;
+			continue;
+		}
+		stats_.bytes -= it->bytes;
+		lookup_.erase(it->key);
+		it = entries_.erase(it);
+	}
+	stats_.fonts = entries_.size();
+}
+
+void SizedFontCache::Clear() {
+	entries_.clear();
+	lookup_.clear();
+	stats_.fonts = 0;
+	stats_.bytes = 0;
+}
+
+void SizedFontCache::SetLimits(std::size_t max_fonts, std::size_t max_bytes) {
+	max_fonts_ = max_fonts;
+	max_bytes_ = max_bytes;
+	EvictToLimits();
+}
+
+std::size_t SizedFontCache::GetMaxFonts() const {
+	return max_fonts_;
+}
+
+std::size_t SizedFontCache::GetMaxBytes() const {
+	return max_bytes_;
+}
+
+const FontCacheStats& SizedFontCache::GetStats() const {
+	return stats_;
+}
+
+void SizedFontCache::ResetStats() {
+	stats_.hits		 = 0;
+	stats_.misses	 = 0;
+	stats_.evictions = 0;
+}
+
+void SizedFontCache::EvictToLimits() {
+	while (!entries_.empty() && (entries_.size() > max_fonts_ || stats_.bytes > max_bytes_)) {
+		const auto& entry{ entries_.back() };
+		stats_.bytes -= entry.bytes;
+		lookup_.erase(entry.key);
+		entries_.pop_back();
+		++stats_.evictions;
+	}
+	stats_.fonts = entries_.size();
+}
+
+FontManager::FontManager() = default;
+
+FontManager::FontManager(FontManager&& other) noexcept :
+	ResourceManager{ std::move(other) },
+	glyph_atlas_{ std::move(other.glyph_atlas_) },
+	indices_{ std::move(other.indices_) },
+	sized_fonts_{ std::move(other.sized_fonts_) } {
 	raw_default_font_ = std::exchange(other.raw_default_font_, nullptr);
 }
 
@@ -52,6 +156,9 @@ FontManager& FontManager::operator=(FontManager&& other) noexcept {
 	if (this != &other) {
 		ResourceManager::operator=(std::move(other));
 		raw_default_font_ = std::exchange(other.raw_default_font_, nullptr);
+		glyph_atlas_	  = std::move(other.glyph_atlas_);
+		indices_		  = std::move(other.indices_);
+		sized_fonts_	  = std::move(other.sized_fonts_);
 	}
 	return *this;
 }
@@ -71,6 +178,15 @@ void FontManager::Load(
 ) {
 	auto [it, inserted] = resources_.try_emplace(key);
 	if (inserted || key == ResourceHandle{} /* Replacing default font */) {
+		if (glyph_atlas_) {
+			glyph_atlas_->RemoveFont(key);
+		}
+		sized_fonts_.Remove(key.GetHash());
+		if (index == default_font_index) {
+			indices_.erase(key.GetHash());
+		} else {
+			indices_[key.GetHash()] = index;
+		}
 		it->second.key		= key;
 		it->second.filepath = filepath;
 		it->second.resource = LoadFromFile(filepath, size, index);
@@ -85,7 +201,63 @@ void FontManager::Load(
 		it->second.key = key;
 		// Not applicable: it->second.filepath
 		it->second.resource = LoadFromBinary(binary, size, index);
+		if (index != default_font_index) {
+			indices_[key.GetHash()] = index;
+		}
+	}
+}
+
+void FontManager::Unload(const ResourceHandle& key) {
+	if (glyph_atlas_) {
+		glyph_atlas_->RemoveFont(key);
 	}
+	sized_fonts_.Remove(key.GetHash());
+	indices_.erase(key.GetHash());
+	ParentManager::Unload(key);
+}
+
+void FontManager::Clear() {
+	if (glyph_atlas_) {
+		glyph_atlas_->Clear();
+	}
+	sized_fonts_.Clear();
+	indices_.clear();
+	ParentManager::Clear();
+}
+
+void FontManager::EnableGlyphAtlas(const V2_int& page_size, int padding, std::size_t max_faces) {
+	glyph_atlas_ = std::make_unique<GlyphAtlas>(page_size, padding, max_faces);
+}
+
+void FontManager::DisableGlyphAtlas() {
+	glyph_atlas_.reset();
+}
+
+bool FontManager::IsGlyphAtlasEnabled() const {
+	return glyph_atlas_ != nullptr;
+}
+
+TextureAtlasStats FontManager::GetGlyphAtlasStats() const {
+	if (!glyph_atlas_) {
+		return {};
+	}
+	return glyph_atlas_->GetStats();
+}
+
+GlyphAtlas* FontManager::GetGlyphAtlas() {
+	return glyph_atlas_.get();
+}
+
+void FontManager::SetFontCacheLimits(std::size_t max_fonts, std::size_t max_bytes) {
+	sized_fonts_.SetLimits(max_fonts, max_bytes);
+}
+
+FontCacheStats FontManager::GetFontCacheStats() const {
+	return sized_fonts_.GetStats();
+}
+
+void FontManager::ResetFontCacheStats() {
+	sized_fonts_.ResetStats();
 }
 
 void FontManager::Init() {
@@ -120,19 +292,56 @@ TemporaryFont FontManager::Get(const ResourceHandle& key, const FontSize& font_s
 							 } };
 	}
 
+	SizedFontCache::Key cache_key{ key.GetHash(), font_size, GetIndex(key) };
+
+	if (auto font{ sized_fonts_.Find(cache_key) }) {
+		return font;
+	}
+
+	auto font{ OpenSized(key, font_size) };
+	PTGN_ASSERT(font != nullptr, TTF_GetError());
+
+	if (sized_fonts_.GetMaxFonts() > 0) {
+		sized_fonts_.Insert(cache_key, font, GetDataSize(key));
+	}
+
+	return font;
+}
+
+TemporaryFont FontManager::OpenSized(const ResourceHandle& key, std::int32_t size) const {
+	PTGN_ASSERT(Has(key), "Cannot open font which has not been loaded");
+
+	const auto& resource_info{ resources_.find(key)->second };
+
 	if (!resource_info.filepath.empty()) {
 		auto path_string{ resource_info.filepath.string() };
-		return TemporaryFont{ TTF_OpenFont(path_string.c_str(), font_size), TTF_FontDeleter{} };
+		return TemporaryFont{ TTF_OpenFontIndex(path_string.c_str(), size, GetIndex(key)),
+							  TTF_FontDeleter{} };
 	}
 
 	// Font has no path defined.
 	PTGN_ASSERT(
 		key == ResourceHandle{}, "Font key must have a valid path unless it is the default font"
 	);
-	return TemporaryFont{ LoadFromBinary(raw_default_font_, font_size, default_font_index, false),
+	return TemporaryFont{ LoadFromBinary(raw_default_font_, size, default_font_index, false),
 						  TTF_FontDeleter{} };
 }
 
+std::int32_t FontManager::GetIndex(const ResourceHandle& key) const {
+	auto it{ indices_.find(key.GetHash()) };
+	return it == indices_.end() ? default_font_index : it->second;
+}
+
+std::size_t FontManager::GetDataSize(const ResourceHandle& key) const {
+	const auto& filepath{ GetPath(key) };
+	if (filepath.empty()) {
+		return GetLiberationSansRegular().length;
+	}
+	std::error_code error;
+	auto size{ std::filesystem::file_size(filepath, error) };
+	return error ? 0 : static_cast<std::size_t>(size);
+}
+
 V2_int FontManager::GetSize(
 	const ResourceHandle& key, const std::string& content, const FontSize& font_size
 ) const {
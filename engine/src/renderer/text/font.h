@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 #include "core/ecs/components/generic.h"
 #include "core/resource/resource_manager.h"
@@ -25,6 +27,7 @@ namespace ptgn {
 class Text;
 class Scene;
 class Camera;
+struct TextureAtlasStats;
 
 static constexpr std::int32_t default_font_size{ 18 };
 static constexpr std::int32_t default_font_index{ 0 };
@@ -51,6 +54,16 @@ struct FontSize : public ArithmeticComponent<std::int32_t> {
 	[[nodiscard]] FontSize GetHD(const Scene& scene, const Camera& camera) const;
 };
 
+struct FontCacheStats {
+	std::size_t hits{ 0 };
+	std::size_t misses{ 0 };
+	std::size_t evictions{ 0 };
+	// Number of cached font handles.
+	std::size_t fonts{ 0 };
+	// Estimated from the size of the font data of each cached handle. Unit: bytes.
+	std::size_t bytes{ 0 };
+};
+
 [[nodiscard]] inline FontStyle operator&(FontStyle a, FontStyle b) {
 	return static_cast<FontStyle>(static_cast<int>(a) | static_cast<int>(b));
 }
@@ -62,6 +75,7 @@ struct FontSize : public ArithmeticComponent<std::int32_t> {
 namespace impl {
 
 class Game;
+class GlyphAtlas;
 
 struct TTF_FontDeleter {
 	void operator()(TTF_Font* font) const;
@@ -71,9 +85,77 @@ using Font = std::unique_ptr<TTF_Font, TTF_FontDeleter>;
 
 using TemporaryFont = std::shared_ptr<TTF_Font>;
 
+// Least recently used cache of font handles opened at non-default sizes, so that measuring text
+// does not reopen the font every time. Cached handles are shared, so their style, size and outline
+// must not be modified after they are inserted.
+class SizedFontCache {
+public:
+	struct Key {
+		std::size_t font{ 0 };
+		std::int32_t size{ 0 };
+		std::int32_t index{ 0 };
+		// Style and outline which the cached handle was opened with.
+		FontStyle style{ FontStyle::Normal };
+		std::int32_t outline{ 0 };
+
+		bool operator==(const Key&) const = default;
+	};
+
+	// @return Nullptr if the font is not cached.
+	[[nodiscard]] TemporaryFont Find(const Key& key);
+
+	// @return True if the font is cached. Unlike Find, this does not count as a use.
+	[[nodiscard]] bool Contains(const Key& key) const;
+
+	// Evicts the least recently used fonts until the cache is within its limits. Evicted handles
+	// stay alive for as long as they are used elsewhere.
+	// @param bytes Estimated memory of the font handle.
+	void Insert(const Key& key, const TemporaryFont& font, std::size_t bytes);
+
+	// Removes every size of the font.
+	void Remove(std::size_t font);
+
+	void Clear();
+
+	// @param max_fonts Maximum number of cached handles. Zero disables the cache.
+	// @param max_bytes Maximum estimated memory of all cached handles.
+	void SetLimits(std::size_t max_fonts, std::size_t max_bytes);
+
+	[[nodiscard]] std::size_t GetMaxFonts() const;
+	[[nodiscard]] std::size_t GetMaxBytes() const;
+
+	[[nodiscard]] const FontCacheStats& GetStats() const;
+
+	// Resets the hit, miss and eviction counters.
+	void ResetStats();
+
+private:
+	struct KeyHasher {
+		[[nodiscard]] std::size_t operator()(const Key& key) const;
+	};
+
+	struct Entry {
+		Key key;
+		TemporaryFont font;
+		std::size_t bytes{ 0 };
+	};
+
+	void EvictToLimits();
+
+	// Most recently used first.
+	std::list<Entry> entries_;
+
+	std::unordered_map<Key, std::list<Entry>::iterator, KeyHasher> lookup_;
+
+	std::size_t max_fonts_{ 32 };
+	std::size_t max_bytes_{ 64 * 1024 * 1024 };
+
+	FontCacheStats stats_;
+};
+
 class FontManager : public ResourceManager<FontManager, ResourceHandle, Font> {
 public:
-	FontManager()							   = default;
+	FontManager();
 	FontManager(const FontManager&)			   = delete;
 	FontManager& operator=(const FontManager&) = delete;
 	FontManager(FontManager&& other) noexcept;
@@ -82,6 +164,10 @@ public:
 
 	void Load(const ResourceHandle& key, const path& filepath) final;
 
+	void Unload(const ResourceHandle& key) final;
+
+	void Clear() final;
+
 	const Font& Get(const ResourceHandle& key) const = delete;
 
 	void Load(
@@ -109,6 +195,40 @@ public:
 	[[nodiscard]] FontSize GetHeight(const ResourceHandle& key, const FontSize& font_size = {})
 		const;
 
+	// While enabled, texts are laid out from glyphs which are rasterized once per font, size and
+	// style into shared atlas pages, instead of rasterizing every text into its own texture.
+	// Disabled by default.
+	// @param page_size Size of each atlas page.
+	// @param padding Empty pixels between glyphs.
+	// @param max_faces Maximum number of font sizes and styles which keep their glyphs in the
+	// atlas. The glyphs of the least recently used face are freed once this is exceeded.
+	void EnableGlyphAtlas(
+		const V2_int& page_size = { 1024, 1024 }, int padding = 1, std::size_t max_faces = 32
+	);
+
+	// Destroys all glyph atlas pages. Texts are rasterized into their own textures again.
+	void DisableGlyphAtlas();
+
+	[[nodiscard]] bool IsGlyphAtlasEnabled() const;
+
+	// @return Occupancy of the glyph atlas pages. Empty if the glyph atlas is disabled.
+	[[nodiscard]] TextureAtlasStats GetGlyphAtlasStats() const;
+
+	// @return Nullptr if the glyph atlas is disabled.
+	[[nodiscard]] GlyphAtlas* GetGlyphAtlas();
+
+	// Fonts requested at a size other than the one they were loaded with are kept open in a least
+	// recently used cache keyed by font, size and index. Memory is estimated from the size of the
+	// font data.
+	// @param max_fonts Maximum number of cached font handles. Zero disables the cache.
+	// @param max_bytes Maximum estimated memory of all cached font handles.
+	void SetFontCacheLimits(std::size_t max_fonts, std::size_t max_bytes);
+
+	[[nodiscard]] FontCacheStats GetFontCacheStats() const;
+
+	// Resets the hit, miss and eviction counters of the font cache.
+	void ResetFontCacheStats();
+
 	// Note: This function will not serialize any fonts loaded from binaries.
 	friend void to_json(json& j, const FontManager& manager);
 
@@ -118,6 +238,7 @@ public:
 private:
 	friend class Game;
 	friend class ptgn::Text;
+	friend class GlyphAtlas;
 	friend ParentManager;
 
 	// Initializes the default font from a binary.
@@ -140,12 +261,31 @@ private:
 
 	[[nodiscard]] static Font LoadFromFile(const path& filepath);
 
+	// Non-default sizes are retrieved from the sized font cache.
 	[[nodiscard]] TemporaryFont Get(const ResourceHandle& key, const FontSize& font_size = {})
 		const;
 
+	// @return Newly opened handle of the font at the given size, which is not shared with the
+	// loaded font or the sized font cache.
+	[[nodiscard]] TemporaryFont OpenSized(const ResourceHandle& key, std::int32_t size) const;
+
+	// @return Face index with which the font was loaded.
+	[[nodiscard]] std::int32_t GetIndex(const ResourceHandle& key) const;
+
+	// @return Size of the data which the font is opened from. Unit: bytes.
+	[[nodiscard]] std::size_t GetDataSize(const ResourceHandle& key) const;
+
 	ResourceHandle default_key_;
 
 	SDL_RWops* raw_default_font_{ nullptr };
+
+	// Nullptr while the glyph atlas is disabled.
+	std::unique_ptr<GlyphAtlas> glyph_atlas_;
+
+	// Face indices of fonts which were not loaded with the default index.
+	std::unordered_map<std::size_t, std::int32_t> indices_;
+
+	mutable SizedFontCache sized_fonts_;
 };
 
 } // namespace impl
@@ -0,0 +1,438 @@
+#include "renderer/text/glyph_atlas.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/app/game.h"
+#include "core/ecs/components/generic.h"
+#include "debug/runtime/assert.h"
+#include "math/vector2.h"
+#include "renderer/api/color.h"
+#include "renderer/materials/texture.h"
+#include "renderer/materials/texture_atlas.h"
+#include "renderer/text/font.h"
+#include "renderer/text/text.h"
+#include "SDL_pixels.h"
+#include "SDL_surface.h"
+#include "SDL_ttf.h"
+
+namespace ptgn {
+
+namespace impl {
+
+constexpr std::uint32_t replacement_codepoint{ 0xFFFD };
+
+// @param index Byte index of the codepoint, which is advanced past it.
+// @return Decoded codepoint, or the replacement character for invalid UTF-8.
+static std::uint32_t DecodeUTF8(std::string_view text, std::size_t& index) {
+	auto byte{ static_cast<std::uint8_t>(text[index++]) };
+	if (byte < 0x80) {
+		return byte;
+	}
+
+	std::size_t continuation{ 0 };
+	std::uint32_t codepoint{ 0 };
+	if ((byte & 0xE0) == 0xC0) {
+		continuation = 1;
+		codepoint	 = byte & 0x1F;
+	} else if ((byte & 0xF0) == 0xE0) {
+		continuation = 2;
+		codepoint	 = byte & 0x0F;
+	} else if ((byte & 0xF8) == 0xF0) {
+		continuation = 3;
+		codepoint	 = byte & 0x07;
+	} else {
+		return replacement_codepoint;
+	}
+
+	for (std::size_t i{ 0 }; i < continuation; ++i) {
+		if (index >= text.size() || (static_cast<std::uint8_t>(text[index]) & 0xC0) != 0x80) {
+			return replacement_codepoint;
+		}
+		codepoint = (codepoint << 6) | (static_cast<std::uint8_t>(text[index++]) & 0x3F);
+	}
+	return codepoint;
+}
+
+// @return True if the codepoint never has visible pixels.
+static bool IsBlank(std::uint32_t codepoint) {
+	return codepoint == ' ' || codepoint == '\t' || codepoint == '\r' || codepoint == 0x00A0;
+}
+
+// @return Font size rounded up to one of 8 steps per doubling, so that continuously changing sizes
+// only create a logarithmic number of faces.
+static std::int32_t QuantizeFontSize(std::int32_t size) {
+	auto step{ static_cast<std::int32_t>(
+		std::max(std::bit_floor(static_cast<std::uint32_t>(size)) / 8, 1u)
+	) };
+	return (size + step - 1) / step * step;
+}
+
+std::size_t GlyphAtlas::FaceKeyHasher::operator()(const FaceKey& key) const {
+	std::size_t value{ key.font };
+	value = value * 31 + static_cast<std::size_t>(key.size);
+	value = value * 31 + static_cast<std::size_t>(key.style);
+	value = value * 31 + static_cast<std::size_t>(key.outline);
+	value = value * 31 + static_cast<std::size_t>(key.solid);
+	return value;
+}
+
+GlyphAtlas::GlyphAtlas(const V2_int& page_size, int padding, std::size_t max_faces) :
+	atlas_{ page_size, page_size - V2_int{ padding }, padding } {
+	PTGN_ASSERT(max_faces > 0, "Glyph atlas must be able to hold at least one face");
+	fonts_.SetLimits(max_faces, fonts_.GetMaxBytes());
+}
+
+void GlyphAtlas::Layout(
+	TextLayout& layout, const TextContent& content, const TextColor& color,
+	const FontSize& font_size, const ResourceHandle& font_key, const TextProperties& properties,
+	bool quantize_size
+) {
+	layout.quads.clear();
+	layout.size		  = {};
+	layout.background = properties.render_mode == FontRenderMode::Shaded
+						  ? Color{ properties.shading_color }
+						  : color::Transparent;
+	layout.generation = generation_;
+
+	const auto& text{ content.GetValue() };
+
+	if (text.empty()) {
+		return;
+	}
+
+	PTGN_ASSERT(
+		game.font.Has(font_key),
+		"Cannot lay out text with font key which is not loaded in the font manager"
+	);
+	PTGN_ASSERT(font_size > 0, "Font size must be greater than zero");
+	PTGN_ASSERT(
+		font_size < 10000, "Font size exceeds maximum allowable font size or grew recursively"
+	);
+	PTGN_ASSERT(properties.outline.width >= 0, "Cannot have negative font outline width");
+
+	std::int32_t size{ font_size };
+	if (quantize_size) {
+		size = QuantizeFontSize(size);
+	}
+	// Pixel properties are given at the requested size.
+	float scale{ static_cast<float>(size) / static_cast<float>(font_size) };
+
+	FaceKey key{ font_key.GetHash(), size, properties.style, 0,
+				 properties.render_mode == FontRenderMode::Solid };
+	Face& face{ GetFace(key) };
+
+	codepoints_.clear();
+	for (std::size_t i{ 0 }; i < text.size();) {
+		codepoints_.emplace_back(DecodeUTF8(text, i));
+	}
+
+	BreakLines(
+		key, face,
+		static_cast<std::uint32_t>(static_cast<float>(properties.wrap_after) * scale)
+	);
+
+	std::int32_t line_skip{ face.line_skip };
+	if (properties.line_skip != std::numeric_limits<std::int32_t>::infinity()) {
+		line_skip = static_cast<std::int32_t>(static_cast<float>(properties.line_skip) * scale);
+	}
+
+	std::int32_t width{ 0 };
+	for (const auto& line : lines_) {
+		width = std::max(width, line.width);
+	}
+
+	std::int32_t outline{ 0 };
+	if (properties.outline.width != 0 && properties.outline.color != color::Transparent) {
+		PTGN_ASSERT(
+			properties.render_mode == FontRenderMode::Blended,
+			"Font render mode must be set to blended when drawing text with outline"
+		);
+		outline = static_cast<std::int32_t>(static_cast<float>(properties.outline.width) * scale);
+	}
+
+	auto line_count{ static_cast<std::int32_t>(lines_.size()) };
+
+	layout.size = { width + 2 * outline, face.height + (line_count - 1) * line_skip + 2 * outline };
+
+	// Glyphs are positioned using the metrics of the face without outline, so that the outline
+	// glyphs line up with the text glyphs.
+	const auto place = [&](const FaceKey& glyph_key, Face& glyph_face, const V2_float& offset,
+						   const Color& glyph_color) {
+		for (std::size_t l{ 0 }; l < lines_.size(); ++l) {
+			const auto& line{ lines_[l] };
+
+			std::int32_t x{ 0 };
+			switch (properties.justify) {
+				case TextJustify::Left:	  break;
+				case TextJustify::Center: x = (width - line.width) / 2; break;
+				case TextJustify::Right:  x = width - line.width; break;
+				default:				  PTGN_ERROR("Unrecognized text justify");
+			}
+			auto y{ static_cast<std::int32_t>(l) * line_skip };
+
+			std::uint32_t previous{ 0 };
+			for (std::size_t i{ line.begin }; i < line.end; ++i) {
+				auto codepoint{ codepoints_[i] };
+				x += GetKerning(face, previous, codepoint);
+				const auto& glyph{ GetGlyph(glyph_key, glyph_face, codepoint) };
+				if (glyph.region) {
+					auto& quad{ layout.quads.emplace_back() };
+					quad.page	  = glyph.region->page;
+					quad.position = offset + V2_float{ V2_int{ x, y } };
+					quad.size	  = glyph.size;
+					quad.color	  = glyph_color;
+					glyph.region->Remap(quad.texture_coordinates);
+				}
+				x		 += GetGlyph(key, face, codepoint).advance;
+				previous  = codepoint;
+			}
+		}
+	};
+
+	if (outline > 0) {
+		FaceKey outline_key{ key };
+		outline_key.outline = outline;
+		place(outline_key, GetFace(outline_key), {}, properties.outline.color);
+	}
+
+	place(key, face, V2_float{ static_cast<float>(outline) }, color);
+
+	if (size != font_size) {
+		for (auto& quad : layout.quads) {
+			quad.position /= scale;
+			quad.size	  /= scale;
+		}
+		layout.size = V2_int{ V2_float{ layout.size } / scale };
+	}
+}
+
+void GlyphAtlas::RemoveFont(const ResourceHandle& font_key) {
+	auto font{ font_key.GetHash() };
+	auto removed{ std::erase_if(faces_, [&](const auto& pair) {
+		const auto& [key, face] = pair;
+		if (key.font != font) {
+			return false;
+		}
+		FreeGlyphs(face);
+		return true;
+	}) };
+	fonts_.Remove(font);
+	if (removed > 0) {
+		++generation_;
+	}
+}
+
+void GlyphAtlas::ReleaseEvictedFaces() {
+	if (!evicted_) {
+		return;
+	}
+	evicted_ = false;
+	auto removed{ std::erase_if(faces_, [&](const auto& pair) {
+		const auto& face{ pair.second };
+		if (fonts_.Contains(face.font_key)) {
+			return false;
+		}
+		FreeGlyphs(face);
+		return true;
+	}) };
+	if (removed > 0) {
+		++generation_;
+	}
+}
+
+void GlyphAtlas::Clear() {
+	atlas_.Clear();
+	faces_.clear();
+	fonts_.Clear();
+	evicted_	 = false;
+	glyph_count_ = 0;
+	++generation_;
+}
+
+std::uint32_t GlyphAtlas::GetGeneration() const {
+	return generation_;
+}
+
+TextureAtlasStats GlyphAtlas::GetStats() const {
+	auto stats{ atlas_.GetStats() };
+	stats.textures = glyph_count_;
+	return stats;
+}
+
+GlyphAtlas::Face& GlyphAtlas::GetFace(const FaceKey& key) {
+	auto [it, inserted] = faces_.try_emplace(key);
+	auto& face{ it->second };
+	if (!inserted) {
+		// Marks the face as recently used, or caches it again if it was evicted but its glyphs
+		// have not been released yet.
+		if (fonts_.Find(face.font_key) == nullptr) {
+			CacheFont(face.font_key, face.font);
+		}
+		return face;
+	}
+
+	ResourceHandle font_key{ key.font };
+
+	face.font_key = SizedFontCache::Key{ key.font, key.size, game.font.GetIndex(font_key),
+										 key.style, key.outline };
+
+	// Faces which only differ in render mode share a font handle.
+	face.font = fonts_.Find(face.font_key);
+
+	if (face.font == nullptr) {
+		face.font = game.font.OpenSized(font_key, key.size);
+		PTGN_ASSERT(face.font != nullptr, TTF_GetError());
+		TTF_SetFontStyle(face.font.get(), static_cast<int>(key.style));
+		TTF_SetFontOutline(face.font.get(), key.outline);
+		CacheFont(face.font_key, face.font);
+	}
+
+	TTF_Font* font{ face.font.get() };
+
+	face.height	   = TTF_FontHeight(font);
+	face.line_skip = TTF_FontLineSkip(font);
+
+	return face;
+}
+
+void GlyphAtlas::CacheFont(const SizedFontCache::Key& key, const TemporaryFont& font) {
+	auto evictions{ fonts_.GetStats().evictions };
+	fonts_.Insert(key, font, game.font.GetDataSize(ResourceHandle{ key.font }));
+	if (fonts_.GetStats().evictions != evictions) {
+		evicted_ = true;
+	}
+}
+
+void GlyphAtlas::FreeGlyphs(const Face& face) {
+	for (const auto& [codepoint, glyph] : face.glyphs) {
+		if (glyph.region) {
+			atlas_.Free(*glyph.region, glyph.size);
+			--glyph_count_;
+		}
+	}
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::GetGlyph(
+	const FaceKey& key, Face& face, std::uint32_t codepoint
+) {
+	auto [it, inserted] = face.glyphs.try_emplace(codepoint);
+	auto& glyph{ it->second };
+	if (!inserted) {
+		return glyph;
+	}
+
+	TTF_Font* font{ face.font.get() };
+
+	int advance{ 0 };
+	if (TTF_GlyphMetrics32(font, codepoint, nullptr, nullptr, nullptr, nullptr, &advance) == 0) {
+		glyph.advance = advance;
+	}
+
+	if (IsBlank(codepoint)) {
+		return glyph;
+	}
+
+	// Glyphs are rasterized in white and tinted by the text color when drawn.
+	SDL_Color white{ 255, 255, 255, 255 };
+
+	SDL_Surface* sdl_surface{ key.solid ? TTF_RenderGlyph32_Solid(font, codepoint, white)
+										: TTF_RenderGlyph32_Blended(font, codepoint, white) };
+
+	// Font does not provide the glyph.
+	if (sdl_surface == nullptr) {
+		return glyph;
+	}
+
+	Surface surface{ sdl_surface };
+
+	glyph.size	 = surface.size;
+	glyph.region = atlas_.Pack(surface);
+
+	if (glyph.region) {
+		++glyph_count_;
+	}
+
+	return glyph;
+}
+
+std::int32_t GlyphAtlas::GetKerning(Face& face, std::uint32_t previous, std::uint32_t codepoint) {
+	if (previous == 0) {
+		return 0;
+	}
+	auto pair{ (static_cast<std::uint64_t>(previous) << 32) | codepoint };
+	auto [it, inserted] = face.kerning.try_emplace(pair);
+	if (inserted) {
+		it->second = TTF_GetFontKerningSizeGlyphs32(face.font.get(), previous, codepoint);
+	}
+	return it->second;
+}
+
+std::int32_t GlyphAtlas::Measure(
+	const FaceKey& key, Face& face, std::size_t begin, std::size_t end
+) {
+	std::int32_t width{ 0 };
+	std::uint32_t previous{ 0 };
+	for (std::size_t i{ begin }; i < end; ++i) {
+		width	 += GetKerning(face, previous, codepoints_[i]);
+		width	 += GetGlyph(key, face, codepoints_[i]).advance;
+		previous  = codepoints_[i];
+	}
+	return width;
+}
+
+void GlyphAtlas::BreakLines(const FaceKey& key, Face& face, std::uint32_t wrap_after) {
+	lines_.clear();
+
+	std::size_t begin{ 0 };
+	// Last space of the current line, at which the line can be wrapped.
+	std::optional<std::size_t> space;
+	std::int32_t width{ 0 };
+	std::uint32_t previous{ 0 };
+
+	for (std::size_t i{ 0 }; i < codepoints_.size(); ++i) {
+		auto codepoint{ codepoints_[i] };
+
+		if (codepoint == '\n') {
+			lines_.emplace_back(Line{ begin, i, width });
+			begin	 = i + 1;
+			width	 = 0;
+			previous = 0;
+			space.reset();
+			continue;
+		}
+
+		auto advance{ GetKerning(face, previous, codepoint) +
+					  GetGlyph(key, face, codepoint).advance };
+
+		if (wrap_after > 0 && codepoint != ' ' && space &&
+			width + advance > static_cast<std::int32_t>(wrap_after)) {
+			// Spaces at the wrap are dropped, as SDL_ttf does.
+			lines_.emplace_back(Line{ begin, *space, Measure(key, face, begin, *space) });
+			begin	 = *space + 1;
+			width	 = Measure(key, face, begin, i);
+			previous = begin < i ? codepoints_[i - 1] : 0;
+			advance	 = GetKerning(face, previous, codepoint) + GetGlyph(key, face, codepoint).advance;
+			space.reset();
+		}
+
+		if (codepoint == ' ') {
+			space = i;
+		}
+
+		width	 += advance;
+		previous  = codepoint;
+	}
+
+	lines_.emplace_back(Line{ begin, codepoints_.size(), width });
+}
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
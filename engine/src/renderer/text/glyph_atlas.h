@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "core/ecs/components/generic.h"
+#include "math/vector2.h"
+#include "renderer/api/color.h"
+#include "renderer/api/vertex.h"
+#include "renderer/materials/texture.h"
+#include "renderer/materials/texture_atlas.h"
+#include "renderer/text/font.h"
+#include "renderer/text/text.h"
+
+namespace ptgn {
+
+namespace impl {
+
+struct GlyphQuad {
+	TextureId page{ 0 };
+	// Top left corner and size of the glyph within the laid out text. Unit: pixels.
+	V2_float position;
+	V2_float size;
+	std::array<V2_float, 4> texture_coordinates{ GetDefaultTextureCoordinates() };
+	Color color;
+};
+
+// Text laid out as quads which sample the glyph atlas pages. Glyph bitmaps are white, so each
+// quad is tinted by its color.
+struct TextLayout {
+	// Outline quads come first so that they are drawn underneath the text.
+	std::vector<GlyphQuad> quads;
+	// Size of the laid out text. Unit: pixels.
+	V2_int size;
+	// Drawn behind the glyphs of shaded text.
+	Color background{ color::Transparent };
+	// Generation of the glyph atlas which the quads refer to.
+	std::uint32_t generation{ 0 };
+};
+
+// Rasterizes glyphs once per font, size and style into shared atlas pages, so that changing the
+// content or color of a text only costs a new layout instead of a new texture. Glyphs larger than
+// a page are not drawn. Faces are kept in a least recently used cache, and the glyphs of evicted
+// faces are freed so that the atlas does not grow with every size a text is drawn at.
+class GlyphAtlas {
+public:
+	// @param page_size Size of each atlas page.
+	// @param padding Empty pixels between glyphs, to prevent filtering across them.
+	// @param max_faces Maximum number of font sizes and styles which keep their glyphs.
+	GlyphAtlas(const V2_int& page_size, int padding, std::size_t max_faces);
+
+	// Lays out the text, rasterizing any glyphs which are not in the atlas yet. Wrapping,
+	// justification, line skip, outline and shading follow the text properties.
+	// @param layout Previous quads are replaced, keeping the capacity of the layout.
+	// @param quantize_size If true, glyphs are rasterized at the font size rounded up to one of a
+	// few steps per doubling, and scaled down to the requested size. Used for HD text, whose size
+	// follows the camera zoom.
+	void Layout(
+		TextLayout& layout, const TextContent& content, const TextColor& color,
+		const FontSize& font_size, const ResourceHandle& font_key,
+		const TextProperties& properties, bool quantize_size = false
+	);
+
+	// Frees the glyphs of the font. Existing layouts become outdated.
+	void RemoveFont(const ResourceHandle& font_key);
+
+	// Frees the glyphs of faces which were evicted from the face cache. Must only be called once
+	// the draw commands which sample the glyphs have been flushed. Existing layouts become outdated
+	// if any glyphs are freed.
+	void ReleaseEvictedFaces();
+
+	// Removes all glyphs and destroys all pages. Existing layouts become outdated.
+	void Clear();
+
+	// @return Incremented whenever glyphs are freed.
+	[[nodiscard]] std::uint32_t GetGeneration() const;
+
+	// @return Occupancy of the atlas pages, where textures are the rasterized glyphs.
+	[[nodiscard]] TextureAtlasStats GetStats() const;
+
+private:
+	struct FaceKey {
+		std::size_t font{ 0 };
+		std::int32_t size{ 0 };
+		FontStyle style{ FontStyle::Normal };
+		std::int32_t outline{ 0 };
+		bool solid{ false };
+
+		bool operator==(const FaceKey&) const = default;
+	};
+
+	struct FaceKeyHasher {
+		[[nodiscard]] std::size_t operator()(const FaceKey& key) const;
+	};
+
+	struct Glyph {
+		// Std::nullopt for glyphs without any visible pixels, such as spaces.
+		std::optional<AtlasRegion> region;
+		V2_int size;
+		std::int32_t advance{ 0 };
+	};
+
+	// Font opened at a single size and style. The font handle is shared only with faces which
+	// differ in render mode, so its style and outline are only set once.
+	struct Face {
+		TemporaryFont font;
+		// Key of the font handle in the face cache.
+		SizedFontCache::Key font_key;
+		std::int32_t height{ 0 };
+		std::int32_t line_skip{ 0 };
+		std::unordered_map<std::uint32_t, Glyph> glyphs;
+		// Keyed by the previous and current codepoint.
+		std::unordered_map<std::uint64_t, std::int32_t> kerning;
+	};
+
+	struct Line {
+		std::size_t begin{ 0 };
+		std::size_t end{ 0 };
+		std::int32_t width{ 0 };
+	};
+
+	[[nodiscard]] Face& GetFace(const FaceKey& key);
+
+	// Caches the font handle of a face, recording whether another face was evicted.
+	void CacheFont(const SizedFontCache::Key& key, const TemporaryFont& font);
+
+	void FreeGlyphs(const Face& face);
+
+	[[nodiscard]] const Glyph& GetGlyph(const FaceKey& key, Face& face, std::uint32_t codepoint);
+
+	[[nodiscard]] static std::int32_t GetKerning(
+		Face& face, std::uint32_t previous, std::uint32_t codepoint
+	);
+
+	// @return Width of codepoints_ in [begin, end) when drawn with the face.
+	[[nodiscard]] std::int32_t Measure(
+		const FaceKey& key, Face& face, std::size_t begin, std::size_t end
+	);
+
+	// Splits codepoints_ into lines_ at newlines, and at spaces once a line exceeds wrap_after.
+	void BreakLines(const FaceKey& key, Face& face, std::uint32_t wrap_after);
+
+	TextureAtlas atlas_;
+
+	std::unordered_map<FaceKey, Face, FaceKeyHasher> faces_;
+
+	// Least recently used font handles of the faces. Faces whose handle is evicted keep their
+	// glyphs until ReleaseEvictedFaces is called.
+	SizedFontCache fonts_;
+
+	bool evicted_{ false };
+
+	std::size_t glyph_count_{ 0 };
+
+	std::uint32_t generation_{ 0 };
+
+	// Scratch buffers reused between layouts.
+	std::vector<std::uint32_t> codepoints_;
+	std::vector<Line> lines_;
+};
+
+} // namespace impl
+
+} // namespace ptgn
\ No newline at end of file
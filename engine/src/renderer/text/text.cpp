@@ -21,6 +21,7 @@
 #include "renderer/materials/texture.h"
 #include "renderer/render_data.h"
 #include "renderer/text/font.h"
+#include "renderer/text/glyph_atlas.h"
 #include "SDL_blendmode.h"
 #include "SDL_pixels.h"
 #include "SDL_rect.h"
@@ -292,6 +293,24 @@ bool Text::IsHD() const {
 	return Has<impl::HDText>() && Get<impl::HDText>();
 }
 
+bool Text::UsesGlyphAtlas() const {
+	if (!game.font.IsGlyphAtlasEnabled()) {
+		return false;
+	}
+	if (Has<PreFX>() && !Get<PreFX>().pre_fx_.empty()) {
+		return false;
+	}
+	return !Has<TextureCrop>() || Get<TextureCrop>() == TextureCrop{};
+}
+
+bool Text::IsOutdated() const {
+	const auto* layout{ TryGet<impl::TextLayout>() };
+	if (!UsesGlyphAtlas()) {
+		return layout != nullptr;
+	}
+	return layout == nullptr || layout->generation != game.font.GetGlyphAtlas()->GetGeneration();
+}
+
 void Text::RecreateTexture(const Camera& camera) {
 	TextContent content{ GetContent() };
 	TextColor color{ GetColor() };
@@ -310,6 +329,21 @@ void Text::RecreateTexture(
 	// before drawing.
 	Add<impl::CachedFontSize>(font_size);
 
+	if (UsesGlyphAtlas()) {
+		// Only glyphs which are not in the atlas yet are rasterized.
+		if (Has<impl::Texture>()) {
+			Remove<impl::Texture>();
+		}
+		game.font.GetGlyphAtlas()->Layout(
+			TryAdd<impl::TextLayout>(), content, color, font_size, font_key, properties, IsHD()
+		);
+		return;
+	}
+
+	if (Has<impl::TextLayout>()) {
+		Remove<impl::TextLayout>();
+	}
+
 	// TODO: Move texture location to TextureManager.
 	impl::Texture& texture{ TryAdd<impl::Texture>() };
 
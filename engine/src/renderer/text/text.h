@@ -226,6 +226,13 @@ private:
 		Origin offset_origin, const V2_float& offset_size
 	);
 
+	// @return True if the text is laid out from the glyph atlas instead of drawn from its own
+	// texture. Texts with pre fx or a texture crop always use their own texture.
+	[[nodiscard]] bool UsesGlyphAtlas() const;
+
+	// @return True if the texture or glyph layout of the text no longer matches the glyph atlas.
+	[[nodiscard]] bool IsOutdated() const;
+
 	// Using own properties.
 	void RecreateTexture(const Camera& camera);
 
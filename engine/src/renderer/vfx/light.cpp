@@ -1,5 +1,7 @@
 #include "renderer/vfx/light.h"
 
+#include <array>
+
 #include "core/app/game.h"
 #include "core/app/manager.h"
 #include "core/app/resolution.h"
@@ -63,6 +65,37 @@ void PointLight::SetUniform(Entity entity, const Shader& shader) {
 	shader.SetUniform("u_LightAttenuation", 1.0f, 0.0f, 0.1f);
 }
 
+impl::QuadInstance PointLight::GetInstance(Entity entity) {
+	PointLight light{ entity };
+
+	auto transform{ GetDrawTransform(entity) };
+
+	auto center{ transform.GetPosition() };
+
+	auto zoom{ Camera{ entity.GetCamera() }.GetZoom() };
+
+	PTGN_ASSERT(zoom.BothAboveZero());
+
+	// Same on screen radius as the full screen light pass, which does not scale with zoom.
+	V2_float radius{ 2.0f * light.GetRadius() * Abs(transform.GetAverageScale()) / zoom };
+
+	std::array<V2_float, 4> quad_points{ center - radius,
+										 V2_float{ center.x + radius.x, center.y - radius.y },
+										 center + radius,
+										 V2_float{ center.x - radius.x, center.y + radius.y } };
+
+	V4_float light_color{ light.GetColor().Normalized() };
+	light_color.w = 1.0f;
+
+	Color color{ light_color * GetTint(entity).Normalized() };
+
+	std::array<float, 4> data{ light.GetIntensity(), light.GetFalloff(), 0.0f, 0.0f };
+
+	return impl::QuadInstance::Get(
+		quad_points, color, GetDepth(entity), data, impl::GetDefaultTextureCoordinates()
+	);
+}
+
 PointLight CreatePointLight(
 	Manager& manager, const V2_float& position, float radius, const Color& color, float intensity,
 	float falloff
@@ -102,10 +135,22 @@ void PointLight::Draw(const Entity& entity) {
 
 	TextureFormat texture_format{ default_texture_format /*TextureFormat::HDR_RGBA*/ };
 
+	auto post_fx{ entity.GetOrDefault<PostFX>() };
+
+	// Ambient light covers the entire screen, so only lights without it are bounded by their
+	// radius.
+	bool batched{ game.renderer.IsLightBatchingEnabled() && post_fx.post_fx_.empty() &&
+				  PointLight{ entity }.GetAmbientIntensity() <= 0.0f };
+
+	impl::ShaderPass shader_pass{ "light", &PointLight::SetUniform };
+	if (batched) {
+		shader_pass = { "light_instanced", nullptr, &PointLight::GetInstance };
+	}
+
 	game.renderer.DrawShader(
-		{ "light", &PointLight::SetUniform }, entity, false, light_clear_color, V2_int{},
+		shader_pass, entity, false, light_clear_color, V2_int{},
 		intermediate_blend_mode, GetDepth(entity), blend_mode, entity.GetOrDefault<Camera>(),
-		texture_format, entity.GetOrDefault<PostFX>(), target_blend_mode
+		texture_format, post_fx, target_blend_mode
 	);
 }
 
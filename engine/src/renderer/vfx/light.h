@@ -5,6 +5,7 @@
 #include "math/vector2.h"
 #include "math/vector3.h"
 #include "renderer/api/color.h"
+#include "renderer/api/vertex.h"
 #include "serialization/json/serializable.h"
 
 namespace ptgn {
@@ -74,6 +75,9 @@ public:
 
 private:
 	static void SetUniform(Entity entity, const Shader& shader);
+
+	// @return Quad which covers the light radius, used when lights are batched.
+	[[nodiscard]] static impl::QuadInstance GetInstance(Entity entity);
 };
 
 PTGN_DRAWABLE_REGISTER(PointLight);
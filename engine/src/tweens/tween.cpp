@@ -12,6 +12,7 @@
 #include "core/app/manager.h"
 #include "core/ecs/entity.h"
 #include "core/scripting/script.h"
+#include "core/utils/frame_profiler.h"
 #include "core/utils/time.h"
 #include "debug/runtime/assert.h"
 #include "math/easing.h"
@@ -467,6 +468,8 @@ const impl::TweenPoint& Tween::GetLastTweenPoint() const {
 }
 
 void Tween::Update(Manager& manager, float dt) {
+	PTGN_FRAME_SCOPE("Tween::Update");
+
 	const auto invoke_tween_scripts = [&]() {
 		for (auto [entity, tween] : manager.EntitiesWith<impl::TweenInstance>()) {
 			for (auto& point : tween.points_) {
@@ -1,5 +1,6 @@
 #include "world/scene/scene.h"
 
+#include <cstddef>
 #include <vector>
 
 #include "core/app/game.h"
@@ -16,6 +17,7 @@
 #include "core/scripting/script.h"
 #include "core/scripting/script_interfaces.h"
 #include "core/utils/flags.h"
+#include "core/utils/frame_profiler.h"
 #include "debug/runtime/assert.h"
 #include "debug/runtime/debug_system.h"
 #include "ecs/ecs.h"
@@ -68,16 +70,18 @@ void Scene::AddToDisplayList(Entity entity) {
 	if (!IsVisible(entity) || !HasDraw(entity)) {
 		return;
 	}
-	auto& dl{ render_target_.GetDisplayList() };
-	dl.emplace_back(entity);
+	auto& dl{ impl::EntityAccess::Get<impl::DisplayList>(render_target_) };
+	dl.entities.emplace_back(entity);
+	dl.culler.Add(entity);
 }
 
 void Scene::RemoveFromDisplayList(Entity entity) {
 	if (!render_target_ || !render_target_.Has<impl::DisplayList>()) {
 		return;
 	}
-	auto& dl{ render_target_.GetDisplayList() };
-	std::erase(dl, entity);
+	auto& dl{ impl::EntityAccess::Get<impl::DisplayList>(render_target_) };
+	std::erase(dl.entities, entity);
+	dl.culler.Remove(entity);
 }
 
 Entity Scene::CreateEntity() {
@@ -171,6 +175,26 @@ impl::SceneKey Scene::GetKey() const {
 	return key_;
 }
 
+const impl::BroadphaseStats& Scene::GetBroadphaseStats() const {
+	return collision_.GetBroadphaseStats();
+}
+
+void Scene::SetBroadphase(impl::BroadphaseType type, float cell_size) {
+	collision_.SetBroadphase(type, cell_size);
+}
+
+impl::BroadphaseType Scene::GetBroadphaseType() const {
+	return collision_.GetBroadphaseType();
+}
+
+void Scene::SetCollisionThreadCount(std::size_t thread_count) {
+	collision_.SetNarrowphaseThreadCount(thread_count);
+}
+
+std::size_t Scene::GetCollisionThreadCount() const {
+	return collision_.GetNarrowphaseThreadCount();
+}
+
 void Scene::Init() {
 	render_target_.Get<GameObject<Camera>>().Reset();
 	fixed_camera.Reset();
@@ -219,21 +243,35 @@ void Scene::InternalDraw() {
 	game.renderer.render_data_.Draw(*this);
 }
 
+void Scene::UpdateWorldTransforms() {
+	transform_entities_.clear();
+	for (auto [entity, transform] : InternalEntitiesWith<Transform>()) {
+		if (!entity.Has<impl::CameraInstance>()) {
+			transform_entities_.emplace_back(entity);
+		}
+	}
+	impl::UpdateWorldTransformCache(*this, transform_entities_);
+}
+
 void Scene::InternalUpdate() {
+	PTGN_FRAME_SCOPE("Scene::InternalUpdate");
+
 	game.renderer.render_data_.ClearRenderTargets(*this);
 	game.renderer.render_data_.SetDrawingTo(render_target_);
 
 	Refresh();
 
-	game.input.InvokeInputEvents(*this);
+	{
+		PTGN_FRAME_SCOPE("Scene::Input");
 
-	input.Update(*this);
+		game.input.InvokeInputEvents(*this);
+
+		input.Update(*this);
+	}
 
 	const auto invoke_scripts = [&](Manager& manager) {
-		// TODO: Consider moving this into the Scripts class.
-		for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-			scripts.InvokeActions();
-		}
+		PTGN_FRAME_SCOPE("Scene::Scripts");
+		impl::InvokeScriptActions(manager);
 		manager.Refresh();
 	};
 
@@ -242,9 +280,7 @@ void Scene::InternalUpdate() {
 	float dt{ game.dt() };
 
 	const auto update_scripts = [&](Manager& manager) {
-		for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-			scripts.AddAction(&impl::IScript::OnUpdate);
-		}
+		impl::AddScriptActions(manager, &impl::IScript::OnUpdate);
 
 		invoke_scripts(manager);
 	};
@@ -265,18 +301,42 @@ void Scene::InternalUpdate() {
 
 	Lifetime::Update(*this);
 
-	physics.PreCollisionUpdate(*this);
+	bool fixed_timestep{ game.IsFixedTimestep() };
 
-	collision_.Update(*this);
+	std::size_t steps{ game.GetFixedSteps() };
 
-	physics.PostCollisionUpdate(*this);
+	for (std::size_t step{ 0 }; step < steps; ++step) {
+		if (fixed_timestep) {
+			physics.RecordPreviousTransforms(*this);
+		}
 
-	invoke_scripts(*this);
+		physics.PreCollisionUpdate(*this);
+
+		collision_.Update(*this);
+
+		physics.PostCollisionUpdate(*this);
+
+		collision_.UpdateSleep(*this, physics, physics.dt());
+
+		physics.ClearPhysicsDirtyFlags(*this);
+
+		invoke_scripts(*this);
+	}
+
+	if (fixed_timestep) {
+		physics.InterpolateTransforms(*this, steps, game.GetInterpolationAlpha());
+	} else {
+		physics.RemoveInterpolation(*this);
+	}
 
 	// TODO: Update dirty vertex caches.
 
+	UpdateWorldTransforms();
+
 	InternalDraw();
 
+	impl::DisableWorldTransformCache(*this);
+
 	for (auto [entity, transform] : InternalEntitiesWith<Transform>()) {
 		transform.ClearDirtyFlags();
 	}
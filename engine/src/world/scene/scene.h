@@ -85,6 +85,24 @@ public:
 
 	[[nodiscard]] impl::SceneKey GetKey() const;
 
+	// @return Number of broadphase rebuilds and refits performed during the latest collision
+	// update of the scene.
+	[[nodiscard]] const impl::BroadphaseStats& GetBroadphaseStats() const;
+
+	// Sets the data structure used by the scene to find potential collisions. Scenes with large
+	// numbers of similarly sized colliders usually benefit from SpatialHash or SortAndSweep.
+	// Default: impl::BroadphaseType::KDTree.
+	// @param cell_size Side length of the grid cells of impl::BroadphaseType::SpatialHash, which
+	// should be close to the typical collider size. Ignored by the other broadphase types.
+	void SetBroadphase(impl::BroadphaseType type, float cell_size = 64.0f);
+	[[nodiscard]] impl::BroadphaseType GetBroadphaseType() const;
+
+	// Sets the number of threads used to test collision candidates of the scene. Results do not
+	// depend on the thread count. 0 uses the hardware concurrency.
+	// Default: 1.
+	void SetCollisionThreadCount(std::size_t thread_count);
+	[[nodiscard]] std::size_t GetCollisionThreadCount() const;
+
 	// @return Size of scene render target divided by the viewport size of the provided camera.
 	[[nodiscard]] V2_float GetRenderTargetScaleRelativeTo(const Camera& relative_to_camera) const;
 
@@ -116,6 +134,11 @@ private:
 	void InternalDraw();
 	void InternalExit();
 
+	// Caches the world transforms of every entity in the scene until
+	// impl::DisableWorldTransformCache() is called. Only used while drawing, after input and
+	// scripts have been dispatched, since scripts may modify transforms.
+	void UpdateWorldTransforms();
+
 	void AddToDisplayList(Entity entity);
 
 	void RemoveFromDisplayList(Entity entity);
@@ -140,6 +163,10 @@ private:
 
 	impl::CollisionHandler collision_;
 
+	// Entities with a transform during the latest UpdateWorldTransforms(). Kept to reuse its
+	// capacity.
+	std::vector<Entity> transform_entities_;
+
 	RenderTarget render_target_;
 	bool collider_visibility_{ false };
 	Color collider_color_{ color::Blue };
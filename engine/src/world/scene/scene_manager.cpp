@@ -13,6 +13,7 @@
 #include "core/scripting/script.h"
 #include "core/scripting/script_interfaces.h"
 #include "core/utils/file.h"
+#include "core/utils/frame_profiler.h"
 #include "core/utils/span.h"
 #include "debug/runtime/assert.h"
 #include "renderer/render_data.h"
@@ -129,7 +130,10 @@ void SceneManager::Update(Game& g) {
 
 	auto& render_data{ g.renderer.render_data_ };
 
-	g.input.Update();
+	{
+		PTGN_FRAME_SCOPE("InputHandler::Update");
+		g.input.Update();
+	}
 
 	// TODO: Figure out a better way to do non-scene events / scripts.
 
@@ -139,19 +143,13 @@ void SceneManager::Update(Game& g) {
 		manager.Refresh();
 
 		if (render_data.game_size_changed_) {
-			for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-				scripts.AddAction(&GameSizeScript::OnGameSizeChanged);
-			}
+			impl::AddScriptActions(manager, &GameSizeScript::OnGameSizeChanged);
 		}
 		if (render_data.display_size_changed_) {
-			for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-				scripts.AddAction(&DisplaySizeScript::OnDisplaySizeChanged);
-			}
+			impl::AddScriptActions(manager, &DisplaySizeScript::OnDisplaySizeChanged);
 		}
 		if (invoke_actions) {
-			for (auto [e, scripts] : manager.EntitiesWith<Scripts>()) {
-				scripts.InvokeActions();
-			}
+			impl::InvokeScriptActions(manager);
 		}
 
 		manager.Refresh();
@@ -19,6 +19,7 @@
 #include "nlohmann/json.hpp"
 #include "renderer/api/color.h"
 #include "renderer/api/origin.h"
+#include "renderer/static_batch.h"
 #include "serialization/json/fwd.h"
 #include "world/scene/camera.h"
 
@@ -30,11 +31,17 @@ Chunk::Chunk(const json& j, Manager& manager) {
 	Deserialize(j, manager);
 }
 
-Chunk::Chunk(Chunk&& other) noexcept : entities{ std::exchange(other.entities, {}) } {}
+Chunk::Chunk(Chunk&& other) noexcept :
+	entities{ std::exchange(other.entities, {}) },
+	static_batches_{ std::exchange(other.static_batches_, {}) },
+	has_changed_{ std::exchange(other.has_changed_, false) } {}
 
 Chunk& Chunk::operator=(Chunk&& other) noexcept {
 	if (this != &other) {
-		entities = std::exchange(other.entities, {});
+		Destroy();
+		entities		= std::exchange(other.entities, {});
+		static_batches_ = std::exchange(other.static_batches_, {});
+		has_changed_	= std::exchange(other.has_changed_, false);
 	}
 	return *this;
 }
@@ -71,9 +78,18 @@ void Chunk::Deserialize(const json& j, Manager& manager) {
 }
 
 Chunk::~Chunk() {
+	Destroy();
+}
+
+void Chunk::Destroy() {
 	for (auto& entity : entities) {
 		entity.Destroy();
 	}
+	entities.clear();
+	for (auto& batch : static_batches_) {
+		batch.Destroy();
+	}
+	static_batches_.clear();
 }
 
 Entity NoiseLayer::GetEntity(const V2_int& tile_coordinate, const V2_int& tile_size) const {
@@ -91,14 +107,16 @@ ChunkManager::ChunkManager(ChunkManager&& other) noexcept :
 	chunks{ std::exchange(other.chunks, {}) },
 	tile_size{ std::exchange(other.tile_size, {}) },
 	chunk_size{ std::exchange(other.chunk_size, {}) },
+	static_batching{ std::exchange(other.static_batching, false) },
 	noise_layers_{ std::exchange(other.noise_layers_, {}) } {}
 
 ChunkManager& ChunkManager::operator=(ChunkManager&& other) noexcept {
 	if (this != &other) {
-		chunks		  = std::exchange(other.chunks, {});
-		tile_size	  = std::exchange(other.tile_size, {});
-		chunk_size	  = std::exchange(other.chunk_size, {});
-		noise_layers_ = std::exchange(other.noise_layers_, {});
+		chunks			= std::exchange(other.chunks, {});
+		tile_size		= std::exchange(other.tile_size, {});
+		chunk_size		= std::exchange(other.chunk_size, {});
+		static_batching = std::exchange(other.static_batching, false);
+		noise_layers_	= std::exchange(other.noise_layers_, {});
 	}
 	return *this;
 }
@@ -159,15 +177,20 @@ void ChunkManager::Update(Manager& manager, const Camera& camera) {
 				continue;
 			}
 
+			Chunk* chunk{ nullptr };
+
 			if (auto cache_it{ chunk_cache.find(coordinate) }; cache_it != chunk_cache.end()) {
-				chunks.try_emplace(coordinate, cache_it->second, manager);
-				continue;
+				chunk = &chunks.try_emplace(coordinate, cache_it->second, manager).first->second;
+			} else {
+				// PTGN_LOG("Loading chunk for the first time: ", coordinate);
+				// Newly visible chunk.
+				auto entities{ GenerateEntities(coordinate) };
+				chunk = &chunks.try_emplace(coordinate, entities).first->second;
 			}
 
-			// PTGN_LOG("Loading chunk for the first time: ", coordinate);
-			// Newly visible chunk.
-			auto entities{ GenerateEntities(coordinate) };
-			[[maybe_unused]] auto [new_it, _] = chunks.try_emplace(coordinate, entities);
+			if (static_batching) {
+				chunk->static_batches_ = CreateStaticBatches(manager, chunk->entities);
+			}
 		}
 	}
 
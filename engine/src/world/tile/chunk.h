@@ -7,6 +7,7 @@
 #include "core/ecs/entity.h"
 #include "math/noise.h"
 #include "math/vector2.h"
+#include "renderer/static_batch.h"
 #include "serialization/json/json.h"
 
 namespace ptgn {
@@ -43,6 +44,13 @@ public:
 private:
 	friend class ChunkManager;
 
+	// Destroys the chunk entities and static batches.
+	void Destroy();
+
+	// Static batches of the chunk entities, one per depth, if the chunk manager uses static
+	// batching.
+	std::vector<StaticBatch> static_batches_;
+
 	bool has_changed_{ false };
 };
 
@@ -81,6 +89,11 @@ public:
 
 	std::unordered_map<V2_int, json> chunk_cache;
 
+	// If true, the sprites of each loaded chunk are baked into one static batch per depth, so
+	// that each layer of a chunk is drawn with a single draw call. Only affects chunks loaded
+	// afterwards.
+	bool static_batching{ false };
+
 private:
 	V2_int previous_min_;
 	V2_int previous_max_;
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/app/manager.h"
+#include "core/ecs/entity.h"
+#include "debug/core/log.h"
+#include "debug/runtime/assert.h"
+#include "math/rng.h"
+#include "math/vector2.h"
+#include "physics/bounding_aabb.h"
+#include "physics/broadphase.h"
+#include "physics/dynamic_aabb_tree.h"
+#include "physics/sort_and_sweep.h"
+#include "physics/spatial_hash_grid.h"
+
+using BroadphaseTestPair = std::pair<ptgn::Entity, ptgn::Entity>;
+
+inline ptgn::BoundingAABB CreateBroadphaseTestAABB(
+	ptgn::RNG<float>& position, ptgn::RNG<float>& size
+) {
+	ptgn::V2_float min{ position(), position() };
+	return { min, min + ptgn::V2_float{ size(), size() } };
+}
+
+inline BroadphaseTestPair GetSortedPair(const ptgn::Entity& a, const ptgn::Entity& b) {
+	return b < a ? BroadphaseTestPair{ b, a } : BroadphaseTestPair{ a, b };
+}
+
+// Query results are only compared after sorting, since each broadphase returns entities in its
+// own order. Duplicates are kept so that they fail the comparison.
+
+template <typename T>
+std::vector<ptgn::Entity> BruteForceQuery(
+	const std::vector<ptgn::impl::KDObject>& objects, const T& region
+) {
+	std::vector<ptgn::Entity> entities;
+	for (const auto& object : objects) {
+		if (object.aabb.Overlaps(region)) {
+			entities.emplace_back(object.entity);
+		}
+	}
+	std::sort(entities.begin(), entities.end());
+	return entities;
+}
+
+inline std::vector<BroadphaseTestPair> BruteForcePairs(
+	const std::vector<ptgn::impl::KDObject>& objects
+) {
+	std::vector<BroadphaseTestPair> pairs;
+	for (std::size_t i{ 0 }; i < objects.size(); ++i) {
+		for (std::size_t j{ i + 1 }; j < objects.size(); ++j) {
+			if (objects[i].aabb.Overlaps(objects[j].aabb)) {
+				pairs.emplace_back(GetSortedPair(objects[i].entity, objects[j].entity));
+			}
+		}
+	}
+	std::sort(pairs.begin(), pairs.end());
+	return pairs;
+}
+
+inline void CheckBroadphase(
+	const ptgn::impl::Broadphase& broadphase, const std::vector<ptgn::impl::KDObject>& objects,
+	const std::vector<ptgn::BoundingAABB>& regions, const std::vector<ptgn::V2_float>& points
+) {
+	for (const auto& region : regions) {
+		auto result{ broadphase.Query(region) };
+		std::sort(result.begin(), result.end());
+		PTGN_ASSERT(result == BruteForceQuery(objects, region));
+	}
+
+	for (const auto& point : points) {
+		auto result{ broadphase.Query(point) };
+		std::sort(result.begin(), result.end());
+		PTGN_ASSERT(result == BruteForceQuery(objects, point));
+	}
+
+	std::vector<ptgn::impl::BroadphasePair> pairs;
+	broadphase.FindPairs(pairs);
+
+	std::vector<BroadphaseTestPair> result;
+	result.reserve(pairs.size());
+	for (const auto& pair : pairs) {
+		result.emplace_back(GetSortedPair(pair.first, pair.second));
+	}
+	std::sort(result.begin(), result.end());
+	PTGN_ASSERT(result == BruteForcePairs(objects));
+}
+
+void TestBroadphase() {
+	using namespace ptgn;
+	using namespace ptgn::impl;
+
+	PTGN_INFO("Starting broadphase tests...");
+
+	// Fixed seeds so that failures are reproducible.
+	RNG<float> position{ 1, 0.0f, 1000.0f };
+	RNG<float> size{ 2, 1.0f, 80.0f };
+	RNG<float> region_size{ 3, 0.0f, 200.0f };
+
+	Manager manager;
+
+	std::vector<KDObject> initial;
+	for (int i{ 0 }; i < 300; ++i) {
+		initial.emplace_back(
+			KDObject{ manager.CreateEntity(), CreateBroadphaseTestAABB(position, size) }
+		);
+	}
+
+	std::vector<Entity> inserted;
+	for (int i{ 0 }; i < 50; ++i) {
+		inserted.emplace_back(manager.CreateEntity());
+	}
+
+	manager.Refresh();
+
+	std::vector<BoundingAABB> regions;
+	for (int i{ 0 }; i < 50; ++i) {
+		regions.emplace_back(CreateBroadphaseTestAABB(position, region_size));
+	}
+	// Entire world and a region outside of it.
+	regions.emplace_back(BoundingAABB{ { -1.0f, -1.0f }, { 2000.0f, 2000.0f } });
+	regions.emplace_back(BoundingAABB{ { -500.0f, -500.0f }, { -400.0f, -400.0f } });
+
+	std::vector<V2_float> points;
+	for (int i{ 0 }; i < 50; ++i) {
+		points.emplace_back(position(), position());
+	}
+	// Points on the edge of a bounding box overlap it.
+	points.emplace_back(initial.front().aabb.min);
+	points.emplace_back(initial.back().aabb.max);
+
+	std::vector<std::unique_ptr<Broadphase>> broadphases;
+	// Small leaves so that the tree is split several levels deep.
+	broadphases.emplace_back(std::make_unique<KDTree>(4));
+	broadphases.emplace_back(std::make_unique<DynamicAABBTree>());
+	broadphases.emplace_back(std::make_unique<SpatialHashGrid>(64.0f));
+	broadphases.emplace_back(std::make_unique<SortAndSweep>());
+
+	for (auto& broadphase : broadphases) {
+		auto objects{ initial };
+
+		// Build.
+
+		broadphase->Build(objects);
+		CheckBroadphase(*broadphase, objects, regions, points);
+
+		// Incremental updates.
+
+		// Large movements.
+		for (std::size_t i{ 0 }; i < objects.size(); i += 3) {
+			objects[i].aabb = CreateBroadphaseTestAABB(position, size);
+			broadphase->UpdateBoundingAABB(objects[i].entity, objects[i].aabb);
+		}
+
+		// Small movements, which may stay within the existing bounds of a node.
+		for (std::size_t i{ 1 }; i < objects.size(); i += 3) {
+			V2_float offset{ 1.0f, -1.0f };
+			objects[i].aabb = { objects[i].aabb.min + offset, objects[i].aabb.max + offset };
+			broadphase->UpdateBoundingAABB(objects[i].entity, objects[i].aabb);
+		}
+
+		for (const auto& entity : inserted) {
+			KDObject object{ entity, CreateBroadphaseTestAABB(position, size) };
+			broadphase->Insert(object.entity, object.aabb);
+			objects.emplace_back(object);
+		}
+
+		// Removals include objects which were moved or inserted during the same frame.
+		std::vector<KDObject> kept;
+		for (std::size_t i{ 0 }; i < objects.size(); ++i) {
+			if (i % 5 == 2) {
+				broadphase->Remove(objects[i].entity);
+			} else {
+				kept.emplace_back(objects[i]);
+			}
+		}
+		objects = std::move(kept);
+
+		broadphase->EndFrameUpdate();
+		CheckBroadphase(*broadphase, objects, regions, points);
+
+		// A few movements, below the rebuild threshold of the KD-tree.
+		for (std::size_t i{ 0 }; i < 5; ++i) {
+			objects[i].aabb = CreateBroadphaseTestAABB(position, size);
+			broadphase->UpdateBoundingAABB(objects[i].entity, objects[i].aabb);
+		}
+
+		broadphase->EndFrameUpdate();
+		CheckBroadphase(*broadphase, objects, regions, points);
+
+		// Bulk update.
+
+		// Objects left out of the update are removed.
+		objects.resize(objects.size() - 20);
+		for (std::size_t i{ 0 }; i < objects.size(); i += 2) {
+			objects[i].aabb = CreateBroadphaseTestAABB(position, size);
+		}
+
+		broadphase->Update(objects);
+		CheckBroadphase(*broadphase, objects, regions, points);
+
+		// Updating with unchanged objects changes nothing.
+		broadphase->Update(objects);
+		CheckBroadphase(*broadphase, objects, regions, points);
+
+		// Rebuilding without objects empties the broadphase.
+		broadphase->Build({});
+		CheckBroadphase(*broadphase, {}, regions, points);
+	}
+
+	PTGN_INFO("All broadphase tests passed!");
+}
\ No newline at end of file
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "debug/core/log.h"
+#include "debug/runtime/assert.h"
+#include "renderer/text/font.h"
+
+void TestSizedFontCache() {
+	using namespace ptgn;
+	using namespace ptgn::impl;
+
+	PTGN_INFO("Starting sized font cache tests...");
+
+	// The cache only stores handles, so placeholder handles which are never opened or closed by
+	// TTF suffice.
+	std::array<int, 8> storage{};
+	auto make_font = [&](std::size_t index) {
+		return TemporaryFont{ reinterpret_cast<TemporaryFont::element_type*>(&storage[index]),
+							  [](TemporaryFont::element_type*) {} };
+	};
+
+	SizedFontCache cache;
+	cache.SetLimits(3, 1000);
+	PTGN_ASSERT(cache.GetMaxFonts() == 3);
+	PTGN_ASSERT(cache.GetMaxBytes() == 1000);
+
+	SizedFontCache::Key a{ 1, 10 };
+	SizedFontCache::Key b{ 1, 12 };
+	SizedFontCache::Key c{ 1, 14 };
+	SizedFontCache::Key d{ 1, 16 };
+
+	// Misses.
+
+	PTGN_ASSERT(cache.Find(a) == nullptr);
+	PTGN_ASSERT(cache.GetStats().misses == 1);
+
+	cache.Insert(a, make_font(0), 100);
+	cache.Insert(b, make_font(1), 100);
+	cache.Insert(c, make_font(2), 100);
+
+	PTGN_ASSERT(cache.GetStats().fonts == 3);
+	PTGN_ASSERT(cache.GetStats().bytes == 300);
+	PTGN_ASSERT(cache.GetStats().evictions == 0);
+
+	// Hits.
+
+	auto font_a{ cache.Find(a) };
+	PTGN_ASSERT(font_a != nullptr);
+	PTGN_ASSERT(font_a.get() == reinterpret_cast<TemporaryFont::element_type*>(&storage[0]));
+	PTGN_ASSERT(cache.GetStats().hits == 1);
+
+	// LRU eviction by count.
+
+	// Finding a made it the most recently used, so b is now the least recently used.
+	cache.Insert(d, make_font(3), 100);
+	PTGN_ASSERT(cache.Contains(a));
+	PTGN_ASSERT(!cache.Contains(b));
+	PTGN_ASSERT(cache.Contains(c));
+	PTGN_ASSERT(cache.Contains(d));
+	PTGN_ASSERT(cache.GetStats().fonts == 3);
+	PTGN_ASSERT(cache.GetStats().evictions == 1);
+
+	// Contains does not count as a use, so c remains the least recently used.
+	PTGN_ASSERT(cache.Contains(c));
+	PTGN_ASSERT(cache.Find(b) == nullptr);
+	PTGN_ASSERT(cache.GetStats().misses == 2);
+
+	// LRU eviction by bytes.
+
+	cache.SetLimits(3, 250);
+	PTGN_ASSERT(!cache.Contains(c));
+	PTGN_ASSERT(cache.Contains(a));
+	PTGN_ASSERT(cache.Contains(d));
+	PTGN_ASSERT(cache.GetStats().bytes == 200);
+	PTGN_ASSERT(cache.GetStats().evictions == 2);
+
+	// Inserting an existing key replaces its handle and size without evicting.
+	cache.Insert(a, make_font(4), 50);
+	PTGN_ASSERT(cache.GetStats().fonts == 2);
+	PTGN_ASSERT(cache.GetStats().bytes == 150);
+	PTGN_ASSERT(cache.GetStats().evictions == 2);
+	PTGN_ASSERT(
+		cache.Find(a).get() == reinterpret_cast<TemporaryFont::element_type*>(&storage[4])
+	);
+
+	// Evicted handles stay alive while used elsewhere.
+
+	auto font_d{ cache.Find(d) };
+	cache.SetLimits(0, 1000);
+	PTGN_ASSERT(cache.GetStats().fonts == 0);
+	PTGN_ASSERT(cache.GetStats().bytes == 0);
+	PTGN_ASSERT(font_d != nullptr);
+	PTGN_ASSERT(font_d.use_count() == 1);
+	PTGN_ASSERT(font_a.use_count() == 1);
+
+	// Keys.
+
+	cache.SetLimits(8, 1000);
+
+	// Handles opened with a different style or outline are cached separately.
+	SizedFontCache::Key bold{ 1, 10, 0, FontStyle::Bold };
+	SizedFontCache::Key outlined{ 1, 10, 0, FontStyle::Normal, 2 };
+	cache.Insert(a, make_font(0), 100);
+	cache.Insert(bold, make_font(1), 100);
+	cache.Insert(outlined, make_font(2), 100);
+	PTGN_ASSERT(cache.GetStats().fonts == 3);
+	PTGN_ASSERT(cache.Find(bold).get() != cache.Find(a).get());
+
+	// Removal.
+
+	SizedFontCache::Key other{ 2, 10 };
+	cache.Insert(other, make_font(3), 100);
+
+	// Removing a font removes every size of it.
+	cache.Remove(1);
+	PTGN_ASSERT(!cache.Contains(a));
+	PTGN_ASSERT(!cache.Contains(bold));
+	PTGN_ASSERT(!cache.Contains(outlined));
+	PTGN_ASSERT(cache.Contains(other));
+	PTGN_ASSERT(cache.GetStats().fonts == 1);
+	PTGN_ASSERT(cache.GetStats().bytes == 100);
+
+	cache.ResetStats();
+	PTGN_ASSERT(cache.GetStats().hits == 0);
+	PTGN_ASSERT(cache.GetStats().misses == 0);
+	PTGN_ASSERT(cache.GetStats().evictions == 0);
+	PTGN_ASSERT(cache.GetStats().fonts == 1);
+
+	cache.Clear();
+	PTGN_ASSERT(!cache.Contains(other));
+	PTGN_ASSERT(cache.GetStats().fonts == 0);
+	PTGN_ASSERT(cache.GetStats().bytes == 0);
+
+	// A single font larger than the byte limit is not kept.
+	cache.Insert(b, make_font(1), 2000);
+	PTGN_ASSERT(!cache.Contains(b));
+	PTGN_ASSERT(cache.GetStats().bytes == 0);
+
+	PTGN_INFO("All sized font cache tests passed!");
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "debug/core/log.h"
+#include "debug/runtime/assert.h"
+#include "math/vector2.h"
+#include "renderer/materials/texture.h"
+#include "renderer/materials/texture_atlas.h"
+
+// Atlas pages are textures, so these tests require an initialized renderer.
+
+inline ptgn::impl::Surface CreateAtlasTestSurface(
+	const ptgn::V2_int& size, ptgn::TextureFormat format = ptgn::TextureFormat::RGBA8888
+) {
+	ptgn::impl::Surface surface;
+	surface.format			= format;
+	surface.bytes_per_pixel = 4;
+	surface.data.resize(
+		static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) *
+			surface.bytes_per_pixel,
+		255
+	);
+	surface.size = size;
+	return surface;
+}
+
+// @return True if the texture coordinates of both regions overlap on the same page.
+inline bool AtlasRegionsOverlap(
+	const ptgn::impl::AtlasRegion& a, const ptgn::impl::AtlasRegion& b
+) {
+	return a.page == b.page && a.min.x < b.max.x && b.min.x < a.max.x && a.min.y < b.max.y &&
+		   b.min.y < a.max.y;
+}
+
+void TestTextureAtlas() {
+	using namespace ptgn;
+	using namespace ptgn::impl;
+
+	PTGN_INFO("Starting texture atlas tests...");
+
+	// Allocation.
+
+	TextureAtlas atlas{ { 64, 64 }, { 32, 32 }, 0 };
+
+	V2_int size{ 16, 16 };
+	auto surface{ CreateAtlasTestSurface(size) };
+
+	// Sixteen 16x16 surfaces exactly fill one 64x64 page.
+	std::vector<AtlasRegion> regions;
+	for (int i{ 0 }; i < 16; ++i) {
+		auto region{ atlas.Pack(surface) };
+		PTGN_ASSERT(region.has_value());
+		regions.emplace_back(*region);
+	}
+
+	for (std::size_t i{ 0 }; i < regions.size(); ++i) {
+		const auto& region{ regions[i] };
+		PTGN_ASSERT(region.page != 0);
+		PTGN_ASSERT(region.page == regions.front().page);
+		PTGN_ASSERT(region.min.x >= 0.0f && region.min.y >= 0.0f);
+		PTGN_ASSERT(region.max.x <= 1.0f && region.max.y <= 1.0f);
+		PTGN_ASSERT((region.max - region.min == V2_float{ 0.25f, 0.25f }));
+		for (std::size_t j{ i + 1 }; j < regions.size(); ++j) {
+			PTGN_ASSERT(!AtlasRegionsOverlap(region, regions[j]));
+		}
+	}
+
+	// Bottom left placement fills the lowest row first.
+	PTGN_ASSERT((regions[0].min == V2_float{ 0.0f, 0.0f }));
+	PTGN_ASSERT((regions[1].min == V2_float{ 0.25f, 0.0f }));
+
+	auto stats{ atlas.GetStats() };
+	PTGN_ASSERT(stats.pages == 1);
+	PTGN_ASSERT(stats.textures == 0);
+	PTGN_ASSERT(stats.used_area == 16 * 16 * 16);
+	PTGN_ASSERT(stats.total_area == 64 * 64);
+	PTGN_ASSERT(stats.GetOccupancy() == 1.0f);
+
+	// Full atlas fallback.
+
+	auto overflow{ atlas.Pack(surface) };
+	PTGN_ASSERT(overflow.has_value());
+	PTGN_ASSERT(overflow->page != regions.front().page);
+	PTGN_ASSERT((overflow->min == V2_float{ 0.0f, 0.0f }));
+	PTGN_ASSERT(atlas.GetStats().pages == 2);
+
+	// Surfaces which are too large or not of the page format are rejected without a new page.
+	PTGN_ASSERT(!atlas.Pack(CreateAtlasTestSurface({ 33, 16 })).has_value());
+	PTGN_ASSERT(!atlas.Pack(CreateAtlasTestSurface({ 16, 33 })).has_value());
+	PTGN_ASSERT(!atlas.Pack(CreateAtlasTestSurface(size, TextureFormat::RGB888)).has_value());
+	PTGN_ASSERT(atlas.GetStats().pages == 2);
+
+	// Freeing.
+
+	// Space of a page is not reused while any of its textures remain packed.
+	atlas.Free(regions.back(), size);
+	regions.pop_back();
+	auto partial{ atlas.Pack(surface) };
+	PTGN_ASSERT(partial.has_value());
+	PTGN_ASSERT(partial->page == overflow->page);
+	atlas.Free(*partial, size);
+	atlas.Free(*overflow, size);
+
+	for (const auto& region : regions) {
+		atlas.Free(region, size);
+	}
+
+	stats = atlas.GetStats();
+	PTGN_ASSERT(stats.pages == 2);
+	PTGN_ASSERT(stats.used_area == 0);
+
+	// Emptied pages are reset, so the first page is reused from its origin.
+	auto reused{ atlas.Pack(surface) };
+	PTGN_ASSERT(reused.has_value());
+	PTGN_ASSERT(reused->page == regions.front().page);
+	PTGN_ASSERT((reused->min == V2_float{ 0.0f, 0.0f }));
+	atlas.Free(*reused, size);
+
+	// Source textures.
+
+	atlas.Clear();
+	PTGN_ASSERT(atlas.GetStats().pages == 0);
+
+	TextureId source{ 1 };
+	auto added{ atlas.Add(source, surface) };
+	PTGN_ASSERT(added.has_value());
+	PTGN_ASSERT(atlas.Find(source) != nullptr);
+	PTGN_ASSERT(atlas.Find(source)->min == added->min);
+	PTGN_ASSERT(atlas.Find(2) == nullptr);
+
+	// Adding the same source again replaces its previous region.
+	PTGN_ASSERT(atlas.Add(source, surface).has_value());
+	stats = atlas.GetStats();
+	PTGN_ASSERT(stats.textures == 1);
+	PTGN_ASSERT(stats.used_area == 16 * 16);
+
+	atlas.Remove(source);
+	PTGN_ASSERT(atlas.Find(source) == nullptr);
+	stats = atlas.GetStats();
+	PTGN_ASSERT(stats.textures == 0);
+	PTGN_ASSERT(stats.used_area == 0);
+
+	// Removing an unknown source does nothing.
+	atlas.Remove(source);
+
+	// Padding.
+
+	TextureAtlas padded{ { 64, 64 }, { 32, 32 }, 2 };
+
+	auto first{ padded.Pack(surface) };
+	auto second{ padded.Pack(surface) };
+	PTGN_ASSERT(first.has_value() && second.has_value());
+	PTGN_ASSERT((first->min == V2_float{ 0.0f, 0.0f }));
+	PTGN_ASSERT((second->min == V2_float{ 18.0f / 64.0f, 0.0f }));
+
+	PTGN_INFO("All texture atlas tests passed!");
+}
\ No newline at end of file